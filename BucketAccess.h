@@ -0,0 +1,56 @@
+#ifndef BUCKETACCESS_H
+#define BUCKETACCESS_H
+
+/*
+ * Greg Rosen
+ * Project 4: HashTable
+ * Declaration and implementation of bucket array access for the hash tables
+ */
+
+#include <cstddef>
+
+/**
+ * @brief Whether bucket array accesses are bounds checked, selected by defining HASHTABLE_HARDENED.
+ *
+ * When true, slotAt uses at(), so an index outside the array throws std::out_of_range.
+ * When false, slotAt uses operator[] and compiles to a plain load, which lets probe loops inline and vectorize.
+ * Probe indices are always reduced to the capacity, so the checks only guard against bugs in the tables themselves.
+ * The macro must be defined (or not) consistently across the whole program.
+ */
+#if defined(HASHTABLE_HARDENED)
+inline constexpr bool HASHTABLE_CHECKED = true;
+#else
+inline constexpr bool HASHTABLE_CHECKED = false;
+#endif
+
+/**
+ * @brief Marks a small function that should be inlined into probe loops even across translation units.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define HASHTABLE_INLINE [[gnu::always_inline]] inline
+#elif defined(_MSC_VER)
+#define HASHTABLE_INLINE __forceinline
+#else
+#define HASHTABLE_INLINE inline
+#endif
+
+/**
+ * @brief Element of a bucket or control byte array.
+ *
+ * Bounds checked only when HASHTABLE_CHECKED is true.
+ *
+ * @param array array indexed
+ * @param index index of element
+ * @return reference to element.
+ */
+template<typename Array>
+HASHTABLE_INLINE decltype(auto) slotAt(Array& array, const size_t index) {
+    if constexpr (HASHTABLE_CHECKED) {
+        return array.at(index);
+    }
+    else {
+        return array[index];
+    }
+}
+
+#endif // BUCKETACCESS_H
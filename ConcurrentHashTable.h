@@ -0,0 +1,399 @@
+#ifndef CONCURRENTHASHTABLE_H
+#define CONCURRENTHASHTABLE_H
+
+/*
+ * Greg Rosen
+ * Project 4: HashTable
+ * Declaration and implementation of ConcurrentHashTable_t class template
+ */
+
+#include "HashTableImpl.h"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @class ConcurrentHashTable_t
+ * @brief Thread-safe HashTable for <K, V> key-value pairs, using lock striping.
+ *
+ * The table is split into a power-of-two number of shards, each a HashTable_t guarded by its own std::shared_mutex.
+ * Keys are routed to shards by their hash, so operations on different shards never contend.
+ * Every shard shares one hash function, so a key is hashed once, and the shard's table is given that hash.
+ * Lookups (get, contains) on the same shard share its lock. Inserts and removes lock only their shard,
+ * which also grows, shrinks, and compacts independently of the others.
+ * Shards always rehash at once (no incremental mode), so lookups never modify a shard.
+ *
+ * operator[] is not provided, since a reference into a bucket would outlive the lock protecting it;
+ * insert_or_assign and update modify values in place under the shard lock instead.
+ * Aggregate queries (size, capacity, alpha, stats, keys, for_each) lock one shard at a time,
+ * so they are exact when the table is quiescent and approximate under concurrent modification.
+ *
+ * @author Greg Rosen
+ * @date November 2, 2025
+ */
+template<typename K, typename V, typename Hash = DefaultHash<K>, typename Eq = DefaultKeyEqual<K>>
+class ConcurrentHashTable_t {
+public:
+    using Table = HashTable_t<K, V, Hash, Eq>; // Table type of each shard.
+    using ProbeMode = typename Table::ProbeMode; // Collision resolution strategy, see ProbeSequence.h.
+    using CapacityPolicy = typename Table::CapacityPolicy; // Capacity rounding, see ProbeSequence.h.
+    using KeyArg = typename Table::KeyArg; // Parameter type accepted by lookups.
+
+private:
+    /**
+     * @struct Shard
+     * @brief One lock stripe: a table and the lock guarding it.
+     *
+     * Aligned to a cache line so that locking one shard does not invalidate its neighbours' locks.
+     */
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex; // Shared for lookups, exclusive for modifications.
+        Table table; // Key-value pairs routed to this shard.
+
+        Shard(size_t initCapacity, double inThreshold, double inResizeFactor, ProbeMode inProbeMode,
+            CapacityPolicy inCapacityPolicy, const Hash& inHash); // Parameterized constructor for Shard.
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards; // The shards, indexed by bits of the mixed hash of a key.
+    const unsigned shardBits; // log2 of the number of shards.
+
+    [[nodiscard]] size_t hashOf(KeyArg key) const; // Mixed hash of a key, as computed by every shard.
+    [[nodiscard]] Shard& shardFor(size_t hashValue) const; // Shard responsible for a key with a given hash.
+
+public:
+    explicit ConcurrentHashTable_t(size_t initCapacity = 8, size_t inNumShards = 16, double inThreshold = 0.5, double inResizeFactor = 2.0,
+        ProbeMode inProbeMode = ProbeMode::PSEUDO_RANDOM, CapacityPolicy inCapacityPolicy = CapacityPolicy::POWER_OF_TWO); // Default and parameterized constructor for concurrent hash table.
+
+    [[nodiscard]] size_t shardCount() const; // Getter for number of shards.
+    [[nodiscard]] size_t capacity() const; // Getter for total capacity of the shards.
+    [[nodiscard]] size_t size() const; // Getter for total size of the shards.
+    [[nodiscard]] double alpha() const; // Getter for the overall load factor.
+    [[nodiscard]] HashTableStats stats() const; // Getter for the combined statistics of the shards.
+    [[nodiscard]] std::vector<K> keys() const; // Getter for a list of keys currently used in the table.
+    template<typename Function>
+    void for_each(Function function) const; // Calls a function with the key and value of every key-value pair.
+    [[nodiscard]] std::optional<V> get(KeyArg key) const; // Getter for value stored using a given key.
+
+    [[nodiscard]] bool contains(KeyArg key) const; // Predicate for if a given key is stored in table.
+
+    bool insert(const K& key, const V& value); // Insert key-value pair into table.
+    bool insert_or_assign(const K& key, const V& value); // Insert key-value pair, or assign value if key is present.
+    template<typename Function>
+    bool update(KeyArg key, Function function); // Modifies value stored using a given key in place.
+    void reserve(size_t expectedElements); // Reserves capacity for a number of key-value pairs.
+    bool remove(KeyArg key); // Remove key-value pair from table.
+};
+
+/**
+ * @brief ConcurrentHashTable for <string, unsigned long> key-value pairs
+ *
+ * The ConcurrentHashTable_t class template instantiated for string keys and unsigned long (size_t) values,
+ * with one HashTable per shard.
+ */
+using ConcurrentHashTable = ConcurrentHashTable_t<std::string, size_t>;
+
+/**
+ * @brief Parameterized constructor for Shard.
+ *
+ * @param initCapacity Initial number of empty buckets in the shard's table.
+ * @param inThreshold The load factor threshold for rehashing.
+ * @param inResizeFactor The factor by which the capacity of the shard's table will be increased upon rehashing.
+ * @param inProbeMode The collision resolution strategy.
+ * @param inCapacityPolicy The rounding applied to the capacity.
+ * @param inHash The hash function shared by every shard.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+ConcurrentHashTable_t<K, V, Hash, Eq>::Shard::Shard(const size_t initCapacity, const double inThreshold, const double inResizeFactor,
+    const ProbeMode inProbeMode, const CapacityPolicy inCapacityPolicy, const Hash& inHash) :
+    mutex(), table(initCapacity, inThreshold, inResizeFactor, inProbeMode, inCapacityPolicy, 0.25, 0.0, 0, 1,
+        std::pmr::get_default_resource(), inHash) {}
+
+/**
+ * @brief Default and parameterized constructor for concurrent hash table.
+ *
+ * Creates inNumShards shards (rounded up to a power of two), sharing initCapacity buckets and one hash function between them.
+ * The remaining parameters are passed to the table of every shard.
+ *
+ * @param initCapacity Initial total number of empty buckets (default 8).
+ * @param inNumShards Number of shards (default 16); more shards allow more concurrent writers.
+ * @param inThreshold The load factor threshold for rehashing a shard (default 0.5).
+ * @param inResizeFactor The factor by which the capacity of a shard will be increased upon rehashing (default 2.0).
+ * @param inProbeMode The collision resolution strategy (default PSEUDO_RANDOM).
+ * @param inCapacityPolicy The rounding applied to the capacity of each shard (default POWER_OF_TWO).
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+ConcurrentHashTable_t<K, V, Hash, Eq>::ConcurrentHashTable_t(const size_t initCapacity, const size_t inNumShards, const double inThreshold,
+    const double inResizeFactor, const ProbeMode inProbeMode, const CapacityPolicy inCapacityPolicy) :
+    shards(), shardBits(static_cast<unsigned>(std::countr_zero(std::bit_ceil(std::max(inNumShards, static_cast<size_t>(1)))))) {
+    const size_t numShards = static_cast<size_t>(1) << shardBits;
+    const size_t shardCapacity = (initCapacity + numShards - 1) / numShards;
+    const Hash sharedHash = makeHash<Hash>();
+    shards.reserve(numShards);
+    for (size_t shardNum = 0; shardNum < numShards; ++shardNum) {
+        shards.push_back(std::make_unique<Shard>(shardCapacity, inThreshold, inResizeFactor, inProbeMode, inCapacityPolicy, sharedHash));
+    }
+}
+
+/**
+ * @brief Getter for number of shards.
+ *
+ * @return number of shards (a power of two).
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t ConcurrentHashTable_t<K, V, Hash, Eq>::shardCount() const {
+    return shards.size();
+}
+
+/**
+ * @brief Getter for total capacity of the shards.
+ *
+ * @return sum of shard capacities.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t ConcurrentHashTable_t<K, V, Hash, Eq>::capacity() const {
+    size_t total = 0;
+    for (const std::unique_ptr<Shard>& shard : shards) {
+        std::shared_lock lock(shard->mutex);
+        total += shard->table.capacity();
+    }
+    return total;
+}
+
+/**
+ * @brief Getter for total size of the shards.
+ *
+ * @return sum of shard sizes.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t ConcurrentHashTable_t<K, V, Hash, Eq>::size() const {
+    size_t total = 0;
+    for (const std::unique_ptr<Shard>& shard : shards) {
+        std::shared_lock lock(shard->mutex);
+        total += shard->table.size();
+    }
+    return total;
+}
+
+/**
+ * @brief Getter for the overall load factor.
+ *
+ * Calculated as the ratio between the total size and total capacity of the shards.
+ *
+ * @return load factor (alpha) of table
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+double ConcurrentHashTable_t<K, V, Hash, Eq>::alpha() const {
+    return static_cast<double>(size())/static_cast<double>(capacity());
+}
+
+/**
+ * @brief Getter for the combined statistics of the shards.
+ *
+ * Locks one shard at a time, so the result is not a consistent snapshot while other threads modify the table.
+ * The maximum probe length is the largest of any shard.
+ *
+ * @return combined statistics of every shard (see HashTable_t::stats).
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+HashTableStats ConcurrentHashTable_t<K, V, Hash, Eq>::stats() const {
+    HashTableStats total;
+    for (const std::unique_ptr<Shard>& shard : shards) {
+        std::shared_lock lock(shard->mutex);
+        total += shard->table.stats();
+    }
+    return total;
+}
+
+/**
+ * @brief Getter for a list of keys currently used in the table.
+ *
+ * Concatenates the keys of every shard.
+ *
+ * @return vector of keys present in the table.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+std::vector<K> ConcurrentHashTable_t<K, V, Hash, Eq>::keys() const {
+    std::vector<K> keyList;
+    for (const std::unique_ptr<Shard>& shard : shards) {
+        std::shared_lock lock(shard->mutex);
+        const std::vector<K> shardKeys = shard->table.keys();
+        keyList.insert(keyList.end(), shardKeys.begin(), shardKeys.end());
+    }
+    return keyList;
+}
+
+/**
+ * @brief Calls a function with the key and value of every key-value pair.
+ *
+ * Visits the shards one at a time, holding each shard lock in shared mode while its pairs are visited,
+ * so neither keys nor values are copied. Values are passed as const references, since other readers share the lock.
+ *
+ * @warning function must not access the table, or it may deadlock against a writer waiting for the shard.
+ * @param function function called with every key-value pair, as function(const K& key, const V& value)
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+template<typename Function>
+void ConcurrentHashTable_t<K, V, Hash, Eq>::for_each(Function function) const {
+    for (const std::unique_ptr<Shard>& shard : shards) {
+        std::shared_lock lock(shard->mutex);
+        std::as_const(shard->table).for_each(std::ref(function)); // One function object visits every shard.
+    }
+}
+
+/**
+ * @brief Getter for value stored using a given key.
+ *
+ * Takes the shard lock in shared mode, so lookups of the same shard proceed in parallel.
+ * The value is returned by copy, since a reference would outlive the lock.
+ *
+ * @param key Key to be searched.
+ * @return value associated with key or nullopt.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+std::optional<V> ConcurrentHashTable_t<K, V, Hash, Eq>::get(const KeyArg key) const {
+    const size_t hashValue = hashOf(key);
+    Shard& shard = shardFor(hashValue);
+    std::shared_lock lock(shard.mutex);
+    return shard.table.get(key, hashValue);
+}
+
+/**
+ * @brief Predicate for if a given key is stored in table.
+ *
+ * Takes the shard lock in shared mode, so lookups of the same shard proceed in parallel.
+ *
+ * @param key Key to be searched.
+ * @return true if key found, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool ConcurrentHashTable_t<K, V, Hash, Eq>::contains(const KeyArg key) const {
+    const size_t hashValue = hashOf(key);
+    Shard& shard = shardFor(hashValue);
+    std::shared_lock lock(shard.mutex);
+    return shard.table.contains(key, hashValue);
+}
+
+/**
+ * @brief Insert key-value pair into table.
+ *
+ * Takes the shard lock in exclusive mode; the shard may rehash while it is held.
+ *
+ * @param key of key-value pair to be inserted.
+ * @param value Value of key-value pair to be inserted.
+ * @return true if insertion successful, false if key already present.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool ConcurrentHashTable_t<K, V, Hash, Eq>::insert(const K& key, const V& value) {
+    const size_t hashValue = hashOf(key);
+    Shard& shard = shardFor(hashValue);
+    std::unique_lock lock(shard.mutex);
+    return shard.table.insert(key, value, hashValue);
+}
+
+/**
+ * @brief Insert key-value pair, or assign value if key is present.
+ *
+ * The thread-safe replacement for hashTable[key] = value.
+ *
+ * @param key of key-value pair to be inserted or assigned.
+ * @param value Value to be stored.
+ * @return true if the pair was inserted, false if an existing value was assigned.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool ConcurrentHashTable_t<K, V, Hash, Eq>::insert_or_assign(const K& key, const V& value) {
+    const size_t hashValue = hashOf(key);
+    Shard& shard = shardFor(hashValue);
+    std::unique_lock lock(shard.mutex);
+    return shard.table.insert_or_assign(key, value, hashValue);
+}
+
+/**
+ * @brief Modifies value stored using a given key in place.
+ *
+ * The thread-safe replacement for mutating hashTable[key]. function is called with a reference to the value
+ * while the shard lock is held in exclusive mode, so it must not access the table itself.
+ * E.G:
+ * table.update("name", [](size_t& count) {++count;});
+ *
+ * @param key Key to be searched.
+ * @param function Callable taking V&.
+ * @return true if key found and function applied, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+template<typename Function>
+bool ConcurrentHashTable_t<K, V, Hash, Eq>::update(const KeyArg key, Function function) {
+    const size_t hashValue = hashOf(key);
+    Shard& shard = shardFor(hashValue);
+    std::unique_lock lock(shard.mutex);
+    return shard.table.update(key, hashValue, std::move(function)); // One probe of the key's sequence.
+}
+
+/**
+ * @brief Reserves capacity for a number of key-value pairs.
+ *
+ * Reserves an even share of expectedElements in every shard, locking one at a time.
+ *
+ * @param expectedElements Number of key-value pairs the table should hold without rehashing.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void ConcurrentHashTable_t<K, V, Hash, Eq>::reserve(const size_t expectedElements) {
+    const size_t perShard = (expectedElements + shards.size() - 1) / shards.size();
+    for (const std::unique_ptr<Shard>& shard : shards) {
+        std::unique_lock lock(shard->mutex);
+        shard->table.reserve(perShard);
+    }
+}
+
+/**
+ * @brief Remove key-value pair from table.
+ *
+ * Takes the shard lock in exclusive mode; the shard may shrink or compact while it is held.
+ *
+ * @param key Key to be searched.
+ * @return true if removal successful, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool ConcurrentHashTable_t<K, V, Hash, Eq>::remove(const KeyArg key) {
+    const size_t hashValue = hashOf(key);
+    Shard& shard = shardFor(hashValue);
+    std::unique_lock lock(shard.mutex);
+    return shard.table.remove(key, hashValue);
+}
+
+/**
+ * @brief Mixed hash of a key, as computed by every shard.
+ *
+ * The shards share one hash function, which is never reassigned, so any shard's table can hash the key without its lock.
+ *
+ * @param key Key to be hashed.
+ * @return HashTable_t::hashOf(key) of every shard.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t ConcurrentHashTable_t<K, V, Hash, Eq>::hashOf(const KeyArg key) const {
+    return shards.front()->table.hashOf(key);
+}
+
+/**
+ * @brief Shard responsible for a key with a given hash.
+ *
+ * Shard tables take home buckets from the high bits of the hash and fingerprints from its low 7 bits,
+ * so the bits just above the fingerprint select the shard, leaving each shard's keys spread over its buckets.
+ *
+ * @param hashValue hashOf(key) of the key to be routed.
+ * @return shard holding key, if present.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+typename ConcurrentHashTable_t<K, V, Hash, Eq>::Shard& ConcurrentHashTable_t<K, V, Hash, Eq>::shardFor(const size_t hashValue) const {
+    return *shards[(hashValue >> 7) & (shards.size() - 1)];
+}
+
+#endif // CONCURRENTHASHTABLE_H
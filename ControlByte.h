@@ -0,0 +1,60 @@
+#ifndef CONTROLBYTE_H
+#define CONTROLBYTE_H
+
+/*
+ * Greg Rosen
+ * Project 4: HashTable
+ * Declaration and implementation of the control bytes describing HashTable buckets
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @struct ControlByte
+ * @brief History type and hash fingerprint of a HashTable bucket, packed into one byte.
+ *
+ * Control bytes are stored in their own dense array, apart from keys and values,
+ * so a probe reads one byte per bucket and only touches key storage on a fingerprint match.
+ * NORMAL - Bucket contains key-value pair. High bit clear; the low 7 bits are a fingerprint of the key's hash.
+ * ESS - "Empty Since Start" - Bucket has never been filled since the hash table was last created/resized.
+ * EAR - "Empty After Removal" - Tombstone - Bucket is empty, but has been filled since HashTable was last created/resized.
+ */
+struct ControlByte {
+    static constexpr uint8_t ESS = 0x80; // Control byte of a bucket that has never been filled.
+    static constexpr uint8_t EAR = 0xFE; // Control byte of a tombstone.
+
+    /**
+     * @brief Fingerprint of a hash, stored as the control byte of a NORMAL bucket.
+     *
+     * Uses the low 7 bits of the hash; HashTable takes home buckets from the high bits of the same (mixed) hash.
+     *
+     * @param hashValue Full hash of key.
+     * @return control byte for a bucket holding the key.
+     */
+    [[nodiscard]] static constexpr uint8_t fingerprint(const size_t hashValue) {
+        return static_cast<uint8_t>(hashValue & 0x7F);
+    }
+
+    /**
+     * @brief Predicate for determining if a control byte describes a filled (NORMAL) bucket.
+     *
+     * @param control control byte
+     * @return true if filled, false if empty.
+     */
+    [[nodiscard]] static constexpr bool isFull(const uint8_t control) {
+        return (control & 0x80) == 0;
+    }
+
+    /**
+     * @brief Predicate for determining if a control byte describes an empty (ESS or EAR) bucket.
+     *
+     * @param control control byte
+     * @return true if empty, false if filled.
+     */
+    [[nodiscard]] static constexpr bool isEmpty(const uint8_t control) {
+        return !isFull(control);
+    }
+};
+
+#endif // CONTROLBYTE_H
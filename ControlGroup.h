@@ -0,0 +1,161 @@
+#ifndef CONTROLGROUP_H
+#define CONTROLGROUP_H
+
+/*
+ * Greg Rosen
+ * Project 4: HashTable
+ * Declaration and implementation of SIMD matching over groups of control bytes
+ */
+
+#include "ControlByte.h"
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HASHTABLE_GROUP_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define HASHTABLE_GROUP_NEON
+#include <arm_neon.h>
+#endif
+
+/**
+ * @class ControlGroup
+ * @brief A group of GROUP_WIDTH consecutive control bytes, compared in parallel.
+ *
+ * Each match method returns a bitmask with bit i set if the i-th control byte of the group satisfies the match.
+ * Uses SSE2 on x86-64, NEON on ARM, and a portable scalar loop otherwise; the choice is made at compile time.
+ * The group width is fixed at 16 on every platform so that the control byte layout does not depend on the build.
+ *
+ * @warning The GROUP_WIDTH bytes starting at the given position must be readable.
+ */
+class ControlGroup {
+public:
+    static constexpr size_t GROUP_WIDTH = 16; // Number of control bytes compared at once.
+
+private:
+#if defined(HASHTABLE_GROUP_SSE2)
+    __m128i bytes; // Control bytes of the group.
+#elif defined(HASHTABLE_GROUP_NEON)
+    uint8x16_t bytes; // Control bytes of the group.
+#else
+    uint8_t bytes[GROUP_WIDTH]; // Control bytes of the group.
+#endif
+
+    [[nodiscard]] uint32_t matchByte(uint8_t byte) const; // Bitmask of control bytes equal to byte.
+
+public:
+    explicit ControlGroup(const uint8_t* position); // Loads the control bytes of a group.
+
+    [[nodiscard]] uint32_t match(uint8_t fingerprint) const; // Bitmask of buckets whose fingerprint matches.
+    [[nodiscard]] uint32_t matchESS() const; // Bitmask of buckets that have never been filled.
+    [[nodiscard]] uint32_t matchEmpty() const; // Bitmask of empty buckets (ESS or EAR).
+    [[nodiscard]] uint32_t matchTombstone() const; // Bitmask of tombstones (EAR buckets).
+    [[nodiscard]] uint32_t matchFull() const; // Bitmask of filled (NORMAL) buckets.
+};
+
+/**
+ * @brief Loads the control bytes of a group.
+ *
+ * @param position Pointer to the first control byte of the group.
+ */
+inline ControlGroup::ControlGroup(const uint8_t* position) {
+#if defined(HASHTABLE_GROUP_SSE2)
+    bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(position));
+#elif defined(HASHTABLE_GROUP_NEON)
+    bytes = vld1q_u8(position);
+#else
+    for (size_t lane = 0; lane < GROUP_WIDTH; ++lane) {
+        bytes[lane] = position[lane];
+    }
+#endif
+}
+
+/**
+ * @brief Bitmask of control bytes equal to byte.
+ *
+ * NEON has no movemask instruction, so each matching lane is weighted by its bit within its half
+ * and the halves are summed horizontally.
+ *
+ * @param byte control byte to be matched
+ * @return bitmask of matching lanes.
+ */
+inline uint32_t ControlGroup::matchByte(const uint8_t byte) const {
+#if defined(HASHTABLE_GROUP_SSE2)
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(static_cast<char>(byte)))));
+#elif defined(HASHTABLE_GROUP_NEON)
+    static constexpr uint8_t laneBits[GROUP_WIDTH] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    const uint8x16_t weighted = vandq_u8(vceqq_u8(bytes, vdupq_n_u8(byte)), vld1q_u8(laneBits));
+    return static_cast<uint32_t>(vaddv_u8(vget_low_u8(weighted))) | (static_cast<uint32_t>(vaddv_u8(vget_high_u8(weighted))) << 8);
+#else
+    uint32_t mask = 0;
+    for (size_t lane = 0; lane < GROUP_WIDTH; ++lane) {
+        mask |= static_cast<uint32_t>(bytes[lane] == byte) << lane;
+    }
+    return mask;
+#endif
+}
+
+/**
+ * @brief Bitmask of buckets whose fingerprint matches.
+ *
+ * Empty buckets never match, since fingerprints have the high bit clear.
+ *
+ * @param fingerprint fingerprint of the key being probed
+ * @return bitmask of candidate buckets.
+ */
+inline uint32_t ControlGroup::match(const uint8_t fingerprint) const {
+    return matchByte(fingerprint);
+}
+
+/**
+ * @brief Bitmask of buckets that have never been filled.
+ *
+ * @return bitmask of ESS buckets.
+ */
+inline uint32_t ControlGroup::matchESS() const {
+    return matchByte(ControlByte::ESS);
+}
+
+/**
+ * @brief Bitmask of empty buckets (ESS or EAR).
+ *
+ * Both empty control bytes have the high bit set, and filled ones do not.
+ *
+ * @return bitmask of empty buckets.
+ */
+inline uint32_t ControlGroup::matchEmpty() const {
+#if defined(HASHTABLE_GROUP_SSE2)
+    return static_cast<uint32_t>(_mm_movemask_epi8(bytes));
+#elif defined(HASHTABLE_GROUP_NEON)
+    static constexpr uint8_t laneBits[GROUP_WIDTH] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    const uint8x16_t weighted = vandq_u8(vcltq_s8(vreinterpretq_s8_u8(bytes), vdupq_n_s8(0)), vld1q_u8(laneBits));
+    return static_cast<uint32_t>(vaddv_u8(vget_low_u8(weighted))) | (static_cast<uint32_t>(vaddv_u8(vget_high_u8(weighted))) << 8);
+#else
+    uint32_t mask = 0;
+    for (size_t lane = 0; lane < GROUP_WIDTH; ++lane) {
+        mask |= static_cast<uint32_t>(ControlByte::isEmpty(bytes[lane])) << lane;
+    }
+    return mask;
+#endif
+}
+
+/**
+ * @brief Bitmask of tombstones (EAR buckets).
+ *
+ * @return bitmask of EAR buckets.
+ */
+inline uint32_t ControlGroup::matchTombstone() const {
+    return matchByte(ControlByte::EAR);
+}
+
+/**
+ * @brief Bitmask of filled (NORMAL) buckets.
+ *
+ * @return bitmask of filled buckets.
+ */
+inline uint32_t ControlGroup::matchFull() const {
+    return ~matchEmpty() & ((static_cast<uint32_t>(1) << GROUP_WIDTH) - 1);
+}
+
+#endif // CONTROLGROUP_H
@@ -0,0 +1,305 @@
+#ifndef CUCKOOFILTER_H
+#define CUCKOOFILTER_H
+
+/*
+ * Greg Rosen
+ * Project 4: HashTable
+ * Declaration and implementation of CuckooFilter class
+ */
+
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * @struct PrefilterStats
+ * @brief Outcomes of lookups screened by a CuckooFilter.
+ *
+ * Every lookup is either rejected by the filter without touching the table, or passed to the table,
+ * where it is a hit or a false positive (a key absent from the table that the filter could not rule out).
+ */
+struct PrefilterStats {
+    uint64_t lookups = 0; // Number of lookups screened by the filter.
+    uint64_t rejected = 0; // Number of lookups rejected by the filter.
+    uint64_t falsePositives = 0; // Number of lookups passed by the filter that missed in the table.
+
+    [[nodiscard]] uint64_t hits() const; // Getter for number of lookups that found their key.
+    [[nodiscard]] double rejectRate() const; // Getter for the fraction of lookups rejected by the filter.
+    [[nodiscard]] double falsePositiveRate() const; // Getter for the fraction of misses the filter failed to reject.
+};
+
+/**
+ * @class CuckooFilter
+ * @brief Approximate set of hashes supporting insertion, removal, and membership tests.
+ *
+ * Stores a 16-bit fingerprint of each hash in one of two candidate buckets of four fingerprints (partial-key cuckoo hashing):
+ * the second bucket is the first one exclusive-or a hash of the fingerprint, so either bucket can be found from the other
+ * when a fingerprint is displaced. Each bucket is a single 64-bit word, searched for a fingerprint with SWAR arithmetic,
+ * so a membership test reads at most two words. A test never fails for an inserted hash; it succeeds for other hashes
+ * with probability about 8 / 65536.
+ * Removing a hash that was never inserted may remove another hash, so callers remove only what they inserted.
+ * Buckets are allocated from a std::pmr::memory_resource.
+ *
+ * @author Greg Rosen
+ * @date November 2, 2025
+ */
+class CuckooFilter {
+private:
+    static constexpr size_t SLOTS = 4; // Number of fingerprints per bucket.
+    static constexpr double MAX_LOAD = 0.9; // Fraction of slots filled by the expected number of hashes.
+    static constexpr size_t MAX_KICKS = 500; // Number of displacements tried before an insertion fails.
+    static constexpr uint64_t LOW_BITS = 0x0001000100010001ULL; // Lowest bit of every slot.
+    static constexpr uint64_t HIGH_BITS = 0x8000800080008000ULL; // Highest bit of every slot.
+
+    /**
+     * @struct Victim
+     * @brief Fingerprint left over by a failed insertion, kept so that no inserted hash is lost.
+     */
+    struct Victim {
+        uint16_t fingerprint = 0; // Fingerprint, or 0 if there is no victim.
+        size_t index = 0; // One of the fingerprint's two candidate buckets.
+    };
+
+    std::pmr::vector<uint64_t> buckets; // Four 16-bit fingerprints per bucket; 0 marks an empty slot.
+    size_t indexMask; // Number of buckets - 1.
+    size_t numStored; // Number of fingerprints stored, victim included.
+    Victim victim; // Fingerprint that could not be placed, if any; the filter accepts no more insertions while it is held.
+    uint64_t kickState; // State of the generator choosing slots to displace.
+
+    [[nodiscard]] static uint16_t fingerprintOf(size_t hashValue); // Nonzero fingerprint of a hash.
+    [[nodiscard]] size_t alternateIndex(size_t index, uint16_t fingerprint) const; // Other candidate bucket of a fingerprint.
+    [[nodiscard]] static uint64_t matchLanes(uint64_t bucket, uint16_t fingerprint); // Bitmask marking the first slot holding a fingerprint.
+    bool place(size_t index, uint16_t fingerprint); // Stores a fingerprint in an empty slot of a bucket.
+
+public:
+    explicit CuckooFilter(size_t expectedHashes = 0,
+        std::pmr::memory_resource* inResource = std::pmr::get_default_resource()); // Default and parameterized constructor for CuckooFilter.
+
+    [[nodiscard]] size_t size() const; // Getter for number of fingerprints stored.
+    [[nodiscard]] size_t bytes() const; // Getter for number of bytes of buckets.
+    [[nodiscard]] bool contains(size_t hashValue) const; // Predicate for if a hash may have been inserted.
+
+    bool insert(size_t hashValue); // Inserts a hash.
+    bool remove(size_t hashValue); // Removes a hash that was inserted.
+    void reset(size_t expectedHashes); // Empties the filter, sizing it for a number of hashes.
+};
+
+/**
+ * @brief Getter for number of lookups that found their key.
+ *
+ * @return lookups neither rejected nor false positives.
+ */
+inline uint64_t PrefilterStats::hits() const {
+    return lookups - rejected - falsePositives;
+}
+
+/**
+ * @brief Getter for the fraction of lookups rejected by the filter.
+ *
+ * @return rejected lookups over all lookups (0 if there were none).
+ */
+inline double PrefilterStats::rejectRate() const {
+    return lookups == 0 ? 0.0 : static_cast<double>(rejected) / static_cast<double>(lookups);
+}
+
+/**
+ * @brief Getter for the fraction of misses the filter failed to reject.
+ *
+ * @return false positives over all lookups of absent keys (0 if there were none).
+ */
+inline double PrefilterStats::falsePositiveRate() const {
+    const uint64_t misses = rejected + falsePositives;
+    return misses == 0 ? 0.0 : static_cast<double>(falsePositives) / static_cast<double>(misses);
+}
+
+/**
+ * @brief Default and parameterized constructor for CuckooFilter.
+ *
+ * @param expectedHashes number of hashes the filter is sized for (default 0, one bucket)
+ * @param inResource memory resource of the buckets (default resource unless given)
+ */
+inline CuckooFilter::CuckooFilter(const size_t expectedHashes, std::pmr::memory_resource* const inResource) :
+    buckets(inResource), indexMask(0), numStored(0), victim(), kickState(0x9E3779B97F4A7C15ULL) {
+    reset(expectedHashes);
+}
+
+/**
+ * @brief Getter for number of fingerprints stored.
+ *
+ * @return number of hashes inserted and not removed.
+ */
+inline size_t CuckooFilter::size() const {
+    return numStored;
+}
+
+/**
+ * @brief Getter for number of bytes of buckets.
+ *
+ * @return size of the bucket array in bytes.
+ */
+inline size_t CuckooFilter::bytes() const {
+    return buckets.size() * sizeof(uint64_t);
+}
+
+/**
+ * @brief Predicate for if a hash may have been inserted.
+ *
+ * @param hashValue hash tested
+ * @return true if the hash was inserted (or shares a fingerprint and bucket with one that was), false if it was not.
+ */
+inline bool CuckooFilter::contains(const size_t hashValue) const {
+    const uint16_t fingerprint = fingerprintOf(hashValue);
+    const size_t index = hashValue & indexMask;
+    const size_t alternate = alternateIndex(index, fingerprint);
+    if (matchLanes(buckets[index], fingerprint) != 0 || matchLanes(buckets[alternate], fingerprint) != 0) {
+        return true;
+    }
+    return victim.fingerprint == fingerprint && (victim.index == index || victim.index == alternate);
+}
+
+/**
+ * @brief Inserts a hash.
+ *
+ * If both candidate buckets are full, fingerprints are displaced to their other buckets, up to MAX_KICKS times.
+ * If that fails, the last displaced fingerprint is kept as the victim, so nothing is lost, and the insertion fails.
+ *
+ * @param hashValue hash inserted
+ * @return true if inserted, false if the filter is full and should be rebuilt larger.
+ */
+inline bool CuckooFilter::insert(const size_t hashValue) {
+    if (victim.fingerprint != 0) {
+        return false;
+    }
+    uint16_t fingerprint = fingerprintOf(hashValue);
+    size_t index = hashValue & indexMask;
+    if (place(index, fingerprint) || place(alternateIndex(index, fingerprint), fingerprint)) {
+        ++numStored;
+        return true;
+    }
+    for (size_t kick = 0; kick < MAX_KICKS; ++kick) {
+        kickState ^= kickState << 13; // xorshift64
+        kickState ^= kickState >> 7;
+        kickState ^= kickState << 17;
+        const unsigned shift = static_cast<unsigned>(kickState % SLOTS) * 16;
+        const auto displaced = static_cast<uint16_t>(buckets[index] >> shift);
+        buckets[index] = (buckets[index] & ~(static_cast<uint64_t>(0xFFFF) << shift)) | (static_cast<uint64_t>(fingerprint) << shift);
+        fingerprint = displaced;
+        index = alternateIndex(index, fingerprint);
+        if (place(index, fingerprint)) {
+            ++numStored;
+            return true;
+        }
+    }
+    victim = {fingerprint, index};
+    ++numStored;
+    return false;
+}
+
+/**
+ * @brief Removes a hash that was inserted.
+ *
+ * @param hashValue hash removed
+ * @return true if a matching fingerprint was removed.
+ */
+inline bool CuckooFilter::remove(const size_t hashValue) {
+    const uint16_t fingerprint = fingerprintOf(hashValue);
+    const size_t index = hashValue & indexMask;
+    const size_t alternate = alternateIndex(index, fingerprint);
+    for (const size_t candidate : {index, alternate}) {
+        if (const uint64_t match = matchLanes(buckets[candidate], fingerprint); match != 0) {
+            const unsigned shift = static_cast<unsigned>(std::countr_zero(match)) & ~15U;
+            buckets[candidate] &= ~(static_cast<uint64_t>(0xFFFF) << shift);
+            --numStored;
+            if (victim.fingerprint != 0 && (place(victim.index, victim.fingerprint)
+                || place(alternateIndex(victim.index, victim.fingerprint), victim.fingerprint))) { // The freed slot may take the victim.
+                victim = {};
+            }
+            return true;
+        }
+    }
+    if (victim.fingerprint == fingerprint && (victim.index == index || victim.index == alternate)) {
+        victim = {};
+        --numStored;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Empties the filter, sizing it for a number of hashes.
+ *
+ * The number of buckets is the smallest power of two holding expectedHashes at a load of at most MAX_LOAD.
+ *
+ * @param expectedHashes number of hashes the filter should hold
+ */
+inline void CuckooFilter::reset(const size_t expectedHashes) {
+    const auto required = static_cast<size_t>(std::ceil(static_cast<double>(expectedHashes) / (SLOTS * MAX_LOAD)));
+    buckets.assign(std::bit_ceil(std::max(required, static_cast<size_t>(1))), 0);
+    indexMask = buckets.size() - 1;
+    numStored = 0;
+    victim = {};
+}
+
+/**
+ * @brief Nonzero fingerprint of a hash.
+ *
+ * Taken from the top bits of the hash multiplied by 2^64 / phi, which are independent of the low bits selecting the bucket.
+ *
+ * @param hashValue hash of key
+ * @return fingerprint between 1 and 65535.
+ */
+inline uint16_t CuckooFilter::fingerprintOf(const size_t hashValue) {
+    const auto fingerprint = static_cast<uint16_t>((static_cast<uint64_t>(hashValue) * 0x9E3779B97F4A7C15ULL) >> 48);
+    return fingerprint != 0 ? fingerprint : 1;
+}
+
+/**
+ * @brief Other candidate bucket of a fingerprint.
+ *
+ * An involution: the alternate of the alternate is the original bucket.
+ *
+ * @param index one candidate bucket
+ * @param fingerprint fingerprint stored
+ * @return other candidate bucket.
+ */
+inline size_t CuckooFilter::alternateIndex(const size_t index, const uint16_t fingerprint) const {
+    return (index ^ (static_cast<size_t>(fingerprint) * 0x5BD1E995)) & indexMask;
+}
+
+/**
+ * @brief Bitmask marking the first slot holding a fingerprint.
+ *
+ * Exclusive or with the fingerprint repeated zeroes matching slots, which the classic has-zero-byte test,
+ * applied to 16-bit lanes, detects. The lowest marked lane is always a true match.
+ *
+ * @param bucket bucket searched
+ * @param fingerprint fingerprint searched for (0 finds empty slots)
+ * @return nonzero if a slot holds fingerprint; its lowest set bit is the top bit of the first such slot.
+ */
+inline uint64_t CuckooFilter::matchLanes(const uint64_t bucket, const uint16_t fingerprint) {
+    const uint64_t difference = bucket ^ (LOW_BITS * fingerprint);
+    return (difference - LOW_BITS) & ~difference & HIGH_BITS;
+}
+
+/**
+ * @brief Stores a fingerprint in an empty slot of a bucket.
+ *
+ * @param index bucket
+ * @param fingerprint fingerprint stored
+ * @return true if the bucket had an empty slot.
+ */
+inline bool CuckooFilter::place(const size_t index, const uint16_t fingerprint) {
+    const uint64_t empty = matchLanes(buckets[index], 0);
+    if (empty == 0) {
+        return false;
+    }
+    const unsigned shift = static_cast<unsigned>(std::countr_zero(empty)) & ~15U;
+    buckets[index] |= static_cast<uint64_t>(fingerprint) << shift;
+    return true;
+}
+
+#endif // CUCKOOFILTER_H
@@ -0,0 +1,400 @@
+#ifndef FILTEREDHASHTABLE_H
+#define FILTEREDHASHTABLE_H
+
+/*
+ * Greg Rosen
+ * Project 4: HashTable
+ * Declaration and implementation of FilteredHashTable_t class template
+ */
+
+#include "CuckooFilter.h"
+#include "HashTableImpl.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @class FilteredHashTable_t
+ * @brief HashTable for <K, V> key-value pairs, with a cuckoo filter screening lookups.
+ *
+ * Every key in the table has a fingerprint in a CuckooFilter, kept in step by insert and remove.
+ * get, contains, and remove consult the filter first: most absent keys are rejected by reading one or two
+ * 8-byte filter buckets, without probing the table, however long its probe chains and tombstone runs are.
+ * The filter takes two bytes per slot, a few bytes per key, so it stays cache resident long after tableData does not.
+ * Present keys pay for one extra filter test, so the filter pays off for miss-heavy workloads;
+ * filterStats() counts rejected lookups and false positives to show whether it does.
+ * The filter is rebuilt from the keys of the table whenever the table's capacity changes (on every rehash),
+ * sized for the number of keys the table can hold before its next rehash.
+ * Each key is hashed once, by the table's hashOf, and the same hash is given to the filter and to the table's lookup.
+ * The filter is allocated from the table's memory resource.
+ *
+ * @author Greg Rosen
+ * @date November 2, 2025
+ */
+template<typename K, typename V, typename Hash = DefaultHash<K>, typename Eq = DefaultKeyEqual<K>>
+class FilteredHashTable_t {
+public:
+    using Table = HashTable_t<K, V, Hash, Eq>; // Table type behind the filter.
+    using ProbeMode = typename Table::ProbeMode; // Collision resolution strategy, see ProbeSequence.h.
+    using CapacityPolicy = typename Table::CapacityPolicy; // Capacity rounding, see ProbeSequence.h.
+    using KeyArg = typename Table::KeyArg; // Parameter type accepted by lookups.
+
+private:
+    Table table; // Key-value pairs.
+    const double threshold; // The load factor threshold for rehashing the table, used to size the filter.
+    CuckooFilter filter; // Fingerprint of every key in table.
+    size_t filterCapacity; // Capacity of table when filter was last rebuilt.
+    PrefilterStats counters; // Outcomes of the lookups screened by filter.
+
+    void addToFilter(size_t hashValue); // Adds the hash of a newly inserted key to the filter.
+    void syncFilter(); // Rebuilds the filter if the table has been rehashed to a new capacity.
+    void rebuildFilter(); // Refills the filter from the keys of the table.
+
+public:
+    explicit FilteredHashTable_t(size_t initCapacity = 8, double inThreshold = 0.5, double inResizeFactor = 2.0,
+        ProbeMode inProbeMode = ProbeMode::PSEUDO_RANDOM, CapacityPolicy inCapacityPolicy = CapacityPolicy::POWER_OF_TWO,
+        double inTombstoneThreshold = 0.25, double inShrinkThreshold = 0.0, size_t inMigrationStep = 0,
+        size_t inRehashThreads = 1,
+        std::pmr::memory_resource* inResource = std::pmr::get_default_resource()); // Default and parameterized constructor for filtered hash table.
+
+    V& operator[](KeyArg key); // Subscript operator overload for filtered hash table.
+
+    [[nodiscard]] size_t capacity() const; // Getter for capacity of the table.
+    [[nodiscard]] size_t size() const; // Getter for size of the table.
+    [[nodiscard]] double alpha() const; // Getter for the load factor of the table.
+    [[nodiscard]] size_t filterBytes() const; // Getter for number of bytes of the filter.
+    [[nodiscard]] PrefilterStats filterStats() const; // Getter for the outcomes of lookups screened by the filter.
+    [[nodiscard]] HashTableStats stats() const; // Getter for a snapshot of the statistics of the table.
+    [[nodiscard]] std::vector<K> keys() const; // Getter for a list of keys currently used in the table.
+    template<typename Function>
+    void for_each(Function function); // Calls a function with the key and value of every key-value pair.
+    [[nodiscard]] std::optional<V> get(KeyArg key); // Getter for value stored using a given key.
+
+    [[nodiscard]] bool contains(KeyArg key); // Predicate for if a given key is stored in table.
+
+    bool insert(const K& key, const V& value); // Insert key-value pair into table.
+    bool insert_or_assign(const K& key, const V& value); // Insert key-value pair, or assign value if key is present.
+    void reserve(size_t expectedElements); // Reserves capacity for a number of key-value pairs.
+    bool remove(KeyArg key); // Remove key-value pair from table.
+    void compact(); // Rehashes the table at its current capacity, clearing all tombstones.
+    void shrink_to_fit(); // Rehashes the table to the smallest capacity that holds its key-value pairs.
+};
+
+/**
+ * @brief FilteredHashTable for <string, unsigned long> key-value pairs
+ *
+ * The FilteredHashTable_t class template instantiated for string keys and unsigned long (size_t) values.
+ */
+using FilteredHashTable = FilteredHashTable_t<std::string, size_t>;
+
+/**
+ * @brief Default and parameterized constructor for filtered hash table.
+ *
+ * Parameters are passed to the table (see HashTable_t), and the filter is sized for the table's first rehash.
+ *
+ * @param initCapacity Initial number of empty buckets (default 8).
+ * @param inThreshold The load factor threshold for rehashing (default 0.5).
+ * @param inResizeFactor The factor by which the capacity will be increased upon rehashing (default 2.0).
+ * @param inProbeMode The collision resolution strategy (default PSEUDO_RANDOM).
+ * @param inCapacityPolicy The rounding applied to the capacity (default POWER_OF_TWO).
+ * @param inTombstoneThreshold The fraction of buckets that may be tombstones before compaction (default 0.25).
+ * @param inShrinkThreshold The load factor below which removals shrink the table (default 0.0, never).
+ * @param inMigrationStep The number of old buckets migrated per operation during a rehash (default 0, rehash at once).
+ * @param inRehashThreads The number of threads moving key-value pairs during a rehash (default 1).
+ * @param inResource The memory resource the table and filter allocate from (default resource unless given).
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+FilteredHashTable_t<K, V, Hash, Eq>::FilteredHashTable_t(const size_t initCapacity, const double inThreshold, const double inResizeFactor,
+    const ProbeMode inProbeMode, const CapacityPolicy inCapacityPolicy, const double inTombstoneThreshold, const double inShrinkThreshold,
+    const size_t inMigrationStep, const size_t inRehashThreads, std::pmr::memory_resource* const inResource) :
+    table(initCapacity, inThreshold, inResizeFactor, inProbeMode, inCapacityPolicy, inTombstoneThreshold, inShrinkThreshold,
+        inMigrationStep, inRehashThreads, inResource),
+    threshold(inThreshold), filter(0, inResource), filterCapacity(0), counters() {
+    rebuildFilter();
+}
+
+/**
+ * @brief Subscript operator overload for filtered hash table.
+ *
+ * Behaves as HashTable_t::operator[]; it never inserts, so the filter is not consulted or changed.
+ *
+ * @param key Key to be searched.
+ * @return reference to value associated with key.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+V& FilteredHashTable_t<K, V, Hash, Eq>::operator[](const KeyArg key) {
+    return table[key];
+}
+
+/**
+ * @brief Getter for capacity of the table.
+ *
+ * @return number of buckets in the table.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t FilteredHashTable_t<K, V, Hash, Eq>::capacity() const {
+    return table.capacity();
+}
+
+/**
+ * @brief Getter for size of the table.
+ *
+ * @return number of key-value pairs in the table.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t FilteredHashTable_t<K, V, Hash, Eq>::size() const {
+    return table.size();
+}
+
+/**
+ * @brief Getter for the load factor of the table.
+ *
+ * @return load factor (alpha) of the table.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+double FilteredHashTable_t<K, V, Hash, Eq>::alpha() const {
+    return table.alpha();
+}
+
+/**
+ * @brief Getter for number of bytes of the filter.
+ *
+ * @return size of the filter's bucket array in bytes.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t FilteredHashTable_t<K, V, Hash, Eq>::filterBytes() const {
+    return filter.bytes();
+}
+
+/**
+ * @brief Getter for the outcomes of lookups screened by the filter.
+ *
+ * Counts calls to get and contains since construction. The filter pays for itself when the
+ * rejected lookups save more probing than the filter tests of the remaining lookups cost.
+ *
+ * @return lookup, rejection, and false positive counts.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+PrefilterStats FilteredHashTable_t<K, V, Hash, Eq>::filterStats() const {
+    return counters;
+}
+
+/**
+ * @brief Getter for a snapshot of the statistics of the table.
+ *
+ * Lookups rejected by the filter never reach the table, so are not counted here (see filterStats).
+ *
+ * @return statistics of the table (see HashTable_t::stats).
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+HashTableStats FilteredHashTable_t<K, V, Hash, Eq>::stats() const {
+    return table.stats();
+}
+
+/**
+ * @brief Getter for a list of keys currently used in the table.
+ *
+ * @return vector of keys present in the table.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+std::vector<K> FilteredHashTable_t<K, V, Hash, Eq>::keys() const {
+    return table.keys();
+}
+
+/**
+ * @brief Calls a function with the key and value of every key-value pair.
+ *
+ * @param function function called with every key-value pair, as function(const K& key, V& value)
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+template<typename Function>
+void FilteredHashTable_t<K, V, Hash, Eq>::for_each(Function function) {
+    table.for_each(std::move(function));
+}
+
+/**
+ * @brief Getter for value stored using a given key.
+ *
+ * Returns nullopt without probing the table if the filter rejects key.
+ *
+ * @param key Key to be searched.
+ * @return value associated with key or nullopt.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+std::optional<V> FilteredHashTable_t<K, V, Hash, Eq>::get(const KeyArg key) {
+    ++counters.lookups;
+    const size_t hashValue = table.hashOf(key);
+    if (!filter.contains(hashValue)) {
+        ++counters.rejected;
+        return std::nullopt;
+    }
+    std::optional<V> value = table.get(key, hashValue);
+    if (!value) {
+        ++counters.falsePositives;
+    }
+    return value;
+}
+
+/**
+ * @brief Predicate for if a given key is stored in table.
+ *
+ * Returns false without probing the table if the filter rejects key.
+ *
+ * @param key Key to be searched.
+ * @return true if key found, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool FilteredHashTable_t<K, V, Hash, Eq>::contains(const KeyArg key) {
+    ++counters.lookups;
+    const size_t hashValue = table.hashOf(key);
+    if (!filter.contains(hashValue)) {
+        ++counters.rejected;
+        return false;
+    }
+    const bool found = table.contains(key, hashValue);
+    if (!found) {
+        ++counters.falsePositives;
+    }
+    return found;
+}
+
+/**
+ * @brief Insert key-value pair into table.
+ *
+ * @param key of key-value pair to be inserted.
+ * @param value Value of key-value pair to be inserted.
+ * @return true if insertion successful, false if key already present.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool FilteredHashTable_t<K, V, Hash, Eq>::insert(const K& key, const V& value) {
+    const size_t hashValue = table.hashOf(key);
+    if (!table.insert(key, value, hashValue)) {
+        return false;
+    }
+    addToFilter(hashValue);
+    return true;
+}
+
+/**
+ * @brief Insert key-value pair, or assign value if key is present.
+ *
+ * @param key of key-value pair to be inserted or assigned.
+ * @param value Value to be stored.
+ * @return true if the pair was inserted, false if an existing value was assigned.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool FilteredHashTable_t<K, V, Hash, Eq>::insert_or_assign(const K& key, const V& value) {
+    const size_t hashValue = table.hashOf(key);
+    if (!table.insert_or_assign(key, value, hashValue)) {
+        return false;
+    }
+    addToFilter(hashValue);
+    return true;
+}
+
+/**
+ * @brief Reserves capacity for a number of key-value pairs.
+ *
+ * Rebuilds the filter if the table is rehashed.
+ *
+ * @param expectedElements Number of key-value pairs the table should hold without rehashing.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void FilteredHashTable_t<K, V, Hash, Eq>::reserve(const size_t expectedElements) {
+    table.reserve(expectedElements);
+    syncFilter();
+}
+
+/**
+ * @brief Remove key-value pair from table.
+ *
+ * Returns false without probing the table if the filter rejects key.
+ * Otherwise removes the key's fingerprint along with the key.
+ *
+ * @param key Key to be searched.
+ * @return true if removal successful, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool FilteredHashTable_t<K, V, Hash, Eq>::remove(const KeyArg key) {
+    const size_t hashValue = table.hashOf(key);
+    if (!filter.contains(hashValue) || !table.remove(key, hashValue)) {
+        return false;
+    }
+    filter.remove(hashValue);
+    syncFilter(); // The table may have shrunk.
+    return true;
+}
+
+/**
+ * @brief Rehashes the table at its current capacity, clearing all tombstones.
+ *
+ * The capacity is unchanged, so the filter is kept.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void FilteredHashTable_t<K, V, Hash, Eq>::compact() {
+    table.compact();
+}
+
+/**
+ * @brief Rehashes the table to the smallest capacity that holds its key-value pairs.
+ *
+ * Rebuilds the filter for the new capacity.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void FilteredHashTable_t<K, V, Hash, Eq>::shrink_to_fit() {
+    table.shrink_to_fit();
+    syncFilter();
+}
+
+/**
+ * @brief Adds the hash of a newly inserted key to the filter.
+ *
+ * If the insertion rehashed the table, or the filter is full, the filter is rebuilt instead,
+ * which adds the key along with every other key.
+ *
+ * @param hashValue hash of key inserted, computed by the table's hashOf
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void FilteredHashTable_t<K, V, Hash, Eq>::addToFilter(const size_t hashValue) {
+    if (table.capacity() != filterCapacity || !filter.insert(hashValue)) {
+        rebuildFilter();
+    }
+}
+
+/**
+ * @brief Rebuilds the filter if the table has been rehashed to a new capacity.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void FilteredHashTable_t<K, V, Hash, Eq>::syncFilter() {
+    if (table.capacity() != filterCapacity) {
+        rebuildFilter();
+    }
+}
+
+/**
+ * @brief Refills the filter from the keys of the table.
+ *
+ * Sizes the filter for the number of keys at which the table next rehashes (or its current size, if larger).
+ * If the filter still fills up, which happens rarely near its maximum load, it is rebuilt twice as large.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void FilteredHashTable_t<K, V, Hash, Eq>::rebuildFilter() {
+    filterCapacity = table.capacity();
+    size_t expectedKeys = std::max({table.size(), static_cast<size_t>(std::ceil(threshold * static_cast<double>(filterCapacity))), static_cast<size_t>(1)});
+    bool complete = false;
+    while (!complete) {
+        filter.reset(expectedKeys);
+        complete = true;
+        std::as_const(table).for_each([this, &complete](const K& key, const V&) {
+            complete = complete && filter.insert(table.hashOf(key));
+        });
+        expectedKeys *= 2;
+    }
+}
+
+#endif // FILTEREDHASHTABLE_H
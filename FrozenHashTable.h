@@ -0,0 +1,478 @@
+#ifndef FROZENHASHTABLE_H
+#define FROZENHASHTABLE_H
+
+/*
+ * Greg Rosen
+ * Project 4: HashTable
+ * Declaration and implementation of FrozenHashTable_t class template
+ */
+
+#include "HashTableImpl.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @class FrozenHashTable_t
+ * @brief Read-only HashTable for <K, V> key-value pairs, indexed by a perfect hash function.
+ *
+ * Built once from the key-value pairs of a HashTable_t, after which keys can only be looked up.
+ * Construction builds a perfect hash function in the style of PTHash: keys are split by hash into buckets of
+ * about KEYS_PER_BUCKET keys, and the buckets, largest first, are each given the smallest pilot value that sends
+ * all of their keys to slots not yet taken. A key's slot is then a function of its hash and its bucket's pilot,
+ * so every lookup, successful or not, examines exactly one slot: there are no probe sequences and no tombstones.
+ * Slots outnumber keys by only 1 / LOAD_FACTOR, and the pilots add about one byte per key.
+ * Each slot has a control byte holding the fingerprint of its key, or ESS if it is empty, so that most
+ * unsuccessful lookups are rejected without reading key storage.
+ * With ArenaString keys, key characters are copied into an arena owned by the table.
+ *
+ * Two distinct keys whose full hashes are identical cannot be separated by any pilot; such keys (and the keys of
+ * any bucket for which no pilot is found) are kept in a small overflow list, searched when the slot does not match.
+ * The list is empty unless the hash function collides.
+ *
+ * @author Greg Rosen
+ * @date November 2, 2025
+ */
+template<typename K, typename V, typename Hash = DefaultHash<K>, typename Eq = DefaultKeyEqual<K>>
+class FrozenHashTable_t {
+public:
+    using KeyArg = typename KeyTraits<K>::lookup_type; // Parameter type accepted by lookups.
+    using LookupKey = std::remove_cvref_t<KeyArg>; // Element type of the key spans accepted by batched lookups.
+
+private:
+    static constexpr bool arenaKeys = KeyTraits<K>::arenaStorage; // Whether key characters are stored in the arena of the table.
+
+    /**
+     * @struct Entry
+     * @brief Key-value pair stored in a slot of the table.
+     */
+    struct Entry {
+        K key; // Key for table entry.
+        V value; // Value for table entry.
+    };
+
+    static constexpr double KEYS_PER_BUCKET = 4.0; // Average number of keys per pilot bucket.
+    static constexpr double LOAD_FACTOR = 0.99; // Fraction of slots filled.
+    static constexpr uint32_t MAX_PILOT = static_cast<uint32_t>(1) << 20; // Number of pilot values tried per bucket before it goes to overflow.
+    static constexpr size_t PREFETCH_DISTANCE = 8; // Number of keys ahead of the current one that batched lookups prefetch.
+
+    std::vector<uint8_t> control; // Fingerprint of the key in every slot, or ESS if empty.
+    std::vector<Entry> slots; // Key-value pair of every slot.
+    std::vector<uint32_t> pilots; // Pilot value of every bucket.
+    std::vector<Entry> overflow; // Key-value pairs that could not be given a slot (normally none).
+    [[no_unique_address]] std::conditional_t<arenaKeys, KeyArena, NoKeyArena> keyArena; // Characters of the keys (if arena keys are used).
+    size_t numFilled; // The number of key-value pairs in the table.
+    [[no_unique_address]] Hash hash; // Using () overload, provides hash function size_t hash(KeyArg)
+    [[no_unique_address]] Eq equal; // Using () overload, provides key equality predicate bool equal(K, KeyArg)
+    V badKeyDrain; // Dummy variable for capturing invalid uses of subscript operator.
+
+    [[nodiscard]] static uint64_t mix(uint64_t value); // Scrambles the bits of a 64-bit value.
+    [[nodiscard]] static size_t reduce(uint64_t value, size_t range); // Maps a 64-bit value onto [0, range).
+    [[nodiscard]] uint64_t keyHash(KeyArg key) const; // Mixed hash of a key.
+    [[nodiscard]] size_t slotOf(uint64_t mixedHash) const; // Slot of a key with given mixed hash.
+    [[nodiscard]] size_t slotOf(uint64_t mixedHash, uint32_t pilot) const; // Slot of a key with given mixed hash under a given pilot.
+    [[nodiscard]] const Entry* find(KeyArg key, uint64_t mixedHash) const; // Find entry holding key.
+    void build(std::vector<std::pair<K, V>> pairs); // Builds the perfect hash function and places every pair.
+
+public:
+    explicit FrozenHashTable_t(const HashTable_t<K, V, Hash, Eq>& table); // Constructor for frozen hash table from a hash table.
+
+    V& operator[](KeyArg key); // Subscript operator overload for frozen hash table.
+
+    [[nodiscard]] size_t capacity() const; // Getter for number of slots of the frozen hash table.
+    [[nodiscard]] size_t size() const; // Getter for size of the frozen hash table.
+    [[nodiscard]] double alpha() const; // Getter for the load factor of the frozen hash table.
+    [[nodiscard]] std::vector<K> keys() const; // Getter for a list of keys stored in the frozen hash table.
+    [[nodiscard]] std::optional<V> get(KeyArg key) const; // Getter for value stored using a given key.
+
+    [[nodiscard]] bool contains(KeyArg key) const; // Predicate for if a given key is stored in table.
+    size_t get_many(std::span<const LookupKey> keys, std::span<std::optional<V>> values) const; // Getter for values stored using a batch of keys.
+    size_t contains_many(std::span<const LookupKey> keys, std::span<bool> results) const; // Predicate for which of a batch of keys are stored in table.
+};
+
+/**
+ * @brief FrozenHashTable for <string, unsigned long> key-value pairs
+ *
+ * The FrozenHashTable_t class template instantiated for string keys and unsigned long (size_t) values,
+ * built from a HashTable.
+ */
+using FrozenHashTable = FrozenHashTable_t<std::string, size_t>;
+
+/**
+ * @brief Constructor for frozen hash table from a hash table.
+ *
+ * Copies every key-value pair of table (including those not yet migrated by an incremental rehash)
+ * and builds the perfect hash function over them. O(size) expected time; table is not modified.
+ *
+ * @param table hash table to be frozen
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+FrozenHashTable_t<K, V, Hash, Eq>::FrozenHashTable_t(const HashTable_t<K, V, Hash, Eq>& table) :
+    control(), slots(), pilots(), overflow(), keyArena(), numFilled(0), hash(makeHash<Hash>()), equal(), badKeyDrain() {
+    build(table.pairs());
+}
+
+/**
+ * @brief Subscript operator overload for frozen hash table.
+ *
+ * Returns a reference to the value associated with key, like HashTable::operator[].
+ * Values may be modified in place; keys may not be added.
+ *
+ * @warning If the key is not in the table, the returned reference points to a dummy value field of the table.
+ *
+ * @param key Key to be searched.
+ * @return Reference to value associated with key.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+V& FrozenHashTable_t<K, V, Hash, Eq>::operator[](const KeyArg key) {
+    if (const Entry* foundEntry = find(key, keyHash(key))) {
+        return const_cast<Entry*>(foundEntry)->value;
+    }
+    return badKeyDrain;
+}
+
+/**
+ * @brief Getter for number of slots of the frozen hash table.
+ *
+ * @return capacity of frozen hash table (about size / LOAD_FACTOR).
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t FrozenHashTable_t<K, V, Hash, Eq>::capacity() const {
+    return slots.size();
+}
+
+/**
+ * @brief Getter for size of the frozen hash table.
+ *
+ * @return number of key-value pairs, including any in overflow.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t FrozenHashTable_t<K, V, Hash, Eq>::size() const {
+    return numFilled;
+}
+
+/**
+ * @brief Getter for the load factor of the frozen hash table.
+ *
+ * @return ratio of size to capacity.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+double FrozenHashTable_t<K, V, Hash, Eq>::alpha() const {
+    return static_cast<double>(size())/static_cast<double>(capacity());
+}
+
+/**
+ * @brief Getter for a list of keys stored in the frozen hash table.
+ *
+ * @warning ArenaString keys view the arena of the table, so the list is invalidated once the table is destroyed.
+ * @return vector of keys present in the table, in slot order followed by any overflow.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+std::vector<K> FrozenHashTable_t<K, V, Hash, Eq>::keys() const {
+    std::vector<K> keyList;
+    keyList.reserve(numFilled);
+    for (size_t slot = 0; slot < slots.size(); ++slot) {
+        if (ControlByte::isFull(control[slot])) {
+            keyList.push_back(slots[slot].key);
+        }
+    }
+    for (const Entry& entry : overflow) {
+        keyList.push_back(entry.key);
+    }
+    return keyList;
+}
+
+/**
+ * @brief Getter for value stored using a given key.
+ *
+ * Examines the one slot the key can occupy.
+ *
+ * @param key Key to be searched.
+ * @return value associated with key or nullopt.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+std::optional<V> FrozenHashTable_t<K, V, Hash, Eq>::get(const KeyArg key) const {
+    if (const Entry* foundEntry = find(key, keyHash(key))) {
+        return foundEntry->value;
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Predicate for if a given key is stored in table.
+ *
+ * @param key Key to be searched.
+ * @return true if key found, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool FrozenHashTable_t<K, V, Hash, Eq>::contains(const KeyArg key) const {
+    return find(key, keyHash(key)) != nullptr;
+}
+
+/**
+ * @brief Getter for values stored using a batch of keys.
+ *
+ * Batched version of get, prefetching the slot of the key PREFETCH_DISTANCE places ahead (see HashTable_t::get_many).
+ *
+ * @warning Only as many keys as values has room for are looked up.
+ *
+ * @param keys Keys to be searched.
+ * @param values Receives the value associated with each key, or nullopt.
+ * @return number of keys found.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t FrozenHashTable_t<K, V, Hash, Eq>::get_many(std::span<const LookupKey> keys, const std::span<std::optional<V>> values) const {
+    keys = keys.first(std::min(keys.size(), values.size()));
+    std::vector<uint64_t> hashValues(keys.size());
+    std::transform(keys.begin(), keys.end(), hashValues.begin(), [this](const LookupKey& key) { return keyHash(key); });
+    size_t numFound = 0;
+    for (size_t keyNum = 0; keyNum < keys.size(); ++keyNum) {
+#if defined(__GNUC__) || defined(__clang__)
+        if (keyNum + PREFETCH_DISTANCE < keys.size()) {
+            const size_t slot = slotOf(hashValues[keyNum + PREFETCH_DISTANCE]);
+            __builtin_prefetch(control.data() + slot);
+            __builtin_prefetch(slots.data() + slot);
+        }
+#endif
+        if (const Entry* foundEntry = find(keys[keyNum], hashValues[keyNum])) {
+            values[keyNum] = foundEntry->value;
+            ++numFound;
+        }
+        else {
+            values[keyNum] = std::nullopt;
+        }
+    }
+    return numFound;
+}
+
+/**
+ * @brief Predicate for which of a batch of keys are stored in table.
+ *
+ * Batched version of contains, prefetching like get_many.
+ *
+ * @warning Only as many keys as results has room for are looked up.
+ *
+ * @param keys Keys to be searched.
+ * @param results Receives true for each key found, false otherwise.
+ * @return number of keys found.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t FrozenHashTable_t<K, V, Hash, Eq>::contains_many(std::span<const LookupKey> keys, const std::span<bool> results) const {
+    keys = keys.first(std::min(keys.size(), results.size()));
+    std::vector<uint64_t> hashValues(keys.size());
+    std::transform(keys.begin(), keys.end(), hashValues.begin(), [this](const LookupKey& key) { return keyHash(key); });
+    size_t numFound = 0;
+    for (size_t keyNum = 0; keyNum < keys.size(); ++keyNum) {
+#if defined(__GNUC__) || defined(__clang__)
+        if (keyNum + PREFETCH_DISTANCE < keys.size()) {
+            const size_t slot = slotOf(hashValues[keyNum + PREFETCH_DISTANCE]);
+            __builtin_prefetch(control.data() + slot);
+            __builtin_prefetch(slots.data() + slot);
+        }
+#endif
+        results[keyNum] = find(keys[keyNum], hashValues[keyNum]) != nullptr;
+        numFound += results[keyNum];
+    }
+    return numFound;
+}
+
+/**
+ * @brief Scrambles the bits of a 64-bit value.
+ *
+ * The finalizer of MurmurHash3, so that keys with weak hashes (such as integers under std::hash) are spread
+ * over buckets and slots as well as keys with strong ones.
+ *
+ * @param value value to be mixed
+ * @return mixed value.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+uint64_t FrozenHashTable_t<K, V, Hash, Eq>::mix(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDULL;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+/**
+ * @brief Maps a 64-bit value onto [0, range).
+ *
+ * Lemire's multiply-shift reduction (fastrange), using the high bits of value.
+ *
+ * @param value value to be reduced
+ * @param range number of possible results
+ * @return value scaled to [0, range).
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t FrozenHashTable_t<K, V, Hash, Eq>::reduce(const uint64_t value, const size_t range) {
+    return static_cast<size_t>(mulhi64(value, range));
+}
+
+/**
+ * @brief Mixed hash of a key.
+ *
+ * @param key key to be hashed
+ * @return hash of key, mixed.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+uint64_t FrozenHashTable_t<K, V, Hash, Eq>::keyHash(const KeyArg key) const {
+    return mix(static_cast<uint64_t>(hash(key)));
+}
+
+/**
+ * @brief Slot of a key with given mixed hash.
+ *
+ * @param mixedHash mixed hash of key
+ * @return index of the only slot the key can occupy.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t FrozenHashTable_t<K, V, Hash, Eq>::slotOf(const uint64_t mixedHash) const {
+    return slotOf(mixedHash, pilots[reduce(mixedHash, pilots.size())]);
+}
+
+/**
+ * @brief Slot of a key with given mixed hash under a given pilot.
+ *
+ * The bucket of a key is chosen by the high bits of its mixed hash; the slot by the hash mixed again with the pilot,
+ * so that different pilots send the keys of a bucket to independent slots.
+ *
+ * @param mixedHash mixed hash of key
+ * @param pilot pilot value of the key's bucket
+ * @return index of slot.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t FrozenHashTable_t<K, V, Hash, Eq>::slotOf(const uint64_t mixedHash, const uint32_t pilot) const {
+    return reduce(mix(mixedHash ^ (static_cast<uint64_t>(pilot) * 0x9E3779B97F4A7C15ULL)), slots.size());
+}
+
+/**
+ * @brief Find entry holding key.
+ *
+ * Private helper for lookups. Compares the fingerprint in the key's slot, then the key itself;
+ * only if that fails and the overflow list is not empty is the list searched.
+ *
+ * @param key Key to be searched.
+ * @param mixedHash mixed hash of key
+ * @return Pointer to found entry, or nullptr.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+const typename FrozenHashTable_t<K, V, Hash, Eq>::Entry* FrozenHashTable_t<K, V, Hash, Eq>::find(const KeyArg key, const uint64_t mixedHash) const {
+    if (const size_t slot = slotOf(mixedHash); control[slot] == ControlByte::fingerprint(mixedHash) && equal(slots[slot].key, key)) {
+        return &slots[slot];
+    }
+    for (const Entry& entry : overflow) {
+        if (equal(entry.key, key)) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Builds the perfect hash function and places every pair.
+ *
+ * Keys are grouped into buckets by the high bits of their mixed hash (a counting sort), and the buckets are
+ * placed in decreasing order of size, while many slots are still free. For each bucket, pilots 0, 1, 2, ... are tried
+ * until every key of the bucket lands in a distinct free slot; the slots are claimed as they are checked,
+ * and released again if a later key of the bucket collides. Keys sharing a mixed hash with another key of their bucket,
+ * and buckets for which no pilot below MAX_PILOT works, are moved to the overflow list.
+ *
+ * @param pairs key-value pairs to be stored
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void FrozenHashTable_t<K, V, Hash, Eq>::build(std::vector<std::pair<K, V>> pairs) {
+    numFilled = pairs.size();
+    const auto numSlots = std::max(static_cast<size_t>(std::ceil(static_cast<double>(numFilled) / LOAD_FACTOR)), static_cast<size_t>(1));
+    const auto numBuckets = std::max(static_cast<size_t>(std::ceil(static_cast<double>(numFilled) / KEYS_PER_BUCKET)), static_cast<size_t>(1));
+    control.assign(numSlots, ControlByte::ESS);
+    slots.resize(numSlots);
+    pilots.assign(numBuckets, 0);
+
+    std::vector<uint64_t> hashValues(numFilled);
+    std::vector<size_t> bucketStart(numBuckets + 1, 0); // Start of each bucket's keys in byBucket.
+    for (size_t pairNum = 0; pairNum < numFilled; ++pairNum) {
+        hashValues[pairNum] = keyHash(pairs[pairNum].first);
+        ++bucketStart[reduce(hashValues[pairNum], numBuckets) + 1];
+    }
+    size_t maxBucketSize = 0;
+    for (size_t bucketNum = 0; bucketNum < numBuckets; ++bucketNum) {
+        maxBucketSize = std::max(maxBucketSize, bucketStart[bucketNum + 1]);
+        bucketStart[bucketNum + 1] += bucketStart[bucketNum];
+    }
+    std::vector<size_t> byBucket(numFilled); // Indices of pairs, grouped by bucket.
+    {
+        std::vector<size_t> next(bucketStart.begin(), bucketStart.end() - 1);
+        for (size_t pairNum = 0; pairNum < numFilled; ++pairNum) {
+            byBucket[next[reduce(hashValues[pairNum], numBuckets)]++] = pairNum;
+        }
+    }
+    std::vector<std::vector<size_t>> bucketsBySize(maxBucketSize + 1); // Buckets of every size.
+    for (size_t bucketNum = 0; bucketNum < numBuckets; ++bucketNum) {
+        bucketsBySize[bucketStart[bucketNum + 1] - bucketStart[bucketNum]].push_back(bucketNum);
+    }
+
+    std::vector<size_t> bucketSlots(maxBucketSize); // Slots claimed by the keys of the bucket being placed.
+    const auto moveToOverflow = [&](const size_t pairNum) {
+        overflow.push_back(Entry{std::move(pairs[pairNum].first), pairs[pairNum].second});
+    };
+    for (size_t bucketSize = maxBucketSize; bucketSize > 0; --bucketSize) {
+        for (const size_t bucketNum : bucketsBySize[bucketSize]) {
+            std::span<size_t> members(byBucket.data() + bucketStart[bucketNum], bucketSize);
+            std::sort(members.begin(), members.end(), [&](const size_t a, const size_t b) { return hashValues[a] < hashValues[b]; });
+            // Keys whose mixed hash equals another's would always share a slot.
+            const auto unique = std::unique(members.begin(), members.end(), [&](const size_t a, const size_t b) { return hashValues[a] == hashValues[b]; });
+            for (auto duplicate = unique; duplicate != members.end(); ++duplicate) {
+                moveToOverflow(*duplicate);
+            }
+            members = members.first(static_cast<size_t>(unique - members.begin()));
+            bool placed = false;
+            for (uint32_t pilot = 0; pilot < MAX_PILOT && !placed; ++pilot) {
+                size_t numClaimed = 0;
+                for (; numClaimed < members.size(); ++numClaimed) {
+                    const size_t slot = slotOf(hashValues[members[numClaimed]], pilot);
+                    if (control[slot] != ControlByte::ESS) {
+                        break;
+                    }
+                    control[slot] = ControlByte::fingerprint(hashValues[members[numClaimed]]);
+                    bucketSlots[numClaimed] = slot;
+                }
+                placed = numClaimed == members.size();
+                if (placed) {
+                    pilots[bucketNum] = pilot;
+                }
+                else {
+                    for (size_t claimed = 0; claimed < numClaimed; ++claimed) { // Release the slots claimed under this pilot.
+                        control[bucketSlots[claimed]] = ControlByte::ESS;
+                    }
+                }
+            }
+            for (size_t memberNum = 0; memberNum < members.size(); ++memberNum) {
+                if (placed) {
+                    slots[bucketSlots[memberNum]] = Entry{std::move(pairs[members[memberNum]].first), pairs[members[memberNum]].second};
+                }
+                else {
+                    moveToOverflow(members[memberNum]);
+                }
+            }
+        }
+    }
+    if constexpr (arenaKeys) { // Keys still view the arena of the table they were copied from.
+        for (size_t slot = 0; slot < slots.size(); ++slot) {
+            if (ControlByte::isFull(control[slot])) {
+                slots[slot].key = keyArena.store(slots[slot].key);
+            }
+        }
+        for (Entry& entry : overflow) {
+            entry.key = keyArena.store(entry.key);
+        }
+    }
+}
+
+#endif // FROZENHASHTABLE_H
@@ -0,0 +1,596 @@
+/*
+ * Greg Rosen
+ * Project 4: HashTable
+ * Wall-clock benchmarks for hash table
+ */
+
+#include "FilteredHashTable.h"
+#include "HashTable.h"
+#include "Hashers.h"
+#include "HopscotchHashTable.h"
+#include "RobinHoodHashTable.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <random>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+/*
+ * Every benchmark is run against HashTable, ArenaHashTable, RobinHoodHashTable, HopscotchHashTable,
+ * and std::unordered_map<std::string, size_t>, with the same keys and the same sequence of operations. Results are reported as wall-clock nanoseconds per operation,
+ * taking the fastest of NUM_REPEATS runs to filter out scheduling noise.
+ * Key generation and operation sequences are prepared before timing starts, so only table operations are measured.
+ *
+ * The seeded hash functions of Hashers.h are compared with std::hash on each key-length distribution, both hashing alone
+ * and as the hash function of a HashTable.
+ *
+ * The prefilter section compares hits and misses of HashTable with and without a cuckoo filter in front (FilteredHashTable).
+ * HashTableBenchHardened runs the same benchmarks with HASHTABLE_HARDENED defined (see BucketAccess.h),
+ * so the cost of bounds-checked bucket access is the difference between the two.
+ *
+ * Usage: HashTableBench [quick]
+ * The quick argument runs every benchmark at small sizes, as a smoke test.
+ */
+
+using StdMap = std::unordered_map<std::string, size_t>;
+
+/**
+ * @struct KeyLengths
+ * @brief Distribution of key lengths, uniform between a minimum and maximum.
+ */
+struct KeyLengths {
+    const char* name; // Name reported with results.
+    size_t minLength; // Shortest key length (at least KEY_INDEX_CHARS).
+    size_t maxLength; // Longest key length.
+};
+
+/**
+ * @class ZipfDistribution
+ * @brief Zipfian distribution over the ranks 0 to n-1, where rank r is drawn with probability proportional to 1/(r+1)^skew.
+ *
+ * A skew of 0 is the uniform distribution. Sampling is a binary search of the precomputed cumulative distribution.
+ */
+class ZipfDistribution {
+private:
+    std::vector<double> cumulative; // Cumulative probability of each rank.
+
+public:
+    ZipfDistribution(size_t n, double skew); // Constructor for ZipfDistribution.
+    size_t operator()(std::mt19937_64& rngEngine) const; // Draws a rank.
+};
+
+/**
+ * @struct Workload
+ * @brief Keys and lookup sequences shared by every engine in one benchmark configuration.
+ */
+struct Workload {
+    std::vector<std::string> keys; // Keys inserted into the table.
+    std::vector<std::string> missKeys; // Keys never inserted into the table.
+    std::vector<size_t> hitOrder; // Indices into keys of successful lookups, in lookup order.
+};
+
+constexpr size_t NUM_REPEATS = 3; // Number of runs of each benchmark; the fastest is reported.
+constexpr size_t MIN_OPERATIONS = static_cast<size_t>(1) << 20; // Smallest number of lookups or mixed operations timed per run.
+constexpr size_t QUICK_MIN_OPERATIONS = static_cast<size_t>(1) << 14; // Smallest number of operations timed per quick run.
+constexpr size_t KEY_INDEX_CHARS = 4; // Number of leading characters of each key encoding its index, keeping keys distinct.
+constexpr size_t BATCH_SIZE = 64; // Number of keys per call to contains_many.
+
+volatile size_t benchSink; // Receives results of timed operations, so they are not optimized away.
+
+/**
+ * @brief Prints one result line.
+ *
+ * @param benchmark name of operation measured
+ * @param params description of benchmark configuration
+ * @param engine name of table measured
+ * @param nsPerOp nanoseconds per operation
+ */
+void report(const std::string& benchmark, const std::string& params, const std::string& engine, const double nsPerOp) {
+    std::cout << std::left << std::setw(12) << benchmark << std::setw(34) << params << std::setw(22) << engine
+              << std::right << std::fixed << std::setprecision(1) << std::setw(10) << nsPerOp << " ns/op" << std::endl;
+}
+
+/**
+ * @brief Times a function, returning the fastest of NUM_REPEATS runs.
+ *
+ * @param setup function run untimed before each run
+ * @param run function timed
+ * @return fastest run time in nanoseconds.
+ */
+double bestOf(const std::function<void()>& setup, const std::function<void()>& run) {
+    double best = std::numeric_limits<double>::max();
+    for (size_t repeat = 0; repeat < NUM_REPEATS; ++repeat) {
+        setup();
+        const auto start = std::chrono::steady_clock::now();
+        run();
+        const auto stop = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::nano>(stop - start).count());
+    }
+    return best;
+}
+
+/**
+ * @brief Getter for the resident set size of this process.
+ *
+ * @return resident bytes, or 0 if not available on this platform.
+ */
+size_t residentBytes() {
+#if defined(__linux__)
+    std::ifstream statm("/proc/self/statm");
+    size_t totalPages = 0;
+    size_t residentPages = 0;
+    if (statm >> totalPages >> residentPages) {
+        return residentPages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    }
+#endif
+    return 0;
+}
+
+/**
+ * @brief Returns freed heap memory to the operating system where possible, so resident set sizes can be compared.
+ */
+void releaseFreedMemory() {
+#if defined(__GLIBC__)
+    malloc_trim(0);
+#endif
+}
+
+/**
+ * @brief Creates a random key with a distinct index.
+ *
+ * The first KEY_INDEX_CHARS characters encode the index, so keys with different indices never collide,
+ * and the remaining characters are random printable ASCII.
+ *
+ * @param index index encoded in key
+ * @param lengths distribution of key length
+ * @param rngEngine random engine
+ * @return random key.
+ */
+std::string makeKey(size_t index, const KeyLengths& lengths, std::mt19937_64& rngEngine) {
+    std::uniform_int_distribution<size_t> lengthDist(lengths.minLength, lengths.maxLength);
+    std::uniform_int_distribution<int> characterDist('!', '~');
+    std::string key(lengthDist(rngEngine), ' ');
+    for (char& character : key) {
+        character = static_cast<char>(characterDist(rngEngine));
+    }
+    constexpr size_t radix = '~' - '!' + 1;
+    for (size_t position = 0; position < KEY_INDEX_CHARS; ++position, index /= radix) {
+        key[position] = static_cast<char>('!' + index % radix);
+    }
+    return key;
+}
+
+/**
+ * @brief Constructor for ZipfDistribution.
+ *
+ * @param n number of ranks
+ * @param skew Zipfian exponent (0 for uniform)
+ */
+ZipfDistribution::ZipfDistribution(const size_t n, const double skew) : cumulative(n) {
+    double total = 0.0;
+    for (size_t rank = 0; rank < n; ++rank) {
+        total += 1.0 / std::pow(static_cast<double>(rank + 1), skew);
+        cumulative[rank] = total;
+    }
+    for (double& probability : cumulative) {
+        probability /= total;
+    }
+}
+
+/**
+ * @brief Draws a rank.
+ *
+ * @param rngEngine random engine
+ * @return rank between 0 and n-1.
+ */
+size_t ZipfDistribution::operator()(std::mt19937_64& rngEngine) const {
+    const double draw = std::uniform_real_distribution<double>(0.0, 1.0)(rngEngine);
+    const auto rank = std::lower_bound(cumulative.begin(), cumulative.end(), draw);
+    return std::min(static_cast<size_t>(rank - cumulative.begin()), cumulative.size() - 1);
+}
+
+/**
+ * @brief Creates the keys and lookup sequence for a benchmark configuration.
+ *
+ * @param numKeys number of keys inserted
+ * @param lengths distribution of key length
+ * @param skew Zipfian skew of successful lookups (0 for uniform)
+ * @param minOperations smallest number of lookups in the lookup sequence
+ * @return workload shared by all engines.
+ */
+Workload makeWorkload(const size_t numKeys, const KeyLengths& lengths, const double skew, const size_t minOperations) {
+    std::mt19937_64 rngEngine(numKeys);
+    Workload workload;
+    workload.keys.reserve(numKeys);
+    workload.missKeys.reserve(numKeys);
+    for (size_t index = 0; index < numKeys; ++index) {
+        workload.keys.push_back(makeKey(index, lengths, rngEngine));
+        workload.missKeys.push_back(makeKey(numKeys + index, lengths, rngEngine));
+    }
+    const ZipfDistribution rankDist(numKeys, skew);
+    workload.hitOrder.resize(std::max(numKeys, minOperations));
+    for (size_t& index : workload.hitOrder) {
+        index = rankDist(rngEngine);
+    }
+    return workload;
+}
+
+/**
+ * @brief Creates an empty table of the given engine.
+ *
+ * @param capacity initial number of buckets (0 for the engine's default)
+ * @param maxLoad load factor above which the table grows
+ * @return empty table.
+ */
+template<typename Table>
+Table makeTable(const size_t capacity, const double maxLoad) {
+    if constexpr (std::is_same_v<Table, StdMap>) {
+        Table table;
+        table.max_load_factor(static_cast<float>(maxLoad));
+        table.rehash(capacity);
+        return table;
+    }
+    else {
+        return capacity == 0 ? Table() : Table(capacity, maxLoad);
+    }
+}
+
+/**
+ * @brief Predicate for if a key is stored in a table of the given engine.
+ *
+ * @param table table searched
+ * @param key key searched for
+ * @return true if key is present.
+ */
+template<typename Table>
+bool tableContains(Table& table, const std::string& key) {
+    if constexpr (std::is_same_v<Table, StdMap>) {
+        return table.find(key) != table.end();
+    }
+    else {
+        return table.contains(key);
+    }
+}
+
+/**
+ * @brief Removes a key from a table of the given engine.
+ *
+ * @param table table modified
+ * @param key key removed
+ * @return true if key was present.
+ */
+template<typename Table>
+bool tableRemove(Table& table, const std::string& key) {
+    if constexpr (std::is_same_v<Table, StdMap>) {
+        return table.erase(key) != 0;
+    }
+    else {
+        return table.remove(key);
+    }
+}
+
+/**
+ * @brief Inserts a key-value pair into a table of the given engine.
+ *
+ * @param table table modified
+ * @param key key inserted
+ * @param value value inserted
+ * @return true if key was absent.
+ */
+template<typename Table>
+bool tableInsert(Table& table, const std::string& key, const size_t value) {
+    if constexpr (std::is_same_v<Table, StdMap>) {
+        return table.emplace(key, value).second;
+    }
+    else {
+        return table.insert(key, value);
+    }
+}
+
+/**
+ * @brief Inserts every key of a workload into a table of the given engine.
+ *
+ * @param table table filled
+ * @param keys keys inserted, with their index as value
+ */
+template<typename Table>
+void fillTable(Table& table, const std::vector<std::string>& keys) {
+    for (size_t index = 0; index < keys.size(); ++index) {
+        tableInsert(table, keys[index], index);
+    }
+}
+
+/**
+ * @brief Benchmarks insertion into a growing table, removal of every key, and a rehash to four times the size.
+ *
+ * @param engine name of table measured
+ * @param params description of benchmark configuration
+ * @param workload keys used
+ */
+template<typename Table>
+void benchGrowth(const std::string& engine, const std::string& params, const Workload& workload) {
+    const std::vector<std::string>& keys = workload.keys;
+    const double numKeys = static_cast<double>(keys.size());
+    std::optional<Table> table; // Tables are not assignable, so each run emplaces a new one.
+    const auto reset = [&] { table.reset(); table.emplace(makeTable<Table>(0, 0.5)); };
+    const auto refill = [&] { reset(); fillTable(*table, keys); };
+    report("insert", params, engine, bestOf(reset, [&] { fillTable(*table, keys); }) / numKeys);
+    report("rehash", params, engine, bestOf(refill, [&] { table->reserve(4 * keys.size()); }) / numKeys);
+    report("remove", params, engine, bestOf(refill, [&] {
+        size_t numRemoved = 0;
+        for (const std::string& key : keys) {
+            numRemoved += tableRemove(*table, key);
+        }
+        benchSink = numRemoved;
+    }) / numKeys);
+}
+
+/**
+ * @brief Benchmarks successful and unsuccessful lookups in a table filled to a given load factor.
+ *
+ * For engines offering contains_many, successful lookups are also measured through it in batches of BATCH_SIZE.
+ *
+ * @param engine name of table measured
+ * @param params description of benchmark configuration
+ * @param workload keys and lookup sequence used
+ * @param capacity number of buckets, fixed for the benchmark
+ * @param loadFactor fraction of buckets filled
+ */
+template<typename Table>
+void benchLookup(const std::string& engine, const std::string& params, const Workload& workload, const size_t capacity, const double loadFactor) {
+    double maxLoad = std::min(loadFactor + 0.05, 1.0); // Never reached, so the table keeps its capacity.
+    if constexpr (std::is_same_v<Table, StdMap>) {
+        maxLoad = 1.0; // Buckets of std::unordered_map are chains, so its load factor is not comparable.
+    }
+    Table table = makeTable<Table>(capacity, maxLoad);
+    fillTable(table, workload.keys);
+    const double numLookups = static_cast<double>(workload.hitOrder.size());
+    const auto none = [] {};
+    report("hit", params, engine, bestOf(none, [&] {
+        size_t numFound = 0;
+        for (const size_t index : workload.hitOrder) {
+            numFound += tableContains(table, workload.keys[index]);
+        }
+        benchSink = numFound;
+    }) / numLookups);
+    report("miss", params, engine, bestOf(none, [&] {
+        size_t numFound = 0;
+        for (size_t lookup = 0; lookup < workload.hitOrder.size(); ++lookup) {
+            numFound += tableContains(table, workload.missKeys[lookup % workload.missKeys.size()]);
+        }
+        benchSink = numFound;
+    }) / numLookups);
+    if constexpr (requires (std::span<const std::string_view> batch, bool* results) { table.contains_many(batch, results); }) {
+        std::vector<std::string_view> hitKeys;
+        hitKeys.reserve(workload.hitOrder.size());
+        for (const size_t index : workload.hitOrder) {
+            hitKeys.emplace_back(workload.keys[index]);
+        }
+        report("hit", params, engine + " batched", bestOf(none, [&] {
+            bool results[BATCH_SIZE];
+            size_t numFound = 0;
+            for (size_t first = 0; first < hitKeys.size(); first += BATCH_SIZE) {
+                const std::span<const std::string_view> batch(hitKeys.data() + first, std::min(BATCH_SIZE, hitKeys.size() - first));
+                numFound += table.contains_many(batch, results);
+            }
+            benchSink = numFound;
+        }) / numLookups);
+    }
+}
+
+/**
+ * @brief Benchmarks a mixed workload of 80% lookups, 10% insertions, and 10% removals.
+ *
+ * Operations draw keys from the inserted and never-inserted keys with Zipfian skew, so about half of them hit
+ * and the table stays near its initial size. As many operations are timed as the workload has lookups.
+ *
+ * @param engine name of table measured
+ * @param params description of benchmark configuration
+ * @param workload keys used
+ * @param skew Zipfian skew of the keys operated on
+ */
+template<typename Table>
+void benchMixed(const std::string& engine, const std::string& params, const Workload& workload, const double skew) {
+    const size_t numKeys = workload.keys.size();
+    std::mt19937_64 rngEngine(numKeys + 1);
+    const ZipfDistribution rankDist(2 * numKeys, skew);
+    std::uniform_int_distribution<int> operationDist(0, 9);
+    std::vector<std::pair<int, const std::string*>> operations(workload.hitOrder.size());
+    for (auto& [operation, key] : operations) {
+        const size_t rank = rankDist(rngEngine);
+        operation = operationDist(rngEngine);
+        key = rank % 2 == 0 ? &workload.keys[rank / 2] : &workload.missKeys[rank / 2];
+    }
+    std::optional<Table> table;
+    const auto refill = [&] { table.reset(); table.emplace(makeTable<Table>(0, 0.5)); fillTable(*table, workload.keys); };
+    report("mixed", params, engine, bestOf(refill, [&] {
+        size_t numSucceeded = 0;
+        for (const auto& [operation, key] : operations) {
+            if (operation == 0) {
+                numSucceeded += tableInsert(*table, *key, 0);
+            }
+            else if (operation == 1) {
+                numSucceeded += tableRemove(*table, *key);
+            }
+            else {
+                numSucceeded += tableContains(*table, *key);
+            }
+        }
+        benchSink = numSucceeded;
+    }) / static_cast<double>(operations.size()));
+}
+
+/**
+ * @brief Reports the growth in resident set size from filling a table of the given engine.
+ *
+ * @param engine name of table measured
+ * @param params description of benchmark configuration
+ * @param keys keys inserted
+ */
+template<typename Table>
+void benchMemory(const std::string& engine, const std::string& params, const std::vector<std::string>& keys) {
+    releaseFreedMemory();
+    const size_t before = residentBytes();
+    {
+        Table table = makeTable<Table>(0, 0.5);
+        fillTable(table, keys);
+        const size_t after = residentBytes();
+        std::cout << std::left << std::setw(12) << "rss" << std::setw(34) << params << std::setw(22) << engine << std::right;
+        if (after == 0) {
+            std::cout << std::setw(10) << "n/a" << std::endl;
+        }
+        else {
+            const double grown = static_cast<double>(after > before ? after - before : 0);
+            std::cout << std::fixed << std::setprecision(1) << std::setw(10) << grown / (1024.0 * 1024.0) << " MiB  ("
+                      << grown / static_cast<double>(keys.size()) << " bytes/key)" << std::endl;
+        }
+    }
+    releaseFreedMemory();
+}
+
+/**
+ * @brief Benchmarks a hash function alone, and lookups in a HashTable using it.
+ *
+ * Hashing is timed over the successful lookup sequence, so it is measured on the same keys as the lookups.
+ *
+ * @param hasherName name of hash function measured
+ * @param params description of benchmark configuration
+ * @param workload keys and lookup sequence used
+ * @param capacity number of buckets, fixed for the lookups
+ */
+template<typename Hasher>
+void benchHasher(const std::string& hasherName, const std::string& params, const Workload& workload, const size_t capacity) {
+    const Hasher hasher = makeHash<Hasher>();
+    const auto none = [] {};
+    report("hash", params, hasherName, bestOf(none, [&] {
+        size_t combined = 0;
+        for (const size_t index : workload.hitOrder) {
+            combined ^= hasher(std::string_view(workload.keys[index]));
+        }
+        benchSink = combined;
+    }) / static_cast<double>(workload.hitOrder.size()));
+    benchLookup<HashTable_t<std::string, size_t, Hasher>>("HashTable<" + hasherName + ">", params, workload, capacity, 0.5);
+}
+
+/**
+ * @brief Runs a benchmark against every hash function.
+ *
+ * @param benchmark benchmark function template, called with each hash function's type and name
+ */
+template<typename Benchmark>
+void forEachHasher(const Benchmark& benchmark) {
+    benchmark.template operator()<std::hash<std::string_view>>("std::hash");
+    benchmark.template operator()<WyHash>("WyHash");
+    benchmark.template operator()<XXHash64>("XXHash64");
+    benchmark.template operator()<AesHash>(AesHash::HARDWARE_ACCELERATED ? "AesHash" : "AesHash (fallback)");
+}
+
+/**
+ * @brief Runs a benchmark against every engine.
+ *
+ * @param benchmark benchmark function template, called with each engine's table type and name
+ */
+template<typename Benchmark>
+void forEachEngine(const Benchmark& benchmark) {
+    benchmark.template operator()<HashTable>("HashTable");
+    benchmark.template operator()<ArenaHashTable>("ArenaHashTable");
+    benchmark.template operator()<RobinHoodHashTable>("RobinHoodHashTable");
+    benchmark.template operator()<HopscotchHashTable>("HopscotchHashTable");
+    benchmark.template operator()<StdMap>("std::unordered_map");
+}
+
+int main(int argc, char* argv[]) {
+    const bool quick = argc > 1 && std::strcmp(argv[1], "quick") == 0;
+    const size_t minOperations = quick ? QUICK_MIN_OPERATIONS : MIN_OPERATIONS;
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(__OPTIMIZE__)
+    std::cout << "WARNING: benchmarks built without optimization; configure with -DCMAKE_BUILD_TYPE=Release." << std::endl;
+#endif
+    std::cout << "Bucket access: " << (HASHTABLE_CHECKED ? "hardened (bounds checked)" : "fast (unchecked)") << std::endl;
+    const std::vector<size_t> sizes = quick ? std::vector<size_t>{1 << 10, 1 << 12} : std::vector<size_t>{1 << 12, 1 << 16, 1 << 20};
+    const std::vector<double> loadFactors = {0.25, 0.5, 0.75, 0.875};
+    const std::vector<double> skews = {0.0, 0.8, 0.99, 1.2};
+    const std::vector<KeyLengths> keyLengths = {{"short", 8, 8}, {"medium", 24, 24}, {"long", 64, 64}, {"mixed", 4, 96}};
+    const KeyLengths& defaultLengths = keyLengths[1];
+
+    std::cout << "____MEMORY____" << std::endl;
+    {
+        const Workload workload = makeWorkload(sizes.back(), defaultLengths, 0.0, minOperations);
+        const std::string params = "keys=" + std::to_string(sizes.back()) + " len=" + defaultLengths.name;
+        forEachEngine([&]<typename Table>(const std::string& engine) { benchMemory<Table>(engine, params, workload.keys); });
+    }
+
+    std::cout << "____INSERT / REHASH / REMOVE____" << std::endl;
+    for (const KeyLengths& lengths : keyLengths) {
+        for (const size_t numKeys : sizes) {
+            const Workload workload = makeWorkload(numKeys, lengths, 0.0, minOperations);
+            const std::string params = "keys=" + std::to_string(numKeys) + " len=" + lengths.name;
+            forEachEngine([&]<typename Table>(const std::string& engine) { benchGrowth<Table>(engine, params, workload); });
+        }
+    }
+
+    std::cout << "____LOOKUP (capacity, load factor, key length)____" << std::endl;
+    for (const size_t capacity : sizes) {
+        for (const double loadFactor : loadFactors) {
+            for (const KeyLengths& lengths : keyLengths) {
+                const Workload workload = makeWorkload(static_cast<size_t>(loadFactor * static_cast<double>(capacity)), lengths, 0.0, minOperations);
+                std::ostringstream params;
+                params << "cap=" << capacity << " alpha=" << std::setprecision(3) << loadFactor << " len=" << lengths.name;
+                forEachEngine([&]<typename Table>(const std::string& engine) {
+                    benchLookup<Table>(engine, params.str(), workload, capacity, loadFactor);
+                });
+            }
+        }
+    }
+
+    std::cout << "____HASH FUNCTIONS (key length)____" << std::endl;
+    for (const KeyLengths& lengths : keyLengths) {
+        const size_t capacity = sizes.back();
+        const Workload workload = makeWorkload(capacity / 2, lengths, 0.0, minOperations);
+        const std::string params = "cap=" + std::to_string(capacity) + " alpha=0.5 len=" + lengths.name;
+        forEachHasher([&]<typename Hasher>(const std::string& hasherName) { benchHasher<Hasher>(hasherName, params, workload, capacity); });
+    }
+
+    std::cout << "____PREFILTER (cuckoo filter in front of HashTable)____" << std::endl;
+    for (const double loadFactor : loadFactors) {
+        const size_t capacity = sizes.back();
+        const Workload workload = makeWorkload(static_cast<size_t>(loadFactor * static_cast<double>(capacity)), defaultLengths, 0.0, minOperations);
+        std::ostringstream params;
+        params << "cap=" << capacity << " alpha=" << std::setprecision(3) << loadFactor << " len=" << defaultLengths.name;
+        benchLookup<HashTable>("HashTable", params.str(), workload, capacity, loadFactor);
+        benchLookup<FilteredHashTable>("FilteredHashTable", params.str(), workload, capacity, loadFactor);
+    }
+
+    std::cout << "____LOOKUP / MIXED (Zipfian skew)____" << std::endl;
+    for (const double skew : skews) {
+        const size_t capacity = sizes.back();
+        const Workload workload = makeWorkload(capacity / 2, defaultLengths, skew, minOperations);
+        std::ostringstream params;
+        params << "cap=" << capacity << " alpha=0.5 skew=" << std::setprecision(3) << skew;
+        forEachEngine([&]<typename Table>(const std::string& engine) {
+            benchLookup<Table>(engine, params.str(), workload, capacity, 0.5);
+            benchMixed<Table>(engine, params.str(), workload, skew);
+        });
+    }
+    return 0;
+}
@@ -5,17 +5,22 @@
  */
 
 #include "HashTable.h"
+#include "HopscotchHashTable.h"
+#include "RobinHoodHashTable.h"
 #include <iostream>
 #include <iomanip>
 
 void functionalityTest();
 void memLeakTest();
-void timeComplexityTest();
+template<typename Table>
+void timeComplexityTest(const std::string& engine);
 std::string makeRandomString(unsigned char length, std::uniform_int_distribution<char>& charDist, std::mt19937& rngEngine);
 
 int main() {
     functionalityTest();
-    timeComplexityTest();
+    timeComplexityTest<HashTable>("HashTable");
+    timeComplexityTest<RobinHoodHashTable>("RobinHoodHashTable");
+    timeComplexityTest<HopscotchHashTable>("HopscotchHashTable");
     // memLeakTest();
 }
 
@@ -50,6 +55,8 @@ void functionalityTest() {
 
     std::cout << "Does contains return true for key in table..." << (myTable.contains("seven") ? "yes" : "NO!!ERROR") << std::endl;
     std::cout << "Does contains return false for key NOT in table..." << (myTable.contains("blarg") ? "NO!!ERROR" : "yes") << std::endl;
+    constexpr std::string_view keyBuffer = "sevenths";
+    std::cout << "Does contains accept a string_view slice..." << (myTable.contains(keyBuffer.substr(0, 5)) ? "yes" : "NO!!ERROR") << std::endl;
     std::cout << "Does insert return false for key NOT in table..." << (myTable.insert("seven", 16) ? "NO!!ERROR" : "yes") << std::endl;
 
     myTable["four"] = 27;
@@ -153,36 +160,40 @@ void memLeakTest() {
 }
 
 /**
- * @brief Time complexity testing for HashTable.
+ * @brief Time complexity testing for a HashTable engine.
  *
+ * Run for HashTable and for each alternative collision resolution engine, whose insertTCT and removeTCT count probes alike.
  * For the given set of table capacities and load factors:
  * 1. A hash table is created and populated with enough random key-value pairs to raise its load factor to the given value.
  * 2. A number of additional random strings are created. Each is inserted and then immediately removed from the table.
  * 3. The number of probes necessary to both insert and remove each of the additional strings is tracked.
  * 4. An average is calculated for all insertions/removals for a given capacity/load factor combination.
  * 5. All such averages are reported.
+ *
+ * @param engine name of the engine tested, reported with the results
  */
-void timeComplexityTest() {
+template<typename Table>
+void timeComplexityTest(const std::string& engine) {
     constexpr unsigned char minLength = 5; // minimum random string length.
     constexpr unsigned char maxLength = 15; // maximum random string length.
     constexpr unsigned char numCapTested = 3; // Number of capacities tested. Must be modified if later array is modified.
     constexpr unsigned char numAlphaTested = 9; // Number of load factors tested. Must be modified if later array is modified.
     constexpr size_t numTests = 100; // Number of random strings to be tested for each capacity/load factor combination.
-    constexpr size_t capacitiesTested[numCapTested] = {10000, 100000, 1000000};
+    constexpr size_t capacitiesTested[numCapTested] = {16384, 131072, 1048576}; // Powers of two, so capacities are not rounded.
     constexpr double loadFactorsTested[numAlphaTested] = {0.1, 0.2,0.3,0.4,0.5,0.6,0.7,0.8,0.9};
     double results[numCapTested][numAlphaTested][2]; // Array to capture results.
     std::mt19937 rngEngine(std::random_device{}());
     std::uniform_int_distribution<char> characterDist('!','~'); // All ASCII letters and punctuation
     std::uniform_int_distribution<size_t> valueDist(0, std::numeric_limits<size_t>::max()); // All possible values for size_t
     std::uniform_int_distribution<unsigned char> lengthDist(minLength,maxLength);
-    std::cout << "Starting time complexity test..." << std::endl;
+    std::cout << "Starting time complexity test of " << engine << "..." << std::endl;
     for (unsigned char capInd = 0; capInd < numCapTested; ++capInd) {
         const size_t capacity = capacitiesTested[capInd];
         for (unsigned char alphaInd = 0; alphaInd < numAlphaTested; ++alphaInd) {
             const double alpha = loadFactorsTested[alphaInd];
             size_t insertNumAccesses[numTests];
             size_t removeNumAccesses[numTests];
-            HashTable table(capacity,1.0);
+            Table table(capacity,1.0);
             for (size_t fillCt = 0; fillCt < (alpha * capacity); ++fillCt) { // Fill hash table up to load factor
                 const unsigned char randLength = lengthDist(rngEngine);
                 std::string randKey = makeRandomString(randLength, characterDist, rngEngine);
@@ -208,7 +219,7 @@ void timeComplexityTest() {
         }
     }
     // Display results.
-    std::cout << "____RESULTS____" << std::endl;
+    std::cout << "____RESULTS (" << engine << ")____" << std::endl;
     for (unsigned char capInd = 0; capInd < numCapTested; ++capInd) {
         std::cout << "Capacity = " << capacitiesTested[capInd] << ": " << std::endl;
         std::cout << "   Alpha   Avg # Probes___" << std::endl;
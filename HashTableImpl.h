@@ -0,0 +1,2752 @@
+#ifndef HASHTABLEIMPL_H
+#define HASHTABLEIMPL_H
+
+/*
+ * Greg Rosen
+ * Project 4: HashTable
+ * Declaration and implementation of HashTable_t class template
+ */
+
+#include "BucketAccess.h"
+#include "ControlByte.h"
+#include "ControlGroup.h"
+#include "Hashers.h"
+#include "HashTableStats.h"
+#include "TableSnapshot.h"
+#include "KeyArena.h"
+#include "ProbeSequence.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @struct KeyTraits
+ * @brief Storage and lookup properties of a key type.
+ *
+ * lookup_type - Parameter type accepted by lookups (get, contains, remove, []).
+ * cacheHash - Whether buckets store the full hash of their key.
+ * arenaStorage - Whether the table copies key characters into a KeyArena it owns, rather than each key owning its storage.
+ * Trivially copyable keys (integers, fixed-size ids) are stored inline in the bucket with no cached hash,
+ * since comparing them directly is as cheap as comparing hashes. Other keys cache their hash.
+ */
+template<typename K>
+struct KeyTraits {
+    using lookup_type = const K&;
+    static constexpr bool cacheHash = !std::is_trivially_copyable_v<K>;
+    static constexpr bool arenaStorage = false;
+};
+
+/**
+ * @brief KeyTraits specialization for std::string.
+ *
+ * Lookups accept std::string_view, so std::string, std::string_view, and const char* keys
+ * are all probed without constructing a std::string.
+ */
+template<>
+struct KeyTraits<std::string> {
+    using lookup_type = std::string_view;
+    static constexpr bool cacheHash = true;
+    static constexpr bool arenaStorage = false;
+};
+
+/**
+ * @brief KeyTraits specialization for ArenaString.
+ *
+ * Lookups accept std::string_view like std::string keys. The hash is cached (as the key itself is only a view),
+ * so that comparing against a non-matching key rarely reads the arena.
+ */
+template<>
+struct KeyTraits<ArenaString> {
+    using lookup_type = std::string_view;
+    static constexpr bool cacheHash = true;
+    static constexpr bool arenaStorage = true;
+};
+
+/**
+ * @struct CachedHash
+ * @brief Full hash of a bucket's key, stored when KeyTraits<K>::cacheHash is true.
+ */
+template<bool Enabled>
+struct CachedHash {
+    size_t value = 0; // Full hash of key.
+};
+
+/**
+ * @brief CachedHash specialization for keys whose hash is not cached; occupies no storage.
+ */
+template<>
+struct CachedHash<false> {};
+
+/**
+ * @struct NoKeyArena
+ * @brief Stand-in for the KeyArena of a table whose keys own their storage; occupies no storage.
+ */
+struct NoKeyArena {
+    NoKeyArena() = default; // Default constructor for NoKeyArena.
+    explicit NoKeyArena(std::pmr::memory_resource*) {} // Accepts the memory resource a KeyArena would be given.
+};
+
+/**
+ * @brief Default hash function of HashTable_t.
+ *
+ * std::hash<K>, except for string keys (std::string and ArenaString), which are hashed as std::string_view
+ * (guaranteed by the standard to agree with std::hash<std::string>).
+ */
+template<typename K>
+using DefaultHash = std::conditional_t<std::is_same_v<typename KeyTraits<K>::lookup_type, std::string_view>, std::hash<std::string_view>, std::hash<K>>;
+
+/**
+ * @brief Default key equality predicate of HashTable_t.
+ *
+ * std::equal_to<K>, except for string keys (std::string and ArenaString), which use the transparent std::equal_to<>
+ * so that they can be compared against std::string_view lookup keys.
+ */
+template<typename K>
+using DefaultKeyEqual = std::conditional_t<std::is_same_v<typename KeyTraits<K>::lookup_type, std::string_view>, std::equal_to<>, std::equal_to<K>>;
+
+/**
+ * @concept PairIterator
+ * @brief Iterator whose elements are pair-like, with members first (key) and second (value).
+ *
+ * Keeps the range insert from capturing insert(key, value) calls whose arguments happen to be pointers.
+ */
+template<typename It>
+concept PairIterator = requires (std::iter_reference_t<It> element) {
+    element.first;
+    element.second;
+};
+
+/**
+ * @class HashTable_t
+ * @brief HashTable for <K, V> key-value pairs
+ *
+ * Hash Table implementation for keys of type K and values of type V.
+ * Hash Table is stored internally as two std::vectors: a dense array of one-byte bucket states with hash fingerprints
+ * (see ControlByte), and a parallel array of buckets holding keys and values.
+ * Both are allocated from a std::pmr::memory_resource (the default resource unless one is given), as is the key arena;
+ * with ArenaString keys, a table backed by a std::pmr::monotonic_buffer_resource allocates nothing from the global heap
+ * besides the bookkeeping of an incremental rehash. As with std::pmr containers, copies use the default resource.
+ * Uses Hash for the hash function (std::hash<K> by default) and Eq for key equality (std::equal_to<K> by default).
+ * Hash must accept, and Eq must compare K against, KeyTraits<K>::lookup_type.
+ * A seeded Hash (see SeededHash, and WyHash, XXHash64, and AesHash in Hashers.h) is given a random seed per table,
+ * drawn at construction like the probe parameters, so that clients cannot choose keys that collide.
+ * Uses pseudo-random probing for collision resolution by default. Linear, quadratic, and double hash probing may also be selected.
+ * Probe sequences are computed on the fly, so no per-bucket offset storage is required.
+ * When the capacity is a multiple of 16 (or less than 16), probing visits windows of 16 consecutive buckets,
+ * whose control bytes are compared at once with SIMD instructions (see ControlGroup);
+ * the probe sequence then selects the order of windows rather than of single buckets.
+ * Rehashes whenever load factor reaches or exceeds a provided threshold (defualt 0.5), at which point the table doubles in size.
+ * Capacities are rounded to powers of two by default so that buckets can be indexed with a bitmask.
+ * Removed buckets become tombstones unless no probe can pass through them, in which case they are reclaimed as ESS.
+ * Once tombstones make up a given fraction of the table (default 0.25), it is rehashed in place at the same capacity.
+ * Optionally, the table also shrinks once its load factor falls below a lower threshold.
+ * Rehashing moves every key-value pair at once by default. In incremental mode (nonzero migration step),
+ * the new bucket arrays replace the old ones immediately, and each later operation moves a bounded number
+ * of old buckets over; lookups check both arrays until the migration finishes.
+ * Rehashing a large table may instead be split across a configurable number of threads.
+ * With ArenaString keys, key characters are copied into an arena owned by the table (see KeyArena)
+ * instead of each key holding its own allocation; the arena is rebuilt, dropping removed keys, on every rehash.
+ * Tables with string or trivially copyable keys and trivially copyable values can be saved to a binary snapshot
+ * and loaded back in its exact bucket layout, without rehashing or reinserting (see TableSnapshot.h).
+ * Key-value pairs are visited in place, without copying keys or probing for them, by forward iterators (see BucketIterator),
+ * for_each, and chunked (resumable) or multithreaded visitors.
+ * When HASHTABLE_ENABLE_STATS is defined, probe lengths and rehashes are recorded and reported by stats();
+ * otherwise the counters take no storage and their updates compile away.
+ *
+ * @author Greg Rosen
+ * @date November 2, 2025
+ */
+template<typename K, typename V, typename Hash = DefaultHash<K>, typename Eq = DefaultKeyEqual<K>>
+class HashTable_t {
+public:
+    using ProbeMode = ::ProbeMode; // Collision resolution strategy, see ProbeSequence.h.
+    using CapacityPolicy = ::CapacityPolicy; // Capacity rounding, see ProbeSequence.h.
+    using KeyArg = typename KeyTraits<K>::lookup_type; // Parameter type accepted by lookups.
+    using LookupKey = std::remove_cvref_t<KeyArg>; // Element type of the key spans accepted by batched lookups.
+
+private:
+    static constexpr bool cachesHash = KeyTraits<K>::cacheHash; // Whether buckets store the full hash of their key.
+    static constexpr bool arenaKeys = KeyTraits<K>::arenaStorage; // Whether key characters are stored in the arena of the table.
+    static constexpr bool stringKeys = std::is_same_v<LookupKey, std::string_view>; // Whether keys are strings, saved in the key blob of a snapshot.
+    static constexpr bool snapshotKeys = std::is_trivially_copyable_v<V>
+        && (stringKeys || std::is_trivially_copyable_v<K>); // Whether the table can be saved to and loaded from a snapshot.
+
+    /**
+     * @class HashTableBucket
+     * @brief Bucket for HashTable
+     *
+     * Stores key, value, and full hash of key (if cached for K).
+     * The history type of the bucket (NORMAL, ESS, or EAR) is kept in the control byte array of the table.
+     * The cached hash rejects the few non-matching keys that pass the control byte fingerprint with an integer comparison,
+     * and allows rehashing without recomputing the hash of every key.
+     */
+    class HashTableBucket {
+    private:
+        K key; // Key for hash table entry.
+        V value; // Value for hash table entry.
+        [[no_unique_address]] CachedHash<cachesHash> cachedHash; // Full hash of key (empty if not cached for K).
+
+    public:
+        HashTableBucket(); // Default constructor for HashTableBucket.
+        HashTableBucket(const K& key, const V& value, size_t hashValue); // Parameterized constructor for HashTableBucket.
+
+        [[nodiscard]] const K& getKey() const; // Getter for key stored in hash table bucket.
+        [[nodiscard]] V getValue() const; // Getter for value stored in hash table bucket.
+        [[nodiscard]] V& getValueRef(); // Getter for reference to value stored in hash table bucket.
+        [[nodiscard]] const V& getValueRef() const; // Getter for const reference to value stored in hash table bucket.
+        [[nodiscard]] size_t getHash() const requires cachesHash; // Getter for cached hash of key stored in hash table bucket.
+
+        [[nodiscard]] bool matches(size_t inHash, KeyArg inKey, const Eq& equal) const; // Predicate for determining if bucket holds given key.
+
+        [[nodiscard]] K releaseKey(); // Moves key out of hash table bucket.
+
+        void load(K inKey, const V& inValue, size_t inHash); // Fills bucket with key-value pair.
+        template<typename... Args>
+        void emplace(K inKey, size_t inHash, Args&&... valueArgs); // Fills bucket with key and a value constructed from arguments.
+
+        /**
+         * @brief Stream insertion operator overload for HashTableBucket.
+         *
+         * Outputs bucket content in the form "<key, value>"
+         *
+         * @warning Does not check if bucket is empty.
+         *
+         * @param os output stream
+         * @param bucket hash table bucket to be output
+         * @return output stream with bucket output added
+         */
+        friend std::ostream& operator<<(std::ostream& os, const HashTableBucket& bucket) {
+            os << "<" << bucket.getKey() << ", " << bucket.getValueRef() << ">";
+            return os;
+        }
+    };
+
+    const double threshold; // The load factor threshold for rehashing (default 0.5).
+    const double resizeFactor; // The factor by which the capacity of the hash table will be increased upon rehashing (default 2.0).
+    const double tombstoneThreshold; // The fraction of buckets that may be tombstones before the table is compacted (default 0.25).
+    const double shrinkThreshold; // The load factor below which removals shrink the table (default 0.0, never).
+    const size_t minCapacity; // The capacity below which the table never shrinks automatically (the initial capacity).
+
+    std::pmr::vector<uint8_t> control; // Control byte (history type and fingerprint) of every bucket, followed by mirrored bytes.
+    std::pmr::vector<HashTableBucket> tableData; // The hash table itself, implemented as a vector of HashTableBucket elements.
+    [[no_unique_address]] std::conditional_t<arenaKeys, KeyArena, NoKeyArena> keyArena; // Characters of the keys in tableData (if arena keys are used).
+    /**
+     * @struct MigrationState
+     * @brief Progress of an incremental rehash.
+     *
+     * The old bucket arrays are kept in a table of their own, which is drained in index order.
+     * Copying a table copies the table being drained as well.
+     */
+    struct MigrationState {
+        std::unique_ptr<HashTable_t> source; // Table holding the buckets not yet migrated, or null if no migration is in progress.
+        size_t cursor = 0; // Index of the next bucket of source to be migrated.
+
+        MigrationState() = default; // Default constructor for MigrationState.
+        MigrationState(const MigrationState& other); // Copy constructor for MigrationState.
+        MigrationState(MigrationState&& other) noexcept = default; // Move constructor for MigrationState.
+    };
+
+    const ProbeMode probeMode; // Collision resolution strategy (default PSEUDO_RANDOM).
+    size_t probeMultiplier; // Per-table LCG multiplier for pseudo-random probing.
+    size_t probeIncrement; // Per-table LCG increment for pseudo-random probing.
+    const CapacityPolicy capacityPolicy; // Rounding applied to the capacity (default POWER_OF_TWO).
+    size_t indexMask; // capacity - 1, for bucket indexing under the POWER_OF_TWO policy.
+    size_t windowWidth; // Number of consecutive buckets examined per probe (GROUP_WIDTH, or 1 if groups do not tile the table).
+    size_t numWindows; // Number of probe windows in the table.
+    uint32_t laneMask; // Bitmask of the lanes of a ControlGroup that belong to the current window.
+    size_t numFilled; // The number of filled buckets in the hash table.
+    size_t numTombstones; // The number of EAR buckets in the hash table.
+    [[no_unique_address]] Hash hash; // Using () overload, provides hash function size_t hash(KeyArg)
+    [[no_unique_address]] Eq equal; // Using () overload, provides key equality predicate bool equal(K, KeyArg)
+    const size_t migrationStep; // The number of old buckets migrated per operation during an incremental rehash (default 0, rehash at once).
+    const size_t rehashThreads; // The number of threads moving key-value pairs during a rehash (default 1; 0 for one per hardware thread).
+    MigrationState migration; // Progress of the incremental rehash, if one is in progress.
+    V badKeyDrain; // Dummy variable for capturing invalid uses of subscript operator.
+    [[no_unique_address]] mutable StatsCounters<HASHTABLE_STATS> counters; // Search and rehash statistics (empty unless HASHTABLE_ENABLE_STATS is defined).
+
+    /**
+     * @struct InsertSlot
+     * @brief Outcome of probing for a key that is about to be inserted.
+     */
+    struct InsertSlot {
+        HashTableBucket* found; // Bucket already holding the key (in the new or old bucket arrays), or null.
+        size_t emptyIndex; // First empty bucket on the key's probe path, or NOT_FOUND if there is none.
+    };
+
+    void rehash(); // Rehashes the table, increasing its size.
+    void rehash(size_t newCapacity); // Rehashes the table to a given capacity.
+    void shrinkTo(size_t required); // Rehashes the table to a smaller capacity, if a given requirement allows it.
+    void migrate(size_t numBuckets); // Moves a number of old buckets over during an incremental rehash.
+    void swapStorage(HashTable_t& other); // Exchanges bucket arrays and their layout with another table.
+    bool insertHashed(const K& key, const V& value, size_t hashValue); // Insert key-value pair with precomputed hash into table.
+    bool insertIntoNewTable(K&& key, const V& value, size_t hashValue); // Insert key-value pair into a new table during rehashing.
+    void moveIntoNewTable(HashTable_t& newTable, size_t numThreads); // Moves every key-value pair into a new table using several threads.
+    bool claimInNewTable(K&& key, const V& value, size_t hashValue); // Insert key-value pair into a new table filled by several threads at once.
+    [[nodiscard]] InsertSlot probeForInsert(KeyArg key, size_t hashValue); // Finds a key, or the bucket it would be inserted into.
+    void fillBucket(size_t index, K key, const V& value, size_t hashValue); // Stores key-value pair in an empty bucket.
+    template<typename... Args>
+    void emplaceBucket(size_t index, K key, size_t hashValue, Args&&... valueArgs); // Stores key and a value constructed from arguments in an empty bucket.
+    void vacateBucket(size_t index); // Empties a filled bucket, leaving a tombstone if necessary.
+    [[nodiscard]] bool canReclaim(size_t index) const; // Predicate for if a bucket can be emptied without leaving a tombstone.
+    [[nodiscard]] double releasedKeyFraction() const; // Fraction of the key arena held by the characters of removed keys.
+    [[nodiscard]] size_t find(KeyArg key, size_t hashValue) const; // Find index of bucket containing key.
+    [[nodiscard]] HashTableBucket* findBucket(KeyArg key); // Find bucket containing key in the new or old bucket arrays.
+    [[nodiscard]] HashTableBucket* findBucket(KeyArg key, size_t hashValue); // Find bucket containing key with precomputed hash.
+    [[nodiscard]] const HashTableBucket* findBucket(KeyArg key, size_t hashValue) const; // Find bucket containing key with precomputed hash, without modifying it.
+    bool removeHashed(KeyArg key, size_t hashValue); // Remove key-value pair with precomputed hash from table.
+    void resizeAfterRemoval(); // Shrinks or compacts the table if removals have made it necessary.
+    void prefetch(size_t hashValue) const; // Prefetches the home control bytes and bucket of a key with given hash.
+    template<typename Function>
+    void forEachHashed(std::span<const LookupKey> keys, Function function) const; // Calls a function with the hash of every key of a batch, prefetching ahead.
+    void setControl(size_t index, uint8_t byte); // Sets the control byte of a bucket.
+    [[nodiscard]] size_t storedHash(const HashTableBucket& bucket) const; // Full hash of key stored in a bucket.
+    [[nodiscard]] ProbeSequence probeSequence(size_t hashValue) const; // Probe sequence for a key with given hash.
+    [[nodiscard]] size_t homeIndex(size_t hashValue) const; // Home bucket for a key with given hash.
+    [[nodiscard]] size_t bucketIndex(size_t home, size_t offset) const; // Index of bucket at given offset from home bucket.
+    [[nodiscard]] size_t laneIndex(size_t windowStart, size_t lane) const; // Index of bucket in given lane of a probe window.
+    void configureWindows(); // Sets the probe window layout for the current capacity.
+    [[nodiscard]] static size_t roundCapacity(size_t requested, CapacityPolicy policy); // Rounds a requested capacity according to a capacity policy.
+
+    static constexpr size_t NOT_FOUND = std::numeric_limits<size_t>::max(); // Index returned by find for missing keys.
+    static constexpr size_t NUM_MIRRORED = ControlGroup::GROUP_WIDTH - 1; // Control bytes mirrored past the end of the table.
+    static constexpr size_t MIN_BUCKETS_PER_THREAD = static_cast<size_t>(1) << 16; // Smallest share of old buckets worth a rehash thread.
+    static constexpr size_t PREFETCH_DISTANCE = 8; // Number of keys ahead of the current one that batched lookups prefetch.
+    static constexpr size_t HASH_BLOCK = 64; // Number of keys batched lookups hash at a time, into a buffer on the stack.
+
+    [[nodiscard]] size_t nextFilled(size_t index, size_t last) const; // Index of the first filled bucket in a range of buckets.
+    template<typename Self, typename Function>
+    static void visitBuckets(Self& table, size_t first, size_t last, Function& function); // Calls a function with every key-value pair in a range of buckets.
+
+public:
+    /**
+     * @class BucketIterator
+     * @brief Forward iterator over the key-value pairs of a HashTable.
+     *
+     * Visits the filled buckets of the table in index order, followed during an incremental rehash by those not yet migrated.
+     * Empty buckets are skipped GROUP_WIDTH control bytes at a time (see ControlGroup).
+     * Dereferencing yields a pair of references, to the key (const) and to the value (const for const_iterator),
+     * so for (auto [key, value] : table) neither copies keys nor probes for them.
+     *
+     * @warning Every iterator is invalidated by any insertion or removal, and during an incremental rehash
+     * by any operation that migrates buckets (every non-const operation, lookups included).
+     */
+    template<bool isConst>
+    class BucketIterator {
+    private:
+        using Table = std::conditional_t<isConst, const HashTable_t, HashTable_t>; // Table iterated over.
+
+        Table* table = nullptr; // Table holding the current bucket (the table being drained, once past the new arrays), or null at the end.
+        size_t index = 0; // Index of the current bucket within table.
+
+        friend class HashTable_t;
+        friend class BucketIterator<!isConst>;
+        BucketIterator(Table* inTable, size_t inIndex); // Parameterized constructor for BucketIterator.
+        void settle(); // Moves to the first filled bucket at or after the current one.
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = std::pair<const K&, std::conditional_t<isConst, const V&, V&>>;
+        using reference = value_type;
+
+        BucketIterator() = default; // Default constructor for BucketIterator (the end iterator).
+        operator BucketIterator<true>() const requires (!isConst); // Conversion from iterator to const_iterator.
+
+        [[nodiscard]] reference operator*() const; // Key and value of the current bucket.
+        BucketIterator& operator++(); // Advances to the next filled bucket.
+        BucketIterator operator++(int); // Advances to the next filled bucket, returning the iterator before advancing.
+        [[nodiscard]] bool operator==(const BucketIterator& other) const = default; // Predicate for if two iterators are at the same bucket.
+    };
+
+    using iterator = BucketIterator<false>; // Iterator yielding (const K&, V&) pairs.
+    using const_iterator = BucketIterator<true>; // Iterator yielding (const K&, const V&) pairs.
+
+    explicit HashTable_t(size_t initCapacity = 8, double inThreshold = 0.5, double inResizeFactor = 2.0,
+        ProbeMode inProbeMode = ProbeMode::PSEUDO_RANDOM, CapacityPolicy inCapacityPolicy = CapacityPolicy::POWER_OF_TWO,
+        double inTombstoneThreshold = 0.25, double inShrinkThreshold = 0.0, size_t inMigrationStep = 0,
+        size_t inRehashThreads = 1,
+        std::pmr::memory_resource* inResource = std::pmr::get_default_resource(),
+        const Hash& inHash = makeHash<Hash>()); // Default and parameterized constructor for hash table.
+    HashTable_t(const HashTable_t& other) requires (!arenaKeys) = default; // Copy constructor for hash table.
+    HashTable_t(const HashTable_t& other) requires (arenaKeys); // Copy constructor for hash table with arena keys.
+    HashTable_t(HashTable_t&& other) = default; // Move constructor for hash table.
+
+    V& operator[](KeyArg key); // Subscript operator overload for hash table.
+
+    [[nodiscard]] size_t capacity() const; // Getter for capacity of the hash table.
+    [[nodiscard]] size_t size() const; // Getter for size of the hash table.
+    [[nodiscard]] double alpha() const; // Getter for the load factor of the hash table.
+    [[nodiscard]] size_t tombstones() const; // Getter for number of tombstones in the hash table.
+    [[nodiscard]] bool isMigrating() const; // Predicate for if an incremental rehash is in progress.
+    [[nodiscard]] size_t arenaCapacity() const requires arenaKeys; // Getter for number of bytes allocated for keys.
+    [[nodiscard]] std::pmr::memory_resource* memoryResource() const; // Getter for the memory resource the table allocates from.
+    [[nodiscard]] Hash hash_function() const; // Getter for the hash function, with its seed if seeded.
+    [[nodiscard]] size_t hashOf(KeyArg key) const; // Mixed hash of a key, from which its home bucket and fingerprint are taken.
+    [[nodiscard]] HashTableStats stats() const; // Getter for a snapshot of the statistics of the hash table.
+    [[nodiscard]] std::vector<K> keys() const; // Getter for a list of keys currently used in the hash table.
+    [[nodiscard]] std::vector<std::pair<K, V>> pairs() const; // Getter for a list of key-value pairs currently stored in the hash table.
+    [[nodiscard]] iterator begin(); // Iterator at the first key-value pair of the hash table.
+    [[nodiscard]] iterator end(); // Iterator past the last key-value pair of the hash table.
+    [[nodiscard]] const_iterator begin() const; // Const iterator at the first key-value pair of the hash table.
+    [[nodiscard]] const_iterator end() const; // Const iterator past the last key-value pair of the hash table.
+    template<typename Function>
+    void for_each(Function function); // Calls a function with the key and value of every key-value pair.
+    template<typename Function>
+    void for_each(Function function) const; // Calls a function with the key and value of every key-value pair, without modifying them.
+    template<typename Function>
+    void parallel_for_each(Function function, size_t numThreads = 0); // Calls a function with every key-value pair, from several threads.
+    template<typename Function>
+    size_t for_each_chunk(size_t cursor, size_t numBuckets, Function function); // Calls a function with the key-value pairs of a chunk of buckets.
+    [[nodiscard]] std::optional<V> get(KeyArg key); // Getter for value stored using a given key.
+    [[nodiscard]] std::optional<V> get(KeyArg key, size_t hashValue); // Getter for value stored using a given key with precomputed hash.
+    [[nodiscard]] std::optional<V> get(KeyArg key, size_t hashValue) const; // Getter for value stored using a given key with precomputed hash, without migrating buckets.
+
+    [[nodiscard]] bool contains(KeyArg key); // Predicate for if a given key is stored in table.
+    [[nodiscard]] bool contains(KeyArg key, size_t hashValue); // Predicate for if a given key with precomputed hash is stored in table.
+    [[nodiscard]] bool contains(KeyArg key, size_t hashValue) const; // Predicate for if a given key with precomputed hash is stored in table, without migrating buckets.
+    size_t get_many(std::span<const LookupKey> keys, std::span<std::optional<V>> values); // Getter for values stored using a batch of keys.
+    size_t contains_many(std::span<const LookupKey> keys, std::span<bool> results); // Predicate for which of a batch of keys are stored in table.
+
+    bool insert(const K& key, const V& value); // Insert key-value pair into table.
+    bool insert(const K& key, const V& value, size_t hashValue); // Insert key-value pair with precomputed hash into table.
+    size_t insert(std::span<const std::pair<K, V>> pairs); // Insert a batch of key-value pairs into table.
+    template<std::input_iterator InputIt> requires PairIterator<InputIt>
+    size_t insert(InputIt first, InputIt last); // Insert a range of key-value pairs into table.
+    bool insert_or_assign(const K& key, const V& value); // Insert key-value pair, or assign value if key is present.
+    bool insert_or_assign(const K& key, const V& value, size_t hashValue); // Insert key-value pair with precomputed hash, or assign value if key is present.
+    template<typename Function>
+    bool update(KeyArg key, Function function); // Modifies value stored using a given key in place.
+    template<typename Function>
+    bool update(KeyArg key, size_t hashValue, Function function); // Modifies value stored using a given key with precomputed hash in place.
+    template<typename... Args>
+    bool try_emplace(const K& key, Args&&... valueArgs); // Insert key with a value constructed from arguments, if key is absent.
+    V& getOrInsert(const K& key); // Reference to value stored using a given key, inserting a default value if absent.
+    void reserve(size_t expectedElements); // Reserves capacity for a number of key-value pairs.
+    bool remove(KeyArg key); // Remove key-value pair from table.
+    bool remove(KeyArg key, size_t hashValue); // Remove key-value pair with precomputed hash from table.
+    size_t remove_many(std::span<const LookupKey> keys); // Remove a batch of key-value pairs from table.
+    void compact(); // Rehashes the table at its current capacity, clearing all tombstones.
+    void shrink_to_fit(); // Rehashes the table to the smallest capacity that holds its key-value pairs.
+    bool save(const std::filesystem::path& path) requires snapshotKeys; // Writes the table to a snapshot file.
+    [[nodiscard]] static std::optional<HashTable_t> load(const std::filesystem::path& path,
+        std::pmr::memory_resource* inResource = std::pmr::get_default_resource()) requires snapshotKeys; // Restores a table from a snapshot file.
+
+    size_t insertTCT(const K& key, const V& value); // Time-complexity testing version of insert.
+    size_t removeTCT(KeyArg key); // Time-complexity testing version of remove.
+
+    /**
+     * @brief Stream insertion operator overload for HashTable.
+     *
+     * Outputs the filled buckets in the table bucket-by-bucket on separate lines.
+     * The bucket number prepended is prepended to the contents.
+     * During an incremental rehash, the old buckets not yet migrated are output after the new ones.
+     *
+     * @param os output stream
+     * @param hashTable hash table to be output
+     * @return output stream with hash table output added
+     */
+    friend std::ostream& operator<<(std::ostream& os, const HashTable_t& hashTable) {
+        for (size_t bucketNum = 0; bucketNum < hashTable.capacity(); ++bucketNum) {
+            if (ControlByte::isFull(slotAt(hashTable.control, bucketNum))) {
+                os << "Bucket " << bucketNum << ": " << slotAt(hashTable.tableData, bucketNum) << std::endl;
+            }
+        }
+        if (hashTable.migration.source) { // Buckets not yet migrated follow, numbered by their old positions.
+            os << *hashTable.migration.source;
+        }
+        return os;
+    }
+};
+
+/**
+ * @brief Default and parameterized constructor for hash table.
+ *
+ * Default and parameterized constructor for hash table.
+ * Creates a hash table with given number of initial empty buckets.
+ * If no value is given, the initial number defaults to 8.
+ * Under the POWER_OF_TWO capacity policy, the number is rounded up to the next power of two.
+ * The multiplier and increment of the pseudo-random probe sequence are drawn randomly for each table.
+ * The multiplier is congruent to 1 mod 4 and the increment is odd, so the sequence has full period
+ * over any power of two (Hull-Dobell theorem) and begins at offset 0, the home location.
+ * Unless a hash function is given, a seeded hash function is given a random seed as well (see makeHash).
+ * The control byte array holds NUM_MIRRORED extra bytes past the last bucket, mirroring the first buckets,
+ * so that a window of GROUP_WIDTH control bytes can be loaded at any bucket without wrapping around.
+ *
+ * @param initCapacity Initial number of empty buckets in hash table.
+ * @param inThreshold The load factor threshold for rehashing (default 0.5).
+ * @param inResizeFactor The factor by which the capacity of the hash table will be increased upon rehashing (default 2.0).
+ * @param inProbeMode The collision resolution strategy (default PSEUDO_RANDOM).
+ * @param inCapacityPolicy The rounding applied to the capacity (default POWER_OF_TWO).
+ * @param inTombstoneThreshold The fraction of buckets that may be tombstones before the table is compacted (default 0.25).
+ * @param inShrinkThreshold The load factor below which removals shrink the table (default 0.0, never).
+ * Capped at inThreshold / (2 * inResizeFactor), so that a table that has just grown is never sparse enough to shrink.
+ * @param inMigrationStep The number of old buckets migrated per operation during an incremental rehash (default 0, rehash at once).
+ * Should let a migration finish before the next rehash is due (at least 2 with the default threshold and resize factor);
+ * otherwise the rest of the migration is completed at once when the next rehash begins.
+ * @param inRehashThreads The number of threads moving key-value pairs during a rehash (default 1; 0 for one per hardware thread).
+ * Each thread is given at least MIN_BUCKETS_PER_THREAD old buckets, so smaller tables are rehashed by fewer threads.
+ * Has no effect in incremental mode or with ArenaString keys.
+ * @param inResource Memory resource for the bucket arrays and key arena (default std::pmr::get_default_resource()).
+ * Must outlive the table; tables created by rehashing allocate from it as well.
+ * @param inHash The hash function (default makeHash<Hash>()). Tables given the same hash function compute the same hashOf
+ * for every key, so a hash computed by one can be passed to the hashed operations of another.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+HashTable_t<K, V, Hash, Eq>::HashTable_t(const size_t initCapacity, const double inThreshold, const double inResizeFactor, const ProbeMode inProbeMode,
+    const CapacityPolicy inCapacityPolicy, const double inTombstoneThreshold, const double inShrinkThreshold, const size_t inMigrationStep,
+    const size_t inRehashThreads, std::pmr::memory_resource* const inResource, const Hash& inHash) :
+    threshold(inThreshold), resizeFactor(inResizeFactor), tombstoneThreshold(inTombstoneThreshold),
+    shrinkThreshold(std::min(inShrinkThreshold, inThreshold / (2.0 * inResizeFactor))), minCapacity(roundCapacity(initCapacity, inCapacityPolicy)),
+    control(minCapacity + NUM_MIRRORED, ControlByte::ESS, inResource),
+    tableData(control.size() - NUM_MIRRORED, inResource), keyArena(inResource),
+    probeMode(inProbeMode), capacityPolicy(inCapacityPolicy), indexMask(tableData.size() - 1), numFilled(0), numTombstones(0), hash(inHash), migrationStep(inMigrationStep),
+    rehashThreads(inRehashThreads != 0 ? inRehashThreads : std::max(std::thread::hardware_concurrency(), 1U)), migration(), badKeyDrain(), counters() {
+    std::mt19937_64 rngEngine(std::random_device{}());
+    probeMultiplier = (rngEngine() & ~static_cast<size_t>(3)) | 1;
+    probeIncrement = rngEngine() | 1;
+    configureWindows();
+}
+
+/**
+ * @brief Copy constructor for hash table with arena keys.
+ *
+ * Copies every member, then stores the key of every filled bucket again in the new table's own arena,
+ * which leaves out the characters of removed keys. Tombstones keep their stale keys, which are never read.
+ * Any old buckets still to be migrated are copied with their own arena.
+ *
+ * @param other hash table to be copied
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+HashTable_t<K, V, Hash, Eq>::HashTable_t(const HashTable_t& other) requires (arenaKeys) :
+    threshold(other.threshold), resizeFactor(other.resizeFactor), tombstoneThreshold(other.tombstoneThreshold),
+    shrinkThreshold(other.shrinkThreshold), minCapacity(other.minCapacity), control(other.control), tableData(other.tableData), keyArena(),
+    probeMode(other.probeMode), probeMultiplier(other.probeMultiplier), probeIncrement(other.probeIncrement), capacityPolicy(other.capacityPolicy),
+    indexMask(other.indexMask), windowWidth(other.windowWidth), numWindows(other.numWindows), laneMask(other.laneMask),
+    numFilled(other.numFilled), numTombstones(other.numTombstones), hash(other.hash), equal(other.equal), migrationStep(other.migrationStep),
+    rehashThreads(other.rehashThreads), migration(other.migration), badKeyDrain(other.badKeyDrain), counters(other.counters) {
+    for (size_t bucketNum = 0; bucketNum < capacity(); ++bucketNum) {
+        if (ControlByte::isFull(slotAt(control, bucketNum))) {
+            HashTableBucket& currBucket = slotAt(tableData, bucketNum);
+            currBucket.load(keyArena.store(currBucket.getKey()),currBucket.getValueRef(),currBucket.getHash());
+        }
+    }
+}
+
+/**
+ * @brief Subscript operator overload for hash table.
+ *
+ * Allows retrieval and assignment of value associated with given key in a manner like using an array index.
+ * E.G:
+ * hashTable["name"] will return a reference to the value associated with the key "name" if it is in the table.
+ * hashTable["name"] = 5 will change that value.
+ * If the key is not in the table, the returned reference will point to a dummy value field of the HashTable.
+ *
+ * @warning There is no explicit indication that the key was not present and the value is a dummy.
+ * It is recommended that brackets only be used if the presence of the key in the table is a certainty.
+ *
+ * @param key Key to be searched.
+ * @return Reference to value associated with key.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+V& HashTable_t<K, V, Hash, Eq>::operator[](const KeyArg key) {
+    migrate(migrationStep);
+    if (HashTableBucket* foundBucket = findBucket(key)) {
+        return foundBucket->getValueRef();
+    }
+    return badKeyDrain;
+}
+
+/**
+ * @brief Getter for capacity of hash table.
+ *
+ * The capacity is the total number of buckets (empty or filled) in the hash table.
+ *
+ * @return capacity of hash table
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t HashTable_t<K, V, Hash, Eq>::capacity() const {
+    return tableData.size();
+}
+
+/**
+ * @brief Getter for size of hash table.
+ *
+ * The size is the total number of filled buckets in the hash table.
+ * This value is tracked internally and stored in the field numFilled for O(1) access.
+ * During an incremental rehash, the old buckets not yet migrated are counted as well.
+ *
+ * @return size of hash table
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t HashTable_t<K, V, Hash, Eq>::size() const {
+    return migration.source ? numFilled + migration.source->numFilled : numFilled;
+}
+
+/**
+ * @brief Getter for load factor (alpha) of hash table.
+ *
+ * Calculated as the ratio between the number of filled buckets (size)
+ * and the total number of buckets in the table (capacity).
+ *
+ * @return load factor (alpha) of hash table
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+double HashTable_t<K, V, Hash, Eq>::alpha() const {
+    return static_cast<double>(size())/static_cast<double>(capacity());
+}
+
+/**
+ * @brief Getter for number of tombstones in the hash table.
+ *
+ * Tombstones (EAR buckets) are left by removals and cleared by rehashing or compact.
+ *
+ * @return number of tombstones in hash table
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t HashTable_t<K, V, Hash, Eq>::tombstones() const {
+    return numTombstones;
+}
+
+/**
+ * @brief Predicate for if an incremental rehash is in progress.
+ *
+ * Always false unless the table was constructed with a nonzero migration step.
+ *
+ * @return true if old buckets remain to be migrated, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool HashTable_t<K, V, Hash, Eq>::isMigrating() const {
+    return migration.source != nullptr;
+}
+
+/**
+ * @brief Getter for number of bytes allocated for keys.
+ *
+ * Only available with ArenaString keys. Counts the whole of every slab of the arena, including the characters
+ * of removed keys, which are only released by the next rehash, and the old arena during an incremental rehash.
+ *
+ * @return number of bytes allocated for keys.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t HashTable_t<K, V, Hash, Eq>::arenaCapacity() const requires arenaKeys {
+    return keyArena.capacity() + (migration.source ? migration.source->arenaCapacity() : 0);
+}
+
+/**
+ * @brief Getter for the memory resource the table allocates from.
+ *
+ * @return memory resource of the bucket arrays and key arena.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+std::pmr::memory_resource* HashTable_t<K, V, Hash, Eq>::memoryResource() const {
+    return control.get_allocator().resource();
+}
+
+/**
+ * @brief Getter for the hash function, with its seed if seeded.
+ *
+ * @return copy of the hash function.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+Hash HashTable_t<K, V, Hash, Eq>::hash_function() const {
+    return hash;
+}
+
+/**
+ * @brief Getter for a snapshot of the statistics of the hash table.
+ *
+ * The size, capacity, tombstone count, and bytes allocated are always reported. Probe-length histograms,
+ * tombstones crossed, and rehash count and time are recorded only when HASHTABLE_ENABLE_STATS is defined,
+ * and accumulate over the lifetime of the table (copies start from the statistics of the original).
+ * During an incremental rehash, the old bucket arrays are included.
+ *
+ * @return statistics of hash table.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+HashTableStats HashTable_t<K, V, Hash, Eq>::stats() const {
+    HashTableStats snapshot;
+    if (migration.source) {
+        snapshot = migration.source->stats();
+    }
+    snapshot.size += numFilled;
+    snapshot.capacity = capacity();
+    snapshot.tombstones += numTombstones;
+    snapshot.bytesAllocated += control.capacity() * sizeof(uint8_t) + tableData.capacity() * sizeof(HashTableBucket);
+    if constexpr (arenaKeys) {
+        snapshot.bytesAllocated += keyArena.capacity();
+    }
+    counters.addTo(snapshot);
+    return snapshot;
+}
+
+/**
+ * @brief Getter for a list of keys currently used in the hash table.
+ *
+ * The list is returned as a vector of keys, in iteration order (see BucketIterator).
+ * The method may in may iterate over every bucket in the hash table,
+ * so its time complexity is O(capacity). To visit keys without copying them, iterate over the table or use for_each.
+ *
+ * @warning ArenaString keys view the arena of the table, so the list is invalidated once the table is modified.
+ * @return vector of keys present in the hash table.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+std::vector<K> HashTable_t<K, V, Hash, Eq>::keys() const {
+    std::vector<K> keyList;
+    keyList.reserve(size()); // Size of keyList is known in advance.
+    for_each([&keyList](const K& key, const V&) { keyList.push_back(key); });
+    return keyList;
+}
+
+/**
+ * @brief Getter for a list of key-value pairs currently stored in the hash table.
+ *
+ * Like keys, but copies each value alongside its key. O(capacity).
+ *
+ * @warning ArenaString keys view the arena of the table, so the list is invalidated once the table is modified.
+ * @return vector of key-value pairs present in the hash table.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+std::vector<std::pair<K, V>> HashTable_t<K, V, Hash, Eq>::pairs() const {
+    std::vector<std::pair<K, V>> pairList;
+    pairList.reserve(size());
+    for_each([&pairList](const K& key, const V& value) { pairList.emplace_back(key, value); });
+    return pairList;
+}
+
+/**
+ * @brief Iterator at the first key-value pair of the hash table.
+ *
+ * @return iterator at the first filled bucket, or end() if the table is empty.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+typename HashTable_t<K, V, Hash, Eq>::iterator HashTable_t<K, V, Hash, Eq>::begin() {
+    return iterator(this, 0);
+}
+
+/**
+ * @brief Iterator past the last key-value pair of the hash table.
+ *
+ * @return end iterator.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+typename HashTable_t<K, V, Hash, Eq>::iterator HashTable_t<K, V, Hash, Eq>::end() {
+    return iterator();
+}
+
+/**
+ * @brief Const iterator at the first key-value pair of the hash table.
+ *
+ * @return const iterator at the first filled bucket, or end() if the table is empty.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+typename HashTable_t<K, V, Hash, Eq>::const_iterator HashTable_t<K, V, Hash, Eq>::begin() const {
+    return const_iterator(this, 0);
+}
+
+/**
+ * @brief Const iterator past the last key-value pair of the hash table.
+ *
+ * @return end const iterator.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+typename HashTable_t<K, V, Hash, Eq>::const_iterator HashTable_t<K, V, Hash, Eq>::end() const {
+    return const_iterator();
+}
+
+/**
+ * @brief Calls a function with the key and value of every key-value pair.
+ *
+ * function(const K& key, V& value) is called once per pair, in iteration order, and may modify the value in place.
+ * Nothing is allocated and no key is probed for, so exporting a table visits each bucket once.
+ *
+ * @warning function must not insert into or remove from the table.
+ * @param function function called with every key-value pair
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+template<typename Function>
+void HashTable_t<K, V, Hash, Eq>::for_each(Function function) {
+    for (HashTable_t* table = this; table != nullptr; table = table->migration.source.get()) {
+        visitBuckets(*table, 0, table->capacity(), function);
+    }
+}
+
+/**
+ * @brief Calls a function with the key and value of every key-value pair, without modifying them.
+ *
+ * Const version of for_each: function(const K& key, const V& value) is called once per pair.
+ *
+ * @param function function called with every key-value pair
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+template<typename Function>
+void HashTable_t<K, V, Hash, Eq>::for_each(Function function) const {
+    for (const HashTable_t* table = this; table != nullptr; table = table->migration.source.get()) {
+        visitBuckets(*table, 0, table->capacity(), function);
+    }
+}
+
+/**
+ * @brief Calls a function with every key-value pair, from several threads.
+ *
+ * Like for_each, but the buckets of each bucket array are split into contiguous ranges, one per thread, as in a parallel rehash;
+ * arrays of fewer than MIN_BUCKETS_PER_THREAD buckets per thread are visited by fewer threads, or by the caller alone.
+ * Each pair is visited by exactly one thread, so function may modify the value it is given without synchronization,
+ * but is called concurrently and must be safe to call from several threads.
+ *
+ * @warning function must not insert into or remove from the table.
+ * @param function function called with every key-value pair, as function(const K& key, V& value)
+ * @param numThreads maximum number of threads (default 0, the number of rehash threads of the table)
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+template<typename Function>
+void HashTable_t<K, V, Hash, Eq>::parallel_for_each(Function function, size_t numThreads) {
+    if (numThreads == 0) {
+        numThreads = rehashThreads;
+    }
+    for (HashTable_t* table = this; table != nullptr; table = table->migration.source.get()) {
+        const size_t tableCapacity = table->capacity();
+        const size_t tableThreads = std::clamp(tableCapacity / MIN_BUCKETS_PER_THREAD, static_cast<size_t>(1), numThreads);
+        if (tableThreads == 1) {
+            visitBuckets(*table, 0, tableCapacity, function);
+            continue;
+        }
+        std::vector<std::thread> workers;
+        workers.reserve(tableThreads);
+        for (size_t worker = 0; worker < tableThreads; ++worker) {
+            workers.emplace_back([table, &function, worker, tableThreads, tableCapacity] {
+                const size_t first = tableCapacity / tableThreads * worker + std::min(worker, tableCapacity % tableThreads);
+                const size_t last = first + tableCapacity / tableThreads + (worker < tableCapacity % tableThreads ? 1 : 0);
+                visitBuckets(*table, first, last, function);
+            });
+        }
+        for (std::thread& workerThread : workers) {
+            workerThread.join();
+        }
+    }
+}
+
+/**
+ * @brief Calls a function with the key-value pairs of a chunk of buckets.
+ *
+ * Visits the pairs in the numBuckets buckets starting at cursor, so that a long export may be spread over many calls
+ * (in the manner of a SCAN cursor). Cursors count the buckets of the table, followed during an incremental rehash
+ * by those of the bucket arrays being drained. Starting from cursor 0 and passing each returned cursor to the next call
+ * visits every pair exactly once, provided the table is not modified in between.
+ *
+ * @warning Cursors are invalidated by any operation that may rehash or migrate; a resumed visit then may miss or repeat pairs.
+ * @param cursor first bucket to visit (0 to start)
+ * @param numBuckets number of buckets to visit (at least 1)
+ * @param function function called with every key-value pair, as function(const K& key, V& value)
+ * @return cursor to resume from, or 0 once every bucket has been visited.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+template<typename Function>
+size_t HashTable_t<K, V, Hash, Eq>::for_each_chunk(size_t cursor, size_t numBuckets, Function function) {
+    size_t tableStart = 0; // Cursor of the first bucket of table.
+    for (HashTable_t* table = this; table != nullptr; table = table->migration.source.get()) {
+        const size_t tableEnd = tableStart + table->capacity();
+        if (numBuckets != 0 && cursor < tableEnd) {
+            const size_t first = cursor - tableStart;
+            const size_t last = first + std::min(numBuckets, tableEnd - cursor);
+            visitBuckets(*table, first, last, function);
+            numBuckets -= last - first;
+            cursor = tableStart + last;
+        }
+        tableStart = tableEnd;
+    }
+    return cursor < tableStart ? cursor : 0;
+}
+
+/**
+ * @brief Getter for value stored using a given key.
+ *
+ * Searches for key using the helper method findBucket.
+ * If key is not found, returns nullopt.
+ *
+ * @param key Key to be searched.
+ * @return value associated with key or nullopt.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+std::optional<V> HashTable_t<K, V, Hash, Eq>::get(const KeyArg key) {
+    migrate(migrationStep);
+    if (const HashTableBucket* foundBucket = findBucket(key)) {
+        return foundBucket->getValue();
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Getter for value stored using a given key with precomputed hash.
+ *
+ * Version of get for callers that have already hashed the key with hashOf, such as tables routing keys to one of
+ * several HashTables by their hash.
+ *
+ * @param key Key to be searched.
+ * @param hashValue hashOf(key), computed by this table or one sharing its hash function.
+ * @return value associated with key or nullopt.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+std::optional<V> HashTable_t<K, V, Hash, Eq>::get(const KeyArg key, const size_t hashValue) {
+    migrate(migrationStep);
+    return std::as_const(*this).get(key, hashValue);
+}
+
+/**
+ * @brief Getter for value stored using a given key with precomputed hash, without migrating buckets.
+ *
+ * Does not advance an incremental rehash (it searches both bucket arrays), so it can be called on a const table,
+ * and by several threads at once on a table no thread is modifying.
+ *
+ * @param key Key to be searched.
+ * @param hashValue hashOf(key), computed by this table or one sharing its hash function.
+ * @return value associated with key or nullopt.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+std::optional<V> HashTable_t<K, V, Hash, Eq>::get(const KeyArg key, const size_t hashValue) const {
+    if (const HashTableBucket* foundBucket = findBucket(key, hashValue)) {
+        return foundBucket->getValue();
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Predicate for if a given key is stored in table.
+ *
+ * Searches for key using the helper method findBucket.
+ * Returns true if key is found, false otherwise.
+ *
+ * @param key Key to be searched.
+ * @return true if key found, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool HashTable_t<K, V, Hash, Eq>::contains(const KeyArg key) {
+    migrate(migrationStep);
+    if (findBucket(key) != nullptr) {
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Predicate for if a given key with precomputed hash is stored in table.
+ *
+ * Version of contains for callers that have already hashed the key, like the hashed get.
+ *
+ * @param key Key to be searched.
+ * @param hashValue hashOf(key), computed by this table or one sharing its hash function.
+ * @return true if key found, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool HashTable_t<K, V, Hash, Eq>::contains(const KeyArg key, const size_t hashValue) {
+    migrate(migrationStep);
+    return std::as_const(*this).contains(key, hashValue);
+}
+
+/**
+ * @brief Predicate for if a given key with precomputed hash is stored in table, without migrating buckets.
+ *
+ * Does not advance an incremental rehash, like the const hashed get.
+ *
+ * @param key Key to be searched.
+ * @param hashValue hashOf(key), computed by this table or one sharing its hash function.
+ * @return true if key found, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool HashTable_t<K, V, Hash, Eq>::contains(const KeyArg key, const size_t hashValue) const {
+    return findBucket(key, hashValue) != nullptr;
+}
+
+/**
+ * @brief Getter for values stored using a batch of keys.
+ *
+ * Batched version of get for many independent lookups. Keys are hashed HASH_BLOCK at a time and then looked up
+ * in order, while the home control bytes and bucket of the key PREFETCH_DISTANCE places ahead are prefetched,
+ * so that the cache misses of several lookups overlap instead of being paid one after another (see forEachHashed).
+ * A batch counts as one operation towards an incremental rehash.
+ *
+ * @warning Only as many keys as values has room for are looked up.
+ *
+ * @param keys Keys to be searched.
+ * @param values Receives the value associated with each key, or nullopt.
+ * @return number of keys found.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t HashTable_t<K, V, Hash, Eq>::get_many(std::span<const LookupKey> keys, const std::span<std::optional<V>> values) {
+    migrate(migrationStep);
+    keys = keys.first(std::min(keys.size(), values.size()));
+    size_t numFound = 0;
+    forEachHashed(keys, [this, keys, values, &numFound](const size_t keyNum, const size_t hashValue) {
+        if (const HashTableBucket* foundBucket = findBucket(keys[keyNum], hashValue)) {
+            values[keyNum] = foundBucket->getValue();
+            ++numFound;
+        }
+        else {
+            values[keyNum] = std::nullopt;
+        }
+    });
+    return numFound;
+}
+
+/**
+ * @brief Predicate for which of a batch of keys are stored in table.
+ *
+ * Batched version of contains, probing like get_many.
+ *
+ * @warning Only as many keys as results has room for are looked up.
+ *
+ * @param keys Keys to be searched.
+ * @param results Receives true for each key found, false otherwise.
+ * @return number of keys found.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t HashTable_t<K, V, Hash, Eq>::contains_many(std::span<const LookupKey> keys, const std::span<bool> results) {
+    migrate(migrationStep);
+    keys = keys.first(std::min(keys.size(), results.size()));
+    size_t numFound = 0;
+    forEachHashed(keys, [this, keys, results, &numFound](const size_t keyNum, const size_t hashValue) {
+        results[keyNum] = findBucket(keys[keyNum], hashValue) != nullptr;
+        numFound += results[keyNum];
+    });
+    return numFound;
+}
+
+/**
+ * @brief Insert key-value pair into table.
+ *
+ * The bucket to be filled is found using pseudo-random probing.
+ * Returns true if insertion is successful.
+ * Returns false if the key is already present in the hash table or hash table is full.
+ * If the insertion raises the load factor of the hash table to or above the threshold (default 0.5), the table is rehashed.
+ *
+ * @param key of key-value pair to be inserted.
+ * @param value Value of key-value pair to be inserted.
+ *
+ * @return true if insertion successful, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool HashTable_t<K, V, Hash, Eq>::insert(const K& key, const V& value) {
+    return insert(key, value, hashOf(key));
+}
+
+/**
+ * @brief Insert key-value pair with precomputed hash into table.
+ *
+ * Version of insert for callers that have already hashed the key with hashOf.
+ *
+ * @param key of key-value pair to be inserted.
+ * @param value Value of key-value pair to be inserted.
+ * @param hashValue hashOf(key), computed by this table or one sharing its hash function.
+ *
+ * @return true if insertion successful, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool HashTable_t<K, V, Hash, Eq>::insert(const K& key, const V& value, const size_t hashValue) {
+    if (!insertHashed(key, value, hashValue)) {
+        return false;
+    }
+    if (alpha() >= threshold) { // Rehash if necessary.
+        rehash();
+    }
+    return true;
+}
+
+/**
+ * @brief Insert a batch of key-value pairs into table.
+ *
+ * The table is reserved for the whole batch once, the hashes of all keys are computed
+ * in a single pass, and the pairs are then inserted without checking the load factor per element,
+ * prefetching the home buckets of the pairs PREFETCH_DISTANCE places ahead (see get_many).
+ * Pairs whose key is already present (including keys repeated within the batch) are skipped.
+ *
+ * @param pairs key-value pairs to be inserted.
+ * @return number of pairs inserted.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t HashTable_t<K, V, Hash, Eq>::insert(const std::span<const std::pair<K, V>> pairs) {
+    reserve(size() + pairs.size());
+    std::pmr::vector<size_t> hashValues(pairs.size(), memoryResource());
+    for (size_t pairNum = 0; pairNum < pairs.size(); ++pairNum) {
+        hashValues[pairNum] = hashOf(pairs[pairNum].first);
+    }
+    size_t numInserted = 0;
+    for (size_t pairNum = 0; pairNum < pairs.size(); ++pairNum) {
+        if (pairNum + PREFETCH_DISTANCE < pairs.size()) {
+            prefetch(hashValues[pairNum + PREFETCH_DISTANCE]);
+        }
+        numInserted += insertHashed(pairs[pairNum].first, pairs[pairNum].second, hashValues[pairNum]);
+    }
+    return numInserted;
+}
+
+/**
+ * @brief Insert a range of key-value pairs into table.
+ *
+ * Like the batch insert for spans. If the range can be measured without consuming it (forward iterators),
+ * the table is reserved once for the whole range and the load factor is checked only once at the end.
+ * Otherwise the load factor is checked after every insertion, as in insert.
+ * Elements must be pair-like, with members first (key) and second (value).
+ *
+ * @param first Iterator to first key-value pair to be inserted.
+ * @param last Iterator past last key-value pair to be inserted.
+ * @return number of pairs inserted.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+template<std::input_iterator InputIt> requires PairIterator<InputIt>
+size_t HashTable_t<K, V, Hash, Eq>::insert(InputIt first, InputIt last) {
+    if constexpr (std::forward_iterator<InputIt>) {
+        reserve(size() + static_cast<size_t>(std::distance(first, last)));
+    }
+    size_t numInserted = 0;
+    for (; first != last; ++first) {
+        const auto& [key, value] = *first;
+        numInserted += insertHashed(key, value, hashOf(key));
+        if constexpr (!std::forward_iterator<InputIt>) {
+            if (alpha() >= threshold) { // Rehash if necessary.
+                rehash();
+            }
+        }
+    }
+    return numInserted;
+}
+
+/**
+ * @brief Insert key-value pair, or assign value if key is present.
+ *
+ * Probes the key's sequence once: the value is assigned in the bucket holding the key if one is found,
+ * and otherwise the pair is inserted into the first empty bucket passed, as by insert.
+ * A key found in the old bucket arrays during an incremental rehash is assigned in place.
+ *
+ * @param key of key-value pair to be inserted or assigned.
+ * @param value Value of key-value pair to be inserted or assigned.
+ *
+ * @return true if key-value pair inserted, false if value assigned.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool HashTable_t<K, V, Hash, Eq>::insert_or_assign(const K& key, const V& value) {
+    return insert_or_assign(key, value, hashOf(key));
+}
+
+/**
+ * @brief Insert key-value pair with precomputed hash, or assign value if key is present.
+ *
+ * Version of insert_or_assign for callers that have already hashed the key with hashOf.
+ *
+ * @param key of key-value pair to be inserted or assigned.
+ * @param value Value of key-value pair to be inserted or assigned.
+ * @param hashValue hashOf(key), computed by this table or one sharing its hash function.
+ *
+ * @return true if key-value pair inserted, false if value assigned.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool HashTable_t<K, V, Hash, Eq>::insert_or_assign(const K& key, const V& value, const size_t hashValue) {
+    migrate(migrationStep);
+    const InsertSlot slot = probeForInsert(key, hashValue);
+    if (slot.found != nullptr) {
+        slot.found->getValueRef() = value;
+        return false;
+    }
+    if (slot.emptyIndex == NOT_FOUND) {
+        return false; // Should not be possible, since the table rehashes before it is full.
+    }
+    fillBucket(slot.emptyIndex, key, value, hashValue);
+    if (alpha() >= threshold) { // Rehash if necessary.
+        rehash();
+    }
+    return true;
+}
+
+/**
+ * @brief Modifies value stored using a given key in place.
+ *
+ * Probes the key's sequence once and calls function with a reference to the value, if the key is found.
+ * E.G:
+ * table.update("name", [](size_t& count) {++count;});
+ *
+ * @param key Key to be searched.
+ * @param function Callable taking V&.
+ * @return true if key found and function applied, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+template<typename Function>
+bool HashTable_t<K, V, Hash, Eq>::update(const KeyArg key, Function function) {
+    return update(key, hashOf(key), std::move(function));
+}
+
+/**
+ * @brief Modifies value stored using a given key with precomputed hash in place.
+ *
+ * Version of update for callers that have already hashed the key with hashOf.
+ *
+ * @param key Key to be searched.
+ * @param hashValue hashOf(key), computed by this table or one sharing its hash function.
+ * @param function Callable taking V&.
+ * @return true if key found and function applied, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+template<typename Function>
+bool HashTable_t<K, V, Hash, Eq>::update(const KeyArg key, const size_t hashValue, Function function) {
+    migrate(migrationStep);
+    HashTableBucket* const foundBucket = findBucket(key, hashValue);
+    if (foundBucket == nullptr) {
+        return false;
+    }
+    function(foundBucket->getValueRef());
+    return true;
+}
+
+/**
+ * @brief Insert key with a value constructed from arguments, if key is absent.
+ *
+ * Probes the key's sequence once, like insert. The value is only constructed if the key is inserted,
+ * so nothing is built (or copied) for a duplicate key.
+ *
+ * @param key of key-value pair to be inserted.
+ * @param valueArgs Arguments the value is constructed from.
+ *
+ * @return true if insertion successful, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+template<typename... Args>
+bool HashTable_t<K, V, Hash, Eq>::try_emplace(const K& key, Args&&... valueArgs) {
+    migrate(migrationStep);
+    const size_t hashValue = hashOf(key);
+    const InsertSlot slot = probeForInsert(key, hashValue);
+    if (slot.found != nullptr || slot.emptyIndex == NOT_FOUND) {
+        return false; // Return false if duplicate key found or table is full.
+    }
+    emplaceBucket(slot.emptyIndex, key, hashValue, std::forward<Args>(valueArgs)...);
+    if (alpha() >= threshold) { // Rehash if necessary.
+        rehash();
+    }
+    return true;
+}
+
+/**
+ * @brief Reference to value stored using a given key, inserting a default value if absent.
+ *
+ * The default-inserting counterpart of the subscript operator, with the semantics of std::unordered_map::operator[]:
+ * hashTable.getOrInsert("name") += 1 counts occurrences of "name" whether or not it was present.
+ * Probes the key's sequence once, and again only if the insertion makes the table rehash.
+ *
+ * @warning The reference is invalidated when the table is rehashed.
+ *
+ * @param key Key to be searched, and inserted if absent.
+ * @return Reference to value associated with key.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+V& HashTable_t<K, V, Hash, Eq>::getOrInsert(const K& key) {
+    migrate(migrationStep);
+    const size_t hashValue = hashOf(key);
+    const InsertSlot slot = probeForInsert(key, hashValue);
+    if (slot.found != nullptr) {
+        return slot.found->getValueRef();
+    }
+    if (slot.emptyIndex == NOT_FOUND) {
+        return badKeyDrain; // Should not be possible, since the table rehashes before it is full.
+    }
+    emplaceBucket(slot.emptyIndex, key, hashValue);
+    if (alpha() < threshold) {
+        return slotAt(tableData, slot.emptyIndex).getValueRef();
+    }
+    rehash();
+    return findBucket(key)->getValueRef(); // The key has moved to the new bucket arrays.
+}
+
+/**
+ * @brief Reserves capacity for a number of key-value pairs.
+ *
+ * Rehashes at most once, so that expectedElements pairs can be held without the load factor
+ * reaching the threshold. Does nothing if the table is already large enough; never shrinks the table.
+ *
+ * @param expectedElements Number of key-value pairs the table should hold without rehashing.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void HashTable_t<K, V, Hash, Eq>::reserve(const size_t expectedElements) {
+    const auto required = static_cast<size_t>(static_cast<double>(expectedElements) / threshold) + 1;
+    if (required > capacity()) {
+        rehash(required);
+    }
+}
+
+/**
+ * @brief Remove key-value pair from table.
+ *
+ * Searches for key using the helper method find, in the old bucket arrays as well during an incremental rehash.
+ * The bucket is marked EAR (tombstone), or ESS if it can be reclaimed, making its contents inaccessible.
+ * If the load factor then falls below shrinkThreshold, the table shrinks so that its load factor lies midway
+ * between the two thresholds; the gap on either side keeps alternating inserts and removals from resizing repeatedly.
+ * Otherwise, if tombstones make up at least tombstoneThreshold of the table, or removed keys at least half of
+ * the key arena (with ArenaString keys), the table is compacted.
+ *
+ * @param key Key to be searched.
+ * @return true if removal successful, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool HashTable_t<K, V, Hash, Eq>::remove(const KeyArg key) {
+    return remove(key, hashOf(key));
+}
+
+/**
+ * @brief Remove key-value pair with precomputed hash from table.
+ *
+ * Version of remove for callers that have already hashed the key with hashOf.
+ *
+ * @param key Key to be searched.
+ * @param hashValue hashOf(key), computed by this table or one sharing its hash function.
+ * @return true if removal successful, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool HashTable_t<K, V, Hash, Eq>::remove(const KeyArg key, const size_t hashValue) {
+    migrate(migrationStep);
+    if (!removeHashed(key, hashValue)) {
+        return false; // key is not present in table
+    }
+    resizeAfterRemoval();
+    return true;
+}
+
+/**
+ * @brief Remove a batch of key-value pairs from table.
+ *
+ * Hashes keys HASH_BLOCK at a time, then removes them in order while prefetching the home buckets of the keys
+ * PREFETCH_DISTANCE places ahead, so that the cache misses of several removals overlap.
+ * The table is shrunk or compacted, if necessary, once after the whole batch, and a batch counts
+ * as one operation towards an incremental rehash.
+ *
+ * @param keys Keys to be removed; missing and repeated keys are skipped.
+ * @return number of key-value pairs removed.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t HashTable_t<K, V, Hash, Eq>::remove_many(const std::span<const LookupKey> keys) {
+    migrate(migrationStep);
+    size_t numRemoved = 0;
+    forEachHashed(keys, [this, keys, &numRemoved](const size_t keyNum, const size_t hashValue) {
+        numRemoved += removeHashed(keys[keyNum], hashValue);
+    });
+    if (numRemoved != 0) {
+        resizeAfterRemoval();
+    }
+    return numRemoved;
+}
+
+/**
+ * @brief Remove key-value pair with precomputed hash from table.
+ *
+ * Private helper for remove and remove_many. Searches the new bucket arrays, then the old ones
+ * during an incremental rehash, but never shrinks or compacts the table.
+ *
+ * @param key Key to be searched.
+ * @param hashValue Full hash of key.
+ * @return true if removal successful, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool HashTable_t<K, V, Hash, Eq>::removeHashed(const KeyArg key, const size_t hashValue) {
+    if (const size_t foundIndex = find(key, hashValue); foundIndex != NOT_FOUND) {
+        vacateBucket(foundIndex);
+    }
+    else if (const size_t sourceIndex = migration.source ? migration.source->find(key, hashValue) : NOT_FOUND;
+    sourceIndex != NOT_FOUND) { // Remove key-value pair not yet migrated.
+        migration.source->vacateBucket(sourceIndex);
+    }
+    else {
+        return false; // key is not present in table
+    }
+    return true;
+}
+
+/**
+ * @brief Shrinks or compacts the table if removals have made it necessary.
+ *
+ * Shrinks the table if its load factor has fallen below shrinkThreshold, and otherwise compacts it
+ * if tombstones or removed arena keys have accumulated (see remove).
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void HashTable_t<K, V, Hash, Eq>::resizeAfterRemoval() {
+    if (alpha() < shrinkThreshold && capacity() > minCapacity) { // Shrink if necessary.
+        const double targetAlpha = (threshold + shrinkThreshold) / 2.0;
+        shrinkTo(std::max(static_cast<size_t>(static_cast<double>(size()) / targetAlpha) + 1, minCapacity));
+    }
+    else if (static_cast<double>(numTombstones) >= tombstoneThreshold * static_cast<double>(capacity())
+        || releasedKeyFraction() >= 0.5) { // Compact if necessary.
+        compact();
+    }
+}
+
+/**
+ * @brief Rehashes the table at its current capacity, clearing all tombstones.
+ *
+ * Called automatically by remove once tombstones reach tombstoneThreshold of the table,
+ * since tables under delete-heavy workloads may never grow, and so never otherwise drop their tombstones.
+ * With ArenaString keys, also moves the remaining keys into a new arena, releasing the characters of removed keys.
+ * Does nothing if the table holds no tombstones and no removed keys in its arena.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void HashTable_t<K, V, Hash, Eq>::compact() {
+    if (numTombstones != 0 || releasedKeyFraction() > 0.0) {
+        rehash(capacity());
+    }
+}
+
+/**
+ * @brief Rehashes the table to the smallest capacity that holds its key-value pairs.
+ *
+ * The new capacity is the one reserve would choose for the current size, so the next insertion
+ * does not immediately rehash. May shrink below the initial capacity. Does nothing if the table is already that small.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void HashTable_t<K, V, Hash, Eq>::shrink_to_fit() {
+    shrinkTo(static_cast<size_t>(static_cast<double>(size()) / threshold) + 1);
+}
+
+/**
+ * @brief Writes the table to a snapshot file.
+ *
+ * Writes a SnapshotHeader holding the configuration, probe parameters, hash seed, and counts of the table, followed by
+ * its control bytes and the cached hash, value, and key of every filled bucket in bucket order (see SnapshotHeader).
+ * String keys are packed into a key blob. Completes any incremental rehash first, so only one bucket array is saved.
+ * A snapshot can only be loaded by a program with the same key, value, and hash function types;
+ * std::hash is not guaranteed to agree between standard library implementations.
+ *
+ * @param path path of snapshot file, which is replaced if it exists
+ * @return true if the snapshot was written, false if the file could not be written.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool HashTable_t<K, V, Hash, Eq>::save(const std::filesystem::path& path) requires snapshotKeys {
+    migrate(NOT_FOUND);
+    SnapshotHeader header;
+    header.stringKeys = stringKeys;
+    header.keySize = stringKeys ? 0 : sizeof(K);
+    header.valueSize = sizeof(V);
+    header.cachedHashes = cachesHash;
+    header.capacity = capacity();
+    header.minCapacity = minCapacity;
+    header.numFilled = numFilled;
+    header.numTombstones = numTombstones;
+    header.threshold = threshold;
+    header.resizeFactor = resizeFactor;
+    header.tombstoneThreshold = tombstoneThreshold;
+    header.shrinkThreshold = shrinkThreshold;
+    header.migrationStep = migrationStep;
+    header.rehashThreads = rehashThreads;
+    header.probeMode = static_cast<uint32_t>(probeMode);
+    header.capacityPolicy = static_cast<uint32_t>(capacityPolicy);
+    header.probeMultiplier = probeMultiplier;
+    header.probeIncrement = probeIncrement;
+    if constexpr (SeededHash<Hash>) {
+        header.hashSeed = hash.seed();
+    }
+    std::vector<size_t> filledBuckets;
+    filledBuckets.reserve(numFilled);
+    for (size_t bucketNum = 0; bucketNum < capacity(); ++bucketNum) {
+        if (ControlByte::isFull(slotAt(control, bucketNum))) {
+            filledBuckets.push_back(bucketNum);
+            if constexpr (stringKeys) {
+                header.keyBlobSize += LookupKey(slotAt(tableData, bucketNum).getKey()).size();
+            }
+        }
+    }
+
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    if (!stream) {
+        return false;
+    }
+    const auto write = [&stream](const void* bytes, const size_t numBytes) {
+        stream.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(numBytes));
+    };
+    const auto alignSection = [&stream, &write] { // Pads the file to the start of the next section.
+        static constexpr char padding[SnapshotHeader::SECTION_ALIGNMENT] = {};
+        const auto position = static_cast<size_t>(stream.tellp());
+        write(padding, SnapshotHeader::align(position) - position);
+    };
+    write(&header, sizeof(header));
+    alignSection();
+    write(control.data(), control.size());
+    alignSection();
+    if constexpr (cachesHash) {
+        for (const size_t bucketNum : filledBuckets) {
+            const uint64_t hashValue = slotAt(tableData, bucketNum).getHash();
+            write(&hashValue, sizeof(hashValue));
+        }
+        alignSection();
+    }
+    for (const size_t bucketNum : filledBuckets) {
+        const V value = slotAt(tableData, bucketNum).getValue();
+        write(&value, sizeof(value));
+    }
+    alignSection();
+    if constexpr (stringKeys) {
+        uint64_t keyEnd = 0;
+        for (const size_t bucketNum : filledBuckets) { // End offset of every key within the key blob.
+            keyEnd += LookupKey(slotAt(tableData, bucketNum).getKey()).size();
+            write(&keyEnd, sizeof(keyEnd));
+        }
+        for (const size_t bucketNum : filledBuckets) {
+            const LookupKey key(slotAt(tableData, bucketNum).getKey());
+            write(key.data(), key.size());
+        }
+    }
+    else {
+        for (const size_t bucketNum : filledBuckets) {
+            write(&slotAt(tableData, bucketNum).getKey(), sizeof(K));
+        }
+    }
+    return static_cast<bool>(stream.flush());
+}
+
+/**
+ * @brief Restores a table from a snapshot file.
+ *
+ * The file is memory-mapped where mmap is available (see MappedFile). The control bytes are copied as they are,
+ * and every filled bucket is restored in place from the saved hash, value, and key, so nothing is hashed
+ * or reinserted. Tables with ArenaString keys copy no key characters either: their keys view the key blob
+ * of the mapped file, whose pages are shared between processes loading the same snapshot, and which stays
+ * mapped until the next rehash moves the keys into the table's own arena.
+ * A snapshot is rejected if its header does not match the key and value types of the table, if its parameters
+ * are out of range (a threshold outside (0, 1], a resize factor not above 1, or a minimum capacity above the capacity),
+ * if it is truncated, or if its control bytes are inconsistent. The number of rehash threads is capped at the number
+ * of hardware threads of the loading machine. The keys of the first filled buckets are hashed as a check
+ * that the hash function agrees with the one the snapshot was saved with.
+ * The loaded table draws new storage from inResource; its statistics start from zero.
+ *
+ * @param path path of snapshot file
+ * @param inResource Memory resource for the bucket arrays and key arena (default std::pmr::get_default_resource()).
+ * @return restored table, or nullopt if the file could not be read or is not a valid snapshot for this table type.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+std::optional<HashTable_t<K, V, Hash, Eq>> HashTable_t<K, V, Hash, Eq>::load(const std::filesystem::path& path,
+    std::pmr::memory_resource* const inResource) requires snapshotKeys {
+    static constexpr size_t NUM_HASH_CHECKS = 16; // Number of keys hashed to check the hash function.
+    const std::shared_ptr<const MappedFile> file = MappedFile::open(path);
+    if (!file || file->size() < sizeof(SnapshotHeader)) {
+        return std::nullopt;
+    }
+    SnapshotHeader header;
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (header.magic != SnapshotHeader::MAGIC || header.version != SnapshotHeader::VERSION || header.stringKeys != stringKeys
+        || header.keySize != (stringKeys ? 0 : sizeof(K)) || header.valueSize != sizeof(V) || header.cachedHashes != cachesHash
+        || header.probeMode > static_cast<uint32_t>(ProbeMode::DOUBLE_HASH)
+        || header.capacityPolicy > static_cast<uint32_t>(CapacityPolicy::EXACT)
+        || header.capacity == 0 || header.capacity > file->size() || header.numFilled + header.numTombstones > header.capacity
+        || (static_cast<CapacityPolicy>(header.capacityPolicy) == CapacityPolicy::POWER_OF_TWO && !std::has_single_bit(header.capacity))
+        || header.minCapacity > header.capacity) {
+        return std::nullopt;
+    }
+    // Negated comparisons, so that NaN parameters are rejected too.
+    if (!(header.threshold > 0.0 && header.threshold <= 1.0) || !(header.resizeFactor > 1.0) || !std::isfinite(header.resizeFactor)
+        || !(header.tombstoneThreshold >= 0.0 && header.tombstoneThreshold <= 1.0)
+        || !(header.shrinkThreshold >= 0.0 && header.shrinkThreshold <= header.threshold)) {
+        return std::nullopt;
+    }
+    const size_t rehashThreads = std::min(static_cast<size_t>(header.rehashThreads),
+        static_cast<size_t>(std::max(std::thread::hardware_concurrency(), 1U)));
+    const size_t controlOffset = SnapshotHeader::align(sizeof(header));
+    const size_t hashOffset = SnapshotHeader::align(controlOffset + header.capacity + NUM_MIRRORED);
+    const size_t valueOffset = cachesHash ? SnapshotHeader::align(hashOffset + header.numFilled * sizeof(uint64_t)) : hashOffset;
+    const size_t keyOffset = SnapshotHeader::align(valueOffset + header.numFilled * sizeof(V));
+    const size_t blobOffset = keyOffset + header.numFilled * (stringKeys ? sizeof(uint64_t) : sizeof(K));
+    if (header.keyBlobSize > file->size() || blobOffset + header.keyBlobSize > file->size()) {
+        return std::nullopt;
+    }
+
+    std::optional<HashTable_t> table(std::in_place, header.minCapacity, header.threshold, header.resizeFactor,
+        static_cast<ProbeMode>(header.probeMode), static_cast<CapacityPolicy>(header.capacityPolicy), header.tombstoneThreshold,
+        header.shrinkThreshold, header.migrationStep, rehashThreads, inResource);
+    const auto* const bytes = reinterpret_cast<const uint8_t*>(file->data());
+    table->control.assign(bytes + controlOffset, bytes + controlOffset + header.capacity + NUM_MIRRORED);
+    table->tableData.resize(header.capacity);
+    table->indexMask = header.capacity - 1;
+    table->probeMultiplier = header.probeMultiplier;
+    table->probeIncrement = header.probeIncrement;
+    if constexpr (SeededHash<Hash>) {
+        table->hash = Hash(header.hashSeed);
+    }
+    table->configureWindows();
+    for (size_t mirrorIndex = header.capacity; mirrorIndex < table->control.size(); ++mirrorIndex) {
+        if (slotAt(table->control, mirrorIndex) != slotAt(table->control, mirrorIndex % header.capacity)) {
+            return std::nullopt; // Mirrored bytes must repeat the first control bytes.
+        }
+    }
+
+    uint64_t keyStart = 0;
+    for (size_t bucketNum = 0, filledNum = 0; bucketNum < header.capacity; ++bucketNum) {
+        const uint8_t controlByte = slotAt(table->control, bucketNum);
+        if (controlByte == ControlByte::EAR) {
+            ++table->numTombstones;
+        }
+        if (!ControlByte::isFull(controlByte)) {
+            if (controlByte != ControlByte::ESS && controlByte != ControlByte::EAR) {
+                return std::nullopt;
+            }
+            continue;
+        }
+        if (filledNum == header.numFilled) {
+            return std::nullopt; // More filled buckets than the header records.
+        }
+        uint64_t hashValue = 0;
+        if constexpr (cachesHash) {
+            std::memcpy(&hashValue, bytes + hashOffset + filledNum * sizeof(uint64_t), sizeof(hashValue));
+        }
+        V value;
+        std::memcpy(&value, bytes + valueOffset + filledNum * sizeof(V), sizeof(V));
+        if constexpr (stringKeys) {
+            uint64_t keyEnd = 0;
+            std::memcpy(&keyEnd, bytes + keyOffset + filledNum * sizeof(uint64_t), sizeof(keyEnd));
+            if (keyEnd < keyStart || keyEnd > header.keyBlobSize) {
+                return std::nullopt;
+            }
+            slotAt(table->tableData, bucketNum).load(K(LookupKey(reinterpret_cast<const char*>(bytes + blobOffset + keyStart), keyEnd - keyStart)),
+                value, hashValue);
+            keyStart = keyEnd;
+        }
+        else {
+            K key;
+            std::memcpy(&key, bytes + keyOffset + filledNum * sizeof(K), sizeof(K));
+            slotAt(table->tableData, bucketNum).load(key, value, hashValue);
+        }
+        if (filledNum < NUM_HASH_CHECKS) {
+            const HashTableBucket& bucket = slotAt(table->tableData, bucketNum);
+            const size_t keyHash = table->hashOf(bucket.getKey());
+            if (ControlByte::fingerprint(keyHash) != controlByte || (cachesHash && table->storedHash(bucket) != keyHash)) {
+                return std::nullopt; // The hash function disagrees with the one the snapshot was saved with.
+            }
+        }
+        ++filledNum;
+        table->numFilled = filledNum;
+    }
+    if (table->numFilled != header.numFilled || table->numTombstones != header.numTombstones) {
+        return std::nullopt;
+    }
+    if constexpr (arenaKeys) {
+        table->keyArena.adopt(file, header.keyBlobSize); // Keys view the key blob of the mapped file.
+    }
+    return table;
+}
+
+/**
+ * @brief Time-complexity testing version of insert.
+ *
+ * Like insert, but returns number of probes required to either insert key-value pair
+ * or determine key is a duplicate or table is full.
+ * Also omits check for rehashing, and completes any incremental rehash first so that only one bucket array is probed.
+ * Buckets are counted one at a time in probe order, up to the deciding bucket of the last window examined,
+ * even though each window's control bytes are compared at once.
+ * Probes of the ordinary operations are measured by stats() instead, when HASHTABLE_ENABLE_STATS is defined.
+ *
+ * @param key of key-value pair to be inserted.
+ * @param value Value of key-value pair to be inserted.
+ *
+ * @return number of probes required for insertion.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t HashTable_t<K, V, Hash, Eq>::insertTCT(const K& key, const V& value) {
+    migrate(NOT_FOUND);
+    const size_t hashValue = hashOf(key);
+    const size_t home = homeIndex(hashValue);
+    const uint8_t fingerprint = ControlByte::fingerprint(hashValue);
+    size_t firstEmptyFound = NOT_FOUND;
+    ProbeSequence windows = probeSequence(hashValue);
+    for (size_t probesBefore = 0; windows != std::default_sentinel; probesBefore += windowWidth, ++windows) {
+        const size_t windowStart = bucketIndex(home, *windows * windowWidth);
+        const ControlGroup group(control.data() + windowStart);
+        const uint32_t essLanes = group.matchESS() & laneMask;
+        // Keys are never stored past the first ESS bucket of their probe sequence, so candidates after it cannot match.
+        for (uint32_t candidates = group.match(fingerprint) & laneMask; candidates != 0; candidates &= candidates - 1) {
+            const auto lane = static_cast<size_t>(std::countr_zero(candidates));
+            if (slotAt(tableData, laneIndex(windowStart, lane)).matches(hashValue, key, equal)) { // Stop searching if duplicate key found.
+                return probesBefore + lane + 1;
+            }
+        }
+        if (const uint32_t emptyLanes = group.matchEmpty() & laneMask;
+        firstEmptyFound == NOT_FOUND && emptyLanes != 0) { // Mark first empty (EAR or ESS) bucket found.
+            firstEmptyFound = laneIndex(windowStart, static_cast<size_t>(std::countr_zero(emptyLanes)));
+        }
+        if (essLanes != 0) { // If ESS bucket is encountered, insert into first empty bucket found during search.
+            fillBucket(firstEmptyFound, key, value, hashValue);
+            return probesBefore + static_cast<size_t>(std::countr_zero(essLanes)) + 1;
+        }
+    }
+    if (firstEmptyFound != NOT_FOUND) { // Insert at first EAR bucket encountered if all empty buckets are tombstones.
+        fillBucket(firstEmptyFound, key, value, hashValue);
+    }
+    return capacity(); // Return table capacity if table is full.
+}
+
+/**
+ * @brief Time-complexity testing version of remove.
+ *
+ * Like remove, but returns number of probes required to
+ * either insert key-value pair or determine key is not in the table.
+ * Completes any incremental rehash first, and never shrinks or compacts the table.
+ *
+ * @param key Key to be searched.
+ * @return number of probes required for removal.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t HashTable_t<K, V, Hash, Eq>::removeTCT(const KeyArg key) {
+    migrate(NOT_FOUND);
+    const size_t hashValue = hashOf(key);
+    const size_t home = homeIndex(hashValue);
+    const uint8_t fingerprint = ControlByte::fingerprint(hashValue);
+    ProbeSequence windows = probeSequence(hashValue);
+    for (size_t probesBefore = 0; windows != std::default_sentinel; probesBefore += windowWidth, ++windows) {
+        const size_t windowStart = bucketIndex(home, *windows * windowWidth);
+        const ControlGroup group(control.data() + windowStart);
+        // Tombstones and buckets with other fingerprints never match, so only candidate buckets are compared.
+        for (uint32_t candidates = group.match(fingerprint) & laneMask; candidates != 0; candidates &= candidates - 1) {
+            const auto lane = static_cast<size_t>(std::countr_zero(candidates));
+            if (const size_t currIndex = laneIndex(windowStart, lane);
+            slotAt(tableData, currIndex).matches(hashValue, key, equal)) { // Remove key-value pair if found.
+                vacateBucket(currIndex);
+                return probesBefore + lane + 1;
+            }
+        }
+        if (const uint32_t essLanes = group.matchESS() & laneMask;
+        essLanes != 0) { // If ESS bucket is reached, key cannot be present in table.
+            return probesBefore + static_cast<size_t>(std::countr_zero(essLanes)) + 1;
+        }
+    }
+    return capacity(); //Will only be reached if the key is not present and the table is full or all empty buckets are tombstones.
+}
+
+/**
+ * @brief Insert key-value pair with precomputed hash into table.
+ *
+ * Private helper for insert and batch insert. Identical in search behaviour to insert,
+ * but never rehashes; callers are responsible for checking the load factor.
+ * During an incremental rehash, migrates migrationStep old buckets first and rejects keys not yet migrated as duplicates.
+ *
+ * @param key of key-value pair to be inserted.
+ * @param value Value of key-value pair to be inserted.
+ * @param hashValue Full hash of key.
+ *
+ * @return true if insertion successful, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool HashTable_t<K, V, Hash, Eq>::insertHashed(const K& key, const V& value, const size_t hashValue) {
+    migrate(migrationStep);
+    if (const InsertSlot slot = probeForInsert(key, hashValue); slot.found == nullptr && slot.emptyIndex != NOT_FOUND) {
+        fillBucket(slot.emptyIndex, key, value, hashValue); // Insert into first empty bucket encountered during search.
+        return true;
+    }
+    return false; // Return false if duplicate key found or table is full.
+}
+
+/**
+ * @brief Finds a key, or the bucket it would be inserted into.
+ *
+ * Private helper for the insertion methods, which all probe a key's sequence once.
+ * Searches for the key like find, while marking the first empty (EAR or ESS) bucket passed,
+ * so that an absent key can be inserted there without probing again.
+ * During an incremental rehash, the old bucket arrays are searched as well; keys found there stay in place.
+ *
+ * @param key Key to be searched.
+ * @param hashValue Full hash of key.
+ * @return bucket holding key if present, and first empty bucket on its probe path otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+typename HashTable_t<K, V, Hash, Eq>::InsertSlot HashTable_t<K, V, Hash, Eq>::probeForInsert(const KeyArg key, const size_t hashValue) {
+    if (migration.source) {
+        if (const size_t sourceIndex = migration.source->find(key, hashValue); sourceIndex != NOT_FOUND) {
+            return {&slotAt(migration.source->tableData, sourceIndex), NOT_FOUND}; // Key is present in the old bucket arrays.
+        }
+    }
+    const size_t home = homeIndex(hashValue);
+    const uint8_t fingerprint = ControlByte::fingerprint(hashValue);
+    size_t firstEmptyFound = NOT_FOUND;
+    ProbeTally<HASHTABLE_STATS> tally;
+    for (const size_t window : probeSequence(hashValue)) {
+        const size_t windowStart = bucketIndex(home, window * windowWidth);
+        const ControlGroup group(control.data() + windowStart);
+        tally.count(group, laneMask);
+        for (uint32_t candidates = group.match(fingerprint) & laneMask; candidates != 0; candidates &= candidates - 1) {
+            if (const size_t currIndex = laneIndex(windowStart, static_cast<size_t>(std::countr_zero(candidates)));
+            slotAt(tableData, currIndex).matches(hashValue, key, equal)) { // Stop searching if duplicate key found.
+                counters.recordSearch(true, tally);
+                return {&slotAt(tableData, currIndex), NOT_FOUND};
+            }
+        }
+        if (const uint32_t emptyLanes = group.matchEmpty() & laneMask;
+        firstEmptyFound == NOT_FOUND && emptyLanes != 0) { // Mark first empty (EAR or ESS) bucket found.
+            firstEmptyFound = laneIndex(windowStart, static_cast<size_t>(std::countr_zero(emptyLanes)));
+        }
+        if ((group.matchESS() & laneMask) != 0) { // If ESS bucket is encountered, the key is not a duplicate.
+            break;
+        }
+    }
+    counters.recordSearch(false, tally);
+    return {nullptr, firstEmptyFound};
+}
+
+/**
+ * @brief Rehashes the table, increasing its size.
+ *
+ * Increases the size of hash table by resizeFactor and reinserts all key-value pairs
+ * from the older version of the table.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void HashTable_t<K, V, Hash, Eq>::rehash() {
+    // Capacity must grow by at least one bucket.
+    rehash(std::max(static_cast<size_t>(static_cast<double>(capacity()) * resizeFactor), capacity() + 1));
+}
+
+/**
+ * @brief Rehashes the table to a given capacity.
+ *
+ * Reinserts all key-value pairs into a table of at least newCapacity buckets (rounded according to the capacity policy).
+ * The hash cached in each bucket is reused where available, so no string key is hashed again.
+ * Keys are moved rather than copied into the new bucket array, which then replaces the old one.
+ * In incremental mode, the empty new arrays replace the old ones at once, and the old ones are kept for migration instead.
+ * Any earlier incremental rehash still in progress is completed first.
+ * Each call counts as one rehash in the statistics of the table, timed from after that completion.
+ * Otherwise, a table large enough to give several threads MIN_BUCKETS_PER_THREAD buckets each
+ * is rehashed by up to rehashThreads threads (see moveIntoNewTable). Tables with ArenaString keys always rehash
+ * on one thread, since every key is stored in the one arena of the new table.
+ *
+ * @param newCapacity Requested capacity; must be large enough to hold every key-value pair.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void HashTable_t<K, V, Hash, Eq>::rehash(const size_t newCapacity) {
+    migrate(NOT_FOUND);
+    counters.countRehash();
+    [[maybe_unused]] const auto timer = counters.timeRehash(); // Any migration still in progress was timed by migrate.
+    // New random probe parameters are drawn during construction. Keys keep their hashes, so the hash function is shared.
+    HashTable_t newTable(newCapacity, threshold, resizeFactor, probeMode, capacityPolicy, tombstoneThreshold, shrinkThreshold,
+        migrationStep, rehashThreads, memoryResource(), hash);
+    if (migrationStep != 0 && numFilled != 0) { // Start an incremental rehash.
+        swapStorage(newTable);
+        migration.source = std::make_unique<HashTable_t>(std::move(newTable));
+        migration.cursor = 0;
+        return;
+    }
+    if (const size_t numThreads = arenaKeys ? 1 : std::min(rehashThreads, capacity() / MIN_BUCKETS_PER_THREAD); numThreads > 1) {
+        moveIntoNewTable(newTable, numThreads);
+        swapStorage(newTable);
+        return;
+    }
+    for (size_t bucketNum = 0; bucketNum < capacity(); ++bucketNum) {
+        if (ControlByte::isFull(slotAt(control, bucketNum))) {
+            HashTableBucket& currBucket = slotAt(tableData, bucketNum);
+            newTable.insertIntoNewTable(currBucket.releaseKey(),currBucket.getValueRef(),storedHash(currBucket)); // Move key-value pair into new table.
+        }
+        // Stop searching for filled buckets if all filled buckets from old table version have been copied.
+        if (this->numFilled == newTable.numFilled) {
+            break;
+        }
+    }
+    swapStorage(newTable);
+}
+
+/**
+ * @brief Moves a number of old buckets over during an incremental rehash.
+ *
+ * Buckets of the old arrays are visited in index order, starting where the previous call stopped.
+ * Each filled one has its key-value pair moved into the new arrays (no duplicate check is needed, as every key
+ * is in exactly one of the two) and is then emptied, so its key's storage is released right away.
+ * Once no filled buckets remain, the old arrays are freed and the rehash is complete,
+ * and the statistics of their searches are added to those of the table. Each call adds to the rehash time.
+ * Does nothing if no incremental rehash is in progress.
+ *
+ * @param numBuckets Number of old buckets to visit (NOT_FOUND to complete the rehash).
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void HashTable_t<K, V, Hash, Eq>::migrate(const size_t numBuckets) {
+    if (!migration.source) {
+        return;
+    }
+    [[maybe_unused]] const auto timer = counters.timeRehash();
+    HashTable_t& source = *migration.source;
+    const size_t stop = migration.cursor + std::min(numBuckets, source.capacity() - migration.cursor);
+    for (; migration.cursor < stop && source.numFilled != 0; ++migration.cursor) {
+        if (ControlByte::isFull(slotAt(source.control, migration.cursor))) {
+            HashTableBucket& currBucket = slotAt(source.tableData, migration.cursor);
+            insertIntoNewTable(currBucket.releaseKey(),currBucket.getValueRef(),source.storedHash(currBucket)); // Move key-value pair into new arrays.
+            source.vacateBucket(migration.cursor);
+        }
+    }
+    if (source.numFilled == 0) { // All key-value pairs have been migrated.
+        counters.merge(source.counters); // Keep the searches of the old arrays.
+        migration.source.reset();
+    }
+}
+
+/**
+ * @brief Exchanges bucket arrays and their layout with another table.
+ *
+ * Swaps the control bytes, buckets, key arena, indexing and probing parameters, and the filled and tombstone counts;
+ * the configuration (thresholds, policies, migration step) of both tables is left as is.
+ *
+ * @param other Table with the same configuration.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void HashTable_t<K, V, Hash, Eq>::swapStorage(HashTable_t& other) {
+    std::swap(control, other.control);
+    std::swap(tableData, other.tableData);
+    std::swap(keyArena, other.keyArena);
+    std::swap(indexMask, other.indexMask);
+    std::swap(windowWidth, other.windowWidth);
+    std::swap(numWindows, other.numWindows);
+    std::swap(laneMask, other.laneMask);
+    std::swap(probeMultiplier, other.probeMultiplier);
+    std::swap(probeIncrement, other.probeIncrement);
+    std::swap(numFilled, other.numFilled);
+    std::swap(numTombstones, other.numTombstones);
+}
+
+/**
+ * @brief Rehashes the table to a smaller capacity, if a given requirement allows it.
+ *
+ * The required capacity is rounded according to the capacity policy; the table is rehashed only if the result
+ * is smaller than the current capacity.
+ *
+ * @param required Requested capacity; must be large enough to hold every key-value pair below the load factor threshold.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void HashTable_t<K, V, Hash, Eq>::shrinkTo(const size_t required) {
+    if (const size_t newCapacity = roundCapacity(required, capacityPolicy); newCapacity < capacity()) {
+        rehash(newCapacity);
+    }
+}
+
+/**
+ * @brief Stores key-value pair in an empty bucket.
+ *
+ * Writes the key's fingerprint to the control byte array and updates the filled and tombstone counts.
+ * ArenaString keys have their characters copied into the arena of the table first.
+ *
+ * @param index Index of an ESS or EAR bucket.
+ * @param key of key-value pair to be stored.
+ * @param value Value of key-value pair to be stored.
+ * @param hashValue Full hash of key.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void HashTable_t<K, V, Hash, Eq>::fillBucket(const size_t index, K key, const V& value, const size_t hashValue) {
+    emplaceBucket(index, std::move(key), hashValue, value);
+}
+
+/**
+ * @brief Stores key and a value constructed from arguments in an empty bucket.
+ *
+ * Version of fillBucket for try_emplace and getOrInsert, which only construct the value once the key is known to be absent.
+ *
+ * @param index Index of an ESS or EAR bucket.
+ * @param key of key-value pair to be stored.
+ * @param hashValue Full hash of key.
+ * @param valueArgs Arguments the value is constructed from.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+template<typename... Args>
+void HashTable_t<K, V, Hash, Eq>::emplaceBucket(const size_t index, K key, const size_t hashValue, Args&&... valueArgs) {
+    if (slotAt(control, index) == ControlByte::EAR) {
+        --numTombstones;
+    }
+    if constexpr (arenaKeys) {
+        key = keyArena.store(key);
+    }
+    slotAt(tableData, index).emplace(std::move(key),hashValue,std::forward<Args>(valueArgs)...);
+    setControl(index, ControlByte::fingerprint(hashValue));
+    ++numFilled;
+}
+
+/**
+ * @brief Empties a filled bucket, leaving a tombstone if necessary.
+ *
+ * The bucket is marked ESS if it can be reclaimed (see canReclaim), and EAR otherwise.
+ * The characters of an ArenaString key are recorded as released in the key arena.
+ *
+ * @param index Index of a filled bucket.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void HashTable_t<K, V, Hash, Eq>::vacateBucket(const size_t index) {
+    if constexpr (arenaKeys) {
+        keyArena.release(slotAt(tableData, index).getKey());
+    }
+    if (canReclaim(index)) {
+        setControl(index, ControlByte::ESS);
+    }
+    else {
+        setControl(index, ControlByte::EAR);
+        ++numTombstones;
+    }
+    --numFilled;
+}
+
+/**
+ * @brief Predicate for if a bucket can be emptied without leaving a tombstone.
+ *
+ * A tombstone is only needed if some probe could pass through the bucket and continue to later windows,
+ * i.e. if some window of GROUP_WIDTH buckets containing it holds no ESS bucket. Such a window exists exactly when
+ * the run of non-ESS buckets around the bucket is at least GROUP_WIDTH long, which is measured from the ESS bitmasks
+ * of the window ending just before the bucket and the window starting at it.
+ * If every window containing the bucket holds an ESS bucket, every probe reaching it stops in that window anyway,
+ * so marking it ESS changes no search. Only applies when probing uses windows of GROUP_WIDTH buckets.
+ *
+ * @param index Index of a filled bucket.
+ * @return true if bucket may be marked ESS, false if it must be marked EAR.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool HashTable_t<K, V, Hash, Eq>::canReclaim(const size_t index) const {
+    if (windowWidth != ControlGroup::GROUP_WIDTH || capacity() < ControlGroup::GROUP_WIDTH) {
+        return false;
+    }
+    const size_t before = bucketIndex(index, capacity() - ControlGroup::GROUP_WIDTH);
+    const uint32_t essAfter = ControlGroup(control.data() + index).matchESS();
+    const auto essBefore = static_cast<uint16_t>(ControlGroup(control.data() + before).matchESS());
+    return essAfter != 0 && essBefore != 0
+        && static_cast<size_t>(std::countr_zero(essAfter) + std::countl_zero(essBefore)) < ControlGroup::GROUP_WIDTH;
+}
+
+/**
+ * @brief Fraction of the key arena held by the characters of removed keys.
+ *
+ * Removed buckets may be reclaimed without a tombstone, so tombstones alone do not show how much of the arena is unused.
+ * Always 0 unless keys are ArenaString.
+ *
+ * @return released characters as a fraction of the characters allocated by the arena.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+double HashTable_t<K, V, Hash, Eq>::releasedKeyFraction() const {
+    if constexpr (arenaKeys) {
+        return keyArena.capacity() == 0 ? 0.0 : static_cast<double>(keyArena.released()) / static_cast<double>(keyArena.capacity());
+    }
+    else {
+        return 0.0;
+    }
+}
+
+/**
+ * @brief Insert key-value pair into a new table during rehashing.
+ *
+ * Simplified private helper version of the insert method for the case where key-value pairs are
+ * being inserted into a new table during rehashing, or into the new arrays during an incremental rehash.
+ * The check for duplicates and resizing the table are unnecessary, and elements may be inserted
+ * at the first empty bucket found.
+ *
+ * @param key of key-value pair to be inserted (moved into the new table).
+ * @param value Value of key-value pair to be inserted.
+ * @param hashValue Cached full hash of key.
+ *
+ * @return true if insertion successful, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool HashTable_t<K, V, Hash, Eq>::insertIntoNewTable(K&& key, const V& value, const size_t hashValue) {
+    const size_t home = homeIndex(hashValue);
+    for (const size_t window : probeSequence(hashValue)) {
+        const size_t windowStart = bucketIndex(home, window * windowWidth);
+        if (const uint32_t emptyLanes = ControlGroup(control.data() + windowStart).matchEmpty() & laneMask;
+        emptyLanes != 0) { // The key cannot be a duplicate, so the first empty bucket may take it.
+            const size_t currIndex = laneIndex(windowStart, static_cast<size_t>(std::countr_zero(emptyLanes)));
+            fillBucket(currIndex, std::move(key), value, hashValue);
+            return true;
+        }
+    }
+    return false; // Should not be possible if resizeFactor is greater than 1.
+}
+
+/**
+ * @brief Moves every key-value pair into a new table using several threads.
+ *
+ * The old bucket array is split into numThreads contiguous ranges, each drained by its own thread.
+ * Threads insert into the shared new arrays with claimInNewTable, which takes buckets by atomic compare-and-swap
+ * on their control bytes, so no two threads fill the same bucket and no locks are taken.
+ * The filled count and the mirrored control bytes of the new table are brought up to date once all threads have joined.
+ *
+ * @param newTable Empty table with room for every key-value pair of this one.
+ * @param numThreads Number of threads to be used.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void HashTable_t<K, V, Hash, Eq>::moveIntoNewTable(HashTable_t& newTable, const size_t numThreads) {
+    std::vector<size_t> numMoved(numThreads, 0);
+    std::vector<std::thread> workers;
+    workers.reserve(numThreads);
+    for (size_t worker = 0; worker < numThreads; ++worker) {
+        workers.emplace_back([this, &newTable, &numMoved, worker, numThreads] {
+            const size_t first = capacity() / numThreads * worker + std::min(worker, capacity() % numThreads);
+            const size_t last = first + capacity() / numThreads + (worker < capacity() % numThreads ? 1 : 0);
+            size_t moved = 0; // Counted locally, so that threads do not share a cache line while moving.
+            for (size_t bucketNum = first; bucketNum < last; ++bucketNum) {
+                if (ControlByte::isFull(slotAt(control, bucketNum))) {
+                    HashTableBucket& currBucket = slotAt(tableData, bucketNum);
+                    moved += newTable.claimInNewTable(currBucket.releaseKey(),currBucket.getValueRef(),storedHash(currBucket)) ? 1 : 0;
+                }
+            }
+            numMoved.at(worker) = moved;
+        });
+    }
+    for (std::thread& workerThread : workers) {
+        workerThread.join();
+    }
+    for (const size_t moved : numMoved) {
+        newTable.numFilled += moved;
+    }
+    for (size_t index = 0; index < std::min(NUM_MIRRORED, newTable.capacity()); ++index) { // Mirrors were not written by the threads.
+        newTable.setControl(index, slotAt(newTable.control, index));
+    }
+}
+
+/**
+ * @brief Insert key-value pair into a new table filled by several threads at once.
+ *
+ * Version of insertIntoNewTable that may run concurrently with itself on the same table.
+ * Buckets are visited one at a time in the same order as insertIntoNewTable, and the first ESS bucket is claimed
+ * by atomically exchanging its control byte for the key's fingerprint. Buckets only ever go from ESS to filled,
+ * so every bucket passed over stays filled, and the key is found by an ordinary probe afterwards.
+ * Only the control bytes of the buckets themselves are touched; the filled count and mirrored control bytes
+ * are left to the caller (see moveIntoNewTable).
+ *
+ * @param key of key-value pair to be inserted (moved into the new table).
+ * @param value Value of key-value pair to be inserted.
+ * @param hashValue Cached full hash of key.
+ *
+ * @return true if insertion successful, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool HashTable_t<K, V, Hash, Eq>::claimInNewTable(K&& key, const V& value, const size_t hashValue) {
+    const size_t home = homeIndex(hashValue);
+    for (const size_t window : probeSequence(hashValue)) {
+        const size_t windowStart = bucketIndex(home, window * windowWidth);
+        for (uint32_t lanes = laneMask; lanes != 0; lanes &= lanes - 1) {
+            const size_t currIndex = laneIndex(windowStart, static_cast<size_t>(std::countr_zero(lanes)));
+            std::atomic_ref<uint8_t> currControl(slotAt(control, currIndex));
+            // The bucket itself is published to other threads by joining them, so no ordering is needed here.
+            if (uint8_t expected = ControlByte::ESS; currControl.load(std::memory_order_relaxed) == ControlByte::ESS
+                && currControl.compare_exchange_strong(expected, ControlByte::fingerprint(hashValue), std::memory_order_relaxed)) {
+                slotAt(tableData, currIndex).load(std::move(key),value,hashValue);
+                return true;
+            }
+        }
+    }
+    return false; // Should not be possible if resizeFactor is greater than 1.
+}
+
+
+/**
+ * @brief Find index of bucket containing key.
+ *
+ * Private helper method for pseudo-random probing.
+ * Only the control byte array is read until a bucket with a matching fingerprint is found,
+ * so empty buckets, tombstones, and most non-matching keys are skipped without touching key storage.
+ * Returns the index of the bucket with the key if the search is successful.
+ * Returns NOT_FOUND if the key is not present in the hash table.
+ *
+ * Only the bucket arrays of this table are searched, not those being migrated from.
+ * Every search is recorded in the statistics of the table (see stats()).
+ *
+ * @param key Key to be searched.
+ * @param hashValue Full hash of key.
+ * @return Index of found bucket, or NOT_FOUND.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t HashTable_t<K, V, Hash, Eq>::find(const KeyArg key, const size_t hashValue) const {
+    const size_t home = homeIndex(hashValue);
+    const uint8_t fingerprint = ControlByte::fingerprint(hashValue);
+    ProbeTally<HASHTABLE_STATS> tally;
+    for (const size_t window : probeSequence(hashValue)) {
+        const size_t windowStart = bucketIndex(home, window * windowWidth);
+        const ControlGroup group(control.data() + windowStart);
+        tally.count(group, laneMask);
+        // Tombstones and buckets with other fingerprints never match, so only candidate buckets are compared.
+        for (uint32_t candidates = group.match(fingerprint) & laneMask; candidates != 0; candidates &= candidates - 1) {
+            if (const size_t currIndex = laneIndex(windowStart, static_cast<size_t>(std::countr_zero(candidates)));
+            slotAt(tableData, currIndex).matches(hashValue, key, equal)) { // Return bucket index if key found.
+                counters.recordSearch(true, tally);
+                return currIndex;
+            }
+        }
+        if ((group.matchESS() & laneMask) != 0) { // If ESS bucket is reached, key cannot be present in table.
+            counters.recordSearch(false, tally);
+            return NOT_FOUND;
+        }
+    }
+    counters.recordSearch(false, tally);
+    return NOT_FOUND; //Will only be reached if the key is not present and the table is full or all empty buckets are tombstones.
+}
+
+/**
+ * @brief Find bucket containing key in the new or old bucket arrays.
+ *
+ * Private helper for lookups. Hashes the key once and searches the new bucket arrays,
+ * then, during an incremental rehash, the old ones.
+ *
+ * @param key Key to be searched.
+ * @return Pointer to found bucket, or nullptr.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+typename HashTable_t<K, V, Hash, Eq>::HashTableBucket* HashTable_t<K, V, Hash, Eq>::findBucket(const KeyArg key) {
+    return findBucket(key, hashOf(key));
+}
+
+/**
+ * @brief Find bucket containing key with precomputed hash.
+ *
+ * Version of findBucket for batched lookups, which hash all of their keys in advance.
+ *
+ * @param key Key to be searched.
+ * @param hashValue Full hash of key.
+ * @return Pointer to found bucket, or nullptr.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+typename HashTable_t<K, V, Hash, Eq>::HashTableBucket* HashTable_t<K, V, Hash, Eq>::findBucket(const KeyArg key, const size_t hashValue) {
+    return const_cast<HashTableBucket*>(std::as_const(*this).findBucket(key, hashValue));
+}
+
+/**
+ * @brief Find bucket containing key with precomputed hash, without modifying it.
+ *
+ * Shared by the const and non-const lookups; searches the new bucket arrays, then the old ones during an incremental rehash.
+ *
+ * @param key Key to be searched.
+ * @param hashValue Full hash of key.
+ * @return Pointer to found bucket, or nullptr.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+const typename HashTable_t<K, V, Hash, Eq>::HashTableBucket* HashTable_t<K, V, Hash, Eq>::findBucket(const KeyArg key, const size_t hashValue) const {
+    if (const size_t foundIndex = find(key, hashValue); foundIndex != NOT_FOUND) {
+        return &slotAt(tableData, foundIndex);
+    }
+    if (migration.source) {
+        if (const size_t sourceIndex = migration.source->find(key, hashValue); sourceIndex != NOT_FOUND) {
+            return &slotAt(migration.source->tableData, sourceIndex);
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Prefetches the home control bytes and bucket of a key with given hash.
+ *
+ * Most probes end in the home window, so these two cache lines are usually all a lookup reads
+ * besides the key itself. A hint only; does nothing where the compiler offers no prefetch intrinsic.
+ *
+ * @param hashValue Full hash of key about to be looked up.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void HashTable_t<K, V, Hash, Eq>::prefetch(const size_t hashValue) const {
+#if defined(__GNUC__) || defined(__clang__)
+    const size_t home = homeIndex(hashValue);
+    __builtin_prefetch(control.data() + home);
+    __builtin_prefetch(tableData.data() + home);
+#elif defined(HASHTABLE_GROUP_SSE2)
+    const size_t home = homeIndex(hashValue);
+    _mm_prefetch(reinterpret_cast<const char*>(control.data() + home), _MM_HINT_T0);
+    _mm_prefetch(reinterpret_cast<const char*>(tableData.data() + home), _MM_HINT_T0);
+#else
+    (void)hashValue;
+#endif
+}
+
+/**
+ * @brief Calls a function with the hash of every key of a batch, prefetching ahead.
+ *
+ * Keys are processed in blocks of HASH_BLOCK. Every key of a block is hashed into a buffer on the stack
+ * before any is probed, so that hashing does not stall behind cache misses and batches of any size never allocate.
+ * The first PREFETCH_DISTANCE keys of a block are prefetched together, then each key PREFETCH_DISTANCE places
+ * ahead of the one passed to function.
+ *
+ * @param keys Keys to be hashed.
+ * @param function function called with every key in order, as function(size_t keyNum, size_t hashValue)
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+template<typename Function>
+void HashTable_t<K, V, Hash, Eq>::forEachHashed(const std::span<const LookupKey> keys, Function function) const {
+    size_t hashValues[HASH_BLOCK];
+    for (size_t blockStart = 0; blockStart < keys.size(); blockStart += HASH_BLOCK) {
+        const size_t blockSize = std::min(HASH_BLOCK, keys.size() - blockStart);
+        for (size_t blockNum = 0; blockNum < blockSize; ++blockNum) {
+            hashValues[blockNum] = hashOf(keys[blockStart + blockNum]);
+        }
+        for (size_t blockNum = 0; blockNum < std::min(PREFETCH_DISTANCE, blockSize); ++blockNum) {
+            prefetch(hashValues[blockNum]);
+        }
+        for (size_t blockNum = 0; blockNum < blockSize; ++blockNum) {
+            if (blockNum + PREFETCH_DISTANCE < blockSize) {
+                prefetch(hashValues[blockNum + PREFETCH_DISTANCE]);
+            }
+            function(blockStart + blockNum, hashValues[blockNum]);
+        }
+    }
+}
+
+/**
+ * @brief Sets the control byte of a bucket.
+ *
+ * The first NUM_MIRRORED control bytes are also written to their mirrors past the end of the table
+ * (repeatedly, if the table is smaller than NUM_MIRRORED), so a window may be loaded at any bucket.
+ *
+ * @param index Index of bucket.
+ * @param byte New control byte (a fingerprint, ESS, or EAR).
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void HashTable_t<K, V, Hash, Eq>::setControl(const size_t index, const uint8_t byte) {
+    slotAt(control, index) = byte;
+    if (index < NUM_MIRRORED) {
+        for (size_t mirrorIndex = index + capacity(); mirrorIndex < control.size(); mirrorIndex += capacity()) {
+            slotAt(control, mirrorIndex) = byte;
+        }
+    }
+}
+
+/**
+ * @brief Home bucket for a key with given hash.
+ *
+ * The low 7 bits of the hash form the control byte fingerprint, so the home bucket is taken from the high bits:
+ * the hash is mapped onto [0, capacity) with Lemire's multiply-shift reduction (fastrange), which avoids integer division.
+ * Under the POWER_OF_TWO capacity policy, this selects the top log2(capacity) bits of the hash.
+ *
+ * @param hashValue Mixed hash of the key being probed (see hashOf).
+ * @return index of home bucket.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+HASHTABLE_INLINE size_t HashTable_t<K, V, Hash, Eq>::homeIndex(const size_t hashValue) const {
+    return static_cast<size_t>(mulhi64(hashValue, capacity()));
+}
+
+/**
+ * @brief Index of bucket at given offset from home bucket.
+ *
+ * Both home and offset are less than the capacity, so under the EXACT policy
+ * a single conditional subtraction replaces the modulo.
+ *
+ * @param home Index of home bucket.
+ * @param offset Offset produced by the probe sequence.
+ * @return index of probed bucket.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+HASHTABLE_INLINE size_t HashTable_t<K, V, Hash, Eq>::bucketIndex(const size_t home, const size_t offset) const {
+    if (capacityPolicy == CapacityPolicy::POWER_OF_TWO) {
+        return (home + offset) & indexMask;
+    }
+    const size_t index = home + offset;
+    return index >= capacity() ? index - capacity() : index;
+}
+
+/**
+ * @brief Index of bucket in given lane of a probe window.
+ *
+ * Lanes past the end of the table read mirrored control bytes and wrap around to the first buckets.
+ * Only tables smaller than GROUP_WIDTH may wrap more than once.
+ *
+ * @param windowStart Index of first bucket of the window.
+ * @param lane Position within the window.
+ * @return index of bucket.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+HASHTABLE_INLINE size_t HashTable_t<K, V, Hash, Eq>::laneIndex(const size_t windowStart, const size_t lane) const {
+    if (capacityPolicy == CapacityPolicy::POWER_OF_TWO) {
+        return (windowStart + lane) & indexMask;
+    }
+    size_t index = windowStart + lane;
+    while (index >= capacity()) {
+        index -= capacity();
+    }
+    return index;
+}
+
+/**
+ * @brief Sets the probe window layout for the current capacity.
+ *
+ * Windows of GROUP_WIDTH buckets are used when they tile the table (capacity a multiple of GROUP_WIDTH),
+ * so that the probe sequence over windows visits every bucket exactly once.
+ * A table smaller than GROUP_WIDTH is covered by a single window starting at the home bucket.
+ * Otherwise (only possible under the EXACT policy) each window is a single bucket, probed as before.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void HashTable_t<K, V, Hash, Eq>::configureWindows() {
+    if (capacity() < ControlGroup::GROUP_WIDTH) {
+        windowWidth = ControlGroup::GROUP_WIDTH;
+        numWindows = 1;
+    }
+    else {
+        windowWidth = capacity() % ControlGroup::GROUP_WIDTH == 0 ? ControlGroup::GROUP_WIDTH : 1;
+        numWindows = capacity() / windowWidth;
+    }
+    laneMask = (static_cast<uint32_t>(1) << windowWidth) - 1;
+}
+
+/**
+ * @brief Rounds a requested capacity according to a capacity policy.
+ *
+ * The result is at least 1 so that a table always has a home bucket.
+ *
+ * @param requested Requested number of buckets.
+ * @param policy Capacity policy to be applied.
+ * @return number of buckets to allocate.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t HashTable_t<K, V, Hash, Eq>::roundCapacity(const size_t requested, const CapacityPolicy policy) {
+    const size_t atLeastOne = std::max(requested, static_cast<size_t>(1));
+    return policy == CapacityPolicy::POWER_OF_TWO ? std::bit_ceil(atLeastOne) : atLeastOne;
+}
+
+/**
+ * @brief Index of the first filled bucket in a range of buckets.
+ *
+ * Compares GROUP_WIDTH control bytes at a time, which the mirrored bytes past the end of the table keep readable
+ * at every index; lanes past the end of the range are ignored.
+ *
+ * @param index first bucket of range
+ * @param last end of range (at most the capacity)
+ * @return index of first filled bucket at or after index, or last if there is none before it.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t HashTable_t<K, V, Hash, Eq>::nextFilled(size_t index, const size_t last) const {
+    for (; index < last; index += ControlGroup::GROUP_WIDTH) {
+        uint32_t filledLanes = ControlGroup(control.data() + index).matchFull();
+        if (const size_t remaining = last - index; remaining < ControlGroup::GROUP_WIDTH) {
+            filledLanes &= (static_cast<uint32_t>(1) << remaining) - 1;
+        }
+        if (filledLanes != 0) {
+            return index + static_cast<size_t>(std::countr_zero(filledLanes));
+        }
+    }
+    return last;
+}
+
+/**
+ * @brief Calls a function with every key-value pair in a range of buckets.
+ *
+ * Shared by the const and non-const visitors; Self is HashTable_t or const HashTable_t,
+ * and function receives the value as V& or const V& accordingly.
+ *
+ * @param table table visited
+ * @param first first bucket of range
+ * @param last end of range (at most the capacity of table)
+ * @param function function called with every key-value pair, as function(key, value)
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+template<typename Self, typename Function>
+void HashTable_t<K, V, Hash, Eq>::visitBuckets(Self& table, const size_t first, const size_t last, Function& function) {
+    for (size_t bucketNum = table.nextFilled(first, last); bucketNum < last; bucketNum = table.nextFilled(bucketNum + 1, last)) {
+        auto& currBucket = table.tableData[bucketNum]; // In range by construction of nextFilled.
+        function(currBucket.getKey(), currBucket.getValueRef());
+    }
+}
+
+/**
+ * @brief Mixed hash of a key, from which its home bucket and fingerprint are taken.
+ *
+ * The result of the hash function is scrambled once by mixHash, so that weak hash functions, such as std::hash
+ * of an integer (the integer itself), still spread keys over the table: the home bucket is taken from the high bits
+ * of the mixed hash and the fingerprint from its low 7 bits, both of which depend on every bit of the key's hash.
+ * Without mixing, runs of consecutive integers would share a home bucket, and multiples of 128 a fingerprint.
+ * This is the hash cached in buckets and passed to every helper taking a hashValue.
+ *
+ * @param key Key to be hashed.
+ * @return mixed hash of key.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+HASHTABLE_INLINE size_t HashTable_t<K, V, Hash, Eq>::hashOf(const KeyArg key) const {
+    return static_cast<size_t>(mixHash(static_cast<uint64_t>(hash(key))));
+}
+
+/**
+ * @brief Full hash of key stored in a bucket.
+ *
+ * Reads the cached hash if hashes are cached for K, and otherwise hashes the key again,
+ * which is cheap for the trivially copyable keys that are stored without a cached hash.
+ *
+ * @param bucket filled bucket
+ * @return full hash of key stored in bucket.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+HASHTABLE_INLINE size_t HashTable_t<K, V, Hash, Eq>::storedHash(const HashTableBucket& bucket) const {
+    if constexpr (cachesHash) {
+        return bucket.getHash();
+    }
+    else {
+        return hashOf(bucket.getKey());
+    }
+}
+
+/**
+ * @brief Probe sequence for a key with given hash.
+ *
+ * Private helper for constructing the windows probed by insert, find, and their variants.
+ * The sequence yields window numbers; window w begins w * windowWidth buckets after the home bucket.
+ *
+ * @param hashValue Full hash of the key being probed.
+ * @return Probe sequence for the key.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+ProbeSequence HashTable_t<K, V, Hash, Eq>::probeSequence(const size_t hashValue) const {
+    return {numWindows, probeMode, probeMultiplier, probeIncrement, hashValue};
+}
+
+/**
+ * @brief Copy constructor for MigrationState.
+ *
+ * Copies the table being migrated from, so that the copy and the original migrate independently.
+ *
+ * @param other migration state to be copied
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+HashTable_t<K, V, Hash, Eq>::MigrationState::MigrationState(const MigrationState& other) :
+    source(other.source ? std::make_unique<HashTable_t>(*other.source) : nullptr), cursor(other.cursor) {}
+
+/**
+ * @brief Default constructor for HashTableBucket.
+ *
+ * Constructs an empty bucket; the table marks it ESS in the control byte array.
+ * While unnecessary, also value-initializes key, value, and hash (empty string and 0 for the default table) for easy analysis.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+HashTable_t<K, V, Hash, Eq>::HashTableBucket::HashTableBucket() :
+    key(), value(), cachedHash() {}
+
+/**
+ * @brief Parameterized constructor for HashTableBucket.
+ *
+ * Constructs bucket with given key-value pair; the table marks it NORMAL in the control byte array.
+ *
+ * @param key Key for hash table entry
+ * @param value Value for hash table entry
+ * @param hashValue Full hash of key (discarded if hashes are not cached for K)
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+HashTable_t<K, V, Hash, Eq>::HashTableBucket::HashTableBucket(const K& key, const V& value, const size_t hashValue) :
+    key(key), value(value), cachedHash() {
+    if constexpr (cachesHash) {
+        cachedHash.value = hashValue;
+    }
+}
+
+/**
+ * @brief Getter for key stored in hash table bucket.
+ *
+ * Returns a reference so that comparisons and output do not copy the key.
+ *
+ * @warning A bucket of type EAR may hold a previously removed key.
+ * @warning The reference is invalidated when the table is rehashed.
+ * @return Reference to key stored in hash table bucket.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+HASHTABLE_INLINE const K& HashTable_t<K, V, Hash, Eq>::HashTableBucket::getKey() const {
+    return key;
+}
+
+/**
+ * @brief Getter for value stored in hash table bucket.
+ *
+ * @warning A bucket of type EAR may hold a previously removed key.
+ * @return Value stored in hash table bucket.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+HASHTABLE_INLINE V HashTable_t<K, V, Hash, Eq>::HashTableBucket::getValue() const {
+    return value;
+}
+
+/**
+ * @brief Getter for reference to value stored in hash table bucket.
+ *
+ * For use with subscript operator overload of HashTable.
+ * Allows for mutation of stored value.
+ *
+ * @warning A bucket of type EAR may hold a previously removed key.
+ * @return Reference to value stored in hash table bucket.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+HASHTABLE_INLINE V& HashTable_t<K, V, Hash, Eq>::HashTableBucket::getValueRef() {
+    return value;
+}
+
+/**
+ * @brief Getter for const reference to value stored in hash table bucket.
+ *
+ * For use by the const iterators and visitors of HashTable.
+ *
+ * @warning A bucket of type EAR may hold a previously removed key.
+ * @return Const reference to value stored in hash table bucket.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+HASHTABLE_INLINE const V& HashTable_t<K, V, Hash, Eq>::HashTableBucket::getValueRef() const {
+    return value;
+}
+
+/**
+ * @brief Getter for cached hash of key stored in hash table bucket.
+ *
+ * Only available when hashes are cached for K.
+ *
+ * @warning A bucket of type EAR may hold a previously removed key.
+ * @return Full hash of key stored in hash table bucket.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+HASHTABLE_INLINE size_t HashTable_t<K, V, Hash, Eq>::HashTableBucket::getHash() const requires cachesHash {
+    return cachedHash.value;
+}
+
+/**
+ * @brief Predicate for determining if bucket holds given key.
+ *
+ * If hashes are cached for K, they are compared first, so the key itself is only compared
+ * when the hashes agree (almost always a true match). Otherwise the keys are compared directly.
+ *
+ * @warning Does not check if bucket is empty.
+ *
+ * @param inHash full hash of key to be compared
+ * @param inKey key to be compared
+ * @param equal key equality predicate of the table
+ * @return true if bucket holds key, false if not.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+HASHTABLE_INLINE bool HashTable_t<K, V, Hash, Eq>::HashTableBucket::matches(const size_t inHash, const KeyArg inKey, const Eq& equal) const {
+    if constexpr (cachesHash) {
+        if (cachedHash.value != inHash) {return false;}
+    }
+    return equal(key, inKey);
+}
+
+/**
+ * @brief Moves key out of hash table bucket.
+ *
+ * For use while rehashing, when the bucket is about to be discarded.
+ *
+ * @warning The bucket is left holding an empty key.
+ * @return Key previously stored in hash table bucket.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+K HashTable_t<K, V, Hash, Eq>::HashTableBucket::releaseKey() {
+    return std::move(key);
+}
+
+/**
+ * @brief Fills bucket with key-value pair.
+ *
+ * The table marks the bucket as filled (type NORMAL) by writing its fingerprint to the control byte array.
+ * The key is taken by value so that callers may move it in.
+ *
+ * @param inKey key to be stored
+ * @param inValue value to be stored
+ * @param inHash full hash of key to be stored (discarded if hashes are not cached for K)
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void HashTable_t<K, V, Hash, Eq>::HashTableBucket::load(K inKey, const V& inValue, const size_t inHash) {
+    this->key = std::move(inKey);
+    this->value = inValue;
+    if constexpr (cachesHash) {
+        this->cachedHash.value = inHash;
+    }
+}
+
+/**
+ * @brief Fills bucket with key and a value constructed from arguments.
+ *
+ * Buckets always hold a value, so the new one is constructed from the arguments and then moved over the old one.
+ *
+ * @param inKey key to be stored
+ * @param inHash full hash of key to be stored (discarded if hashes are not cached for K)
+ * @param valueArgs arguments the value is constructed from
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+template<typename... Args>
+void HashTable_t<K, V, Hash, Eq>::HashTableBucket::emplace(K inKey, const size_t inHash, Args&&... valueArgs) {
+    this->key = std::move(inKey);
+    this->value = V(std::forward<Args>(valueArgs)...);
+    if constexpr (cachesHash) {
+        this->cachedHash.value = inHash;
+    }
+}
+
+/**
+ * @brief Parameterized constructor for BucketIterator.
+ *
+ * @param inTable table iterated over
+ * @param inIndex bucket to start from; the iterator moves on to the first filled bucket at or after it.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+template<bool isConst>
+HashTable_t<K, V, Hash, Eq>::BucketIterator<isConst>::BucketIterator(Table* const inTable, const size_t inIndex) :
+    table(inTable), index(inIndex) {
+    settle();
+}
+
+/**
+ * @brief Moves to the first filled bucket at or after the current one.
+ *
+ * Continues into the table being drained by an incremental rehash (whose migrated buckets are empty)
+ * once the buckets of the current table run out, and becomes the end iterator after the last one.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+template<bool isConst>
+void HashTable_t<K, V, Hash, Eq>::BucketIterator<isConst>::settle() {
+    for (; table != nullptr; table = table->migration.source.get(), index = 0) {
+        if (index = table->nextFilled(index, table->capacity()); index < table->capacity()) {
+            return;
+        }
+    }
+    index = 0;
+}
+
+/**
+ * @brief Conversion from iterator to const_iterator.
+ *
+ * @return const iterator at the same bucket.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+template<bool isConst>
+HashTable_t<K, V, Hash, Eq>::BucketIterator<isConst>::operator BucketIterator<true>() const requires (!isConst) {
+    BucketIterator<true> converted;
+    converted.table = table;
+    converted.index = index;
+    return converted;
+}
+
+/**
+ * @brief Key and value of the current bucket.
+ *
+ * @warning Must not be called on the end iterator.
+ * @return pair of a reference to the key and a reference to the value.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+template<bool isConst>
+typename HashTable_t<K, V, Hash, Eq>::template BucketIterator<isConst>::reference HashTable_t<K, V, Hash, Eq>::BucketIterator<isConst>::operator*() const {
+    auto& currBucket = table->tableData[index]; // In range for every iterator but the end iterator.
+    return {currBucket.getKey(), currBucket.getValueRef()};
+}
+
+/**
+ * @brief Advances to the next filled bucket.
+ *
+ * @return reference to this iterator.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+template<bool isConst>
+typename HashTable_t<K, V, Hash, Eq>::template BucketIterator<isConst>& HashTable_t<K, V, Hash, Eq>::BucketIterator<isConst>::operator++() {
+    ++index;
+    settle();
+    return *this;
+}
+
+/**
+ * @brief Advances to the next filled bucket, returning the iterator before advancing.
+ *
+ * @return copy of this iterator from before it advanced.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+template<bool isConst>
+typename HashTable_t<K, V, Hash, Eq>::template BucketIterator<isConst> HashTable_t<K, V, Hash, Eq>::BucketIterator<isConst>::operator++(int) {
+    BucketIterator previous = *this;
+    ++*this;
+    return previous;
+}
+
+#endif // HASHTABLEIMPL_H
@@ -0,0 +1,351 @@
+#ifndef HASHTABLESTATS_H
+#define HASHTABLESTATS_H
+
+/*
+ * Greg Rosen
+ * Project 4: HashTable
+ * Declaration and implementation of opt-in probe and rehash statistics for HashTable
+ */
+
+#include "ControlGroup.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Whether HashTable records statistics, selected by defining HASHTABLE_ENABLE_STATS.
+ *
+ * When false, the counters and all code updating them compile away.
+ * The macro must be defined (or not) consistently across the whole program, as it changes the layout of HashTable.
+ */
+#if defined(HASHTABLE_ENABLE_STATS)
+inline constexpr bool HASHTABLE_STATS = true;
+#else
+inline constexpr bool HASHTABLE_STATS = false;
+#endif
+
+/**
+ * @struct HashTableStats
+ * @brief Snapshot of the statistics of a HashTable, returned by stats().
+ *
+ * A search is any probe of a key's sequence by a lookup, insertion, or removal; each bucket array searched
+ * during an incremental rehash counts as its own search. Probe lengths are counted in windows (see ControlGroup),
+ * as every bucket of a window is examined at once. Rehashes include growing, shrinking, and compacting.
+ * The sizes and bytesAllocated are always filled in; every other field is zero unless enabled is true.
+ */
+struct HashTableStats {
+    static constexpr size_t HISTOGRAM_SIZE = 16; // Number of entries in each probe-length histogram.
+
+    bool enabled = HASHTABLE_STATS; // Whether statistics were recorded (HASHTABLE_ENABLE_STATS was defined).
+    std::array<uint64_t, HISTOGRAM_SIZE> hitProbeLengths{}; // Successful searches by windows probed, minus one; the last entry counts all longer probes.
+    std::array<uint64_t, HISTOGRAM_SIZE> missProbeLengths{}; // Unsuccessful searches by windows probed, minus one; the last entry counts all longer probes.
+    uint64_t tombstonesCrossed = 0; // Number of tombstones in the windows probed, summed over all searches.
+    size_t maxProbeLength = 0; // Largest number of windows probed by one search.
+    uint64_t numRehashes = 0; // Number of rehashes.
+    std::chrono::nanoseconds rehashTime{0}; // Time spent rehashing, including incremental migration steps.
+    size_t bytesAllocated = 0; // Bytes held by the bucket arrays and key arena, not counting storage owned by keys or values.
+    size_t size = 0; // Number of key-value pairs.
+    size_t capacity = 0; // Number of buckets.
+    size_t tombstones = 0; // Number of tombstones.
+
+    [[nodiscard]] uint64_t hits() const; // Number of successful searches.
+    [[nodiscard]] uint64_t misses() const; // Number of unsuccessful searches.
+    [[nodiscard]] double meanHitProbeLength() const; // Mean windows probed per successful search.
+    [[nodiscard]] double meanMissProbeLength() const; // Mean windows probed per unsuccessful search.
+    [[nodiscard]] double tombstonesPerSearch() const; // Mean tombstones crossed per search.
+    HashTableStats& operator+=(const HashTableStats& other); // Combines the statistics of another table.
+
+private:
+    [[nodiscard]] static double meanProbeLength(const std::array<uint64_t, HISTOGRAM_SIZE>& histogram); // Mean of a probe-length histogram.
+};
+
+/**
+ * @struct ProbeTally
+ * @brief Windows and tombstones passed by one search, while it is in progress.
+ */
+template<bool Enabled>
+struct ProbeTally {
+    size_t windows = 0; // Number of windows probed.
+    size_t tombstones = 0; // Number of tombstones in the windows probed.
+
+    /**
+     * @brief Counts a probed window.
+     *
+     * @param group control bytes of window
+     * @param laneMask lanes of group belonging to window
+     */
+    void count(const ControlGroup& group, const uint32_t laneMask) {
+        ++windows;
+        tombstones += static_cast<size_t>(std::popcount(group.matchTombstone() & laneMask));
+    }
+};
+
+/**
+ * @brief ProbeTally specialization for builds without statistics; counts nothing.
+ */
+template<>
+struct ProbeTally<false> {
+    void count(const ControlGroup&, uint32_t) {} // Ignores a probed window.
+};
+
+/**
+ * @class StatsCounters
+ * @brief Statistics recorded by a HashTable, when HASHTABLE_ENABLE_STATS is defined.
+ *
+ * Counters are relaxed atomics, since ConcurrentHashTable searches a shard from several readers at once.
+ */
+template<bool Enabled>
+class StatsCounters {
+private:
+    std::array<std::atomic<uint64_t>, HashTableStats::HISTOGRAM_SIZE> hitProbeLengths{}; // Successful searches by windows probed.
+    std::array<std::atomic<uint64_t>, HashTableStats::HISTOGRAM_SIZE> missProbeLengths{}; // Unsuccessful searches by windows probed.
+    std::atomic<uint64_t> tombstonesCrossed{0}; // Tombstones in the windows probed by all searches.
+    std::atomic<size_t> maxProbeLength{0}; // Largest number of windows probed by one search.
+    std::atomic<uint64_t> numRehashes{0}; // Number of rehashes.
+    std::atomic<int64_t> rehashNanoseconds{0}; // Time spent rehashing.
+
+public:
+    /**
+     * @class RehashTimer
+     * @brief Adds the time from its construction to its destruction to the rehash time.
+     */
+    class RehashTimer {
+    private:
+        StatsCounters& counters; // Counters receiving the elapsed time.
+        std::chrono::steady_clock::time_point start; // Time of construction.
+
+    public:
+        explicit RehashTimer(StatsCounters& inCounters) : counters(inCounters), start(std::chrono::steady_clock::now()) {} // Starts timing.
+        RehashTimer(const RehashTimer&) = delete;
+        RehashTimer& operator=(const RehashTimer&) = delete;
+        ~RehashTimer(); // Stops timing.
+    };
+
+    StatsCounters() = default; // Default constructor for StatsCounters.
+    StatsCounters(const StatsCounters& other); // Copy constructor for StatsCounters.
+
+    void recordSearch(bool hit, const ProbeTally<true>& tally); // Records a finished search.
+    void countRehash(); // Records a rehash.
+    [[nodiscard]] RehashTimer timeRehash(); // Starts timing rehash work.
+    void merge(const StatsCounters& other); // Adds the statistics of another table.
+    void addTo(HashTableStats& snapshot) const; // Adds the statistics to a snapshot.
+};
+
+/**
+ * @brief StatsCounters specialization for builds without statistics; occupies no storage and records nothing.
+ */
+template<>
+class StatsCounters<false> {
+public:
+    /**
+     * @struct RehashTimer
+     * @brief Stand-in for the timer of StatsCounters<true>; measures nothing.
+     */
+    struct RehashTimer {};
+
+    void recordSearch(bool, const ProbeTally<false>&) {} // Ignores a finished search.
+    void countRehash() {} // Ignores a rehash.
+    [[nodiscard]] RehashTimer timeRehash() { return {}; } // Ignores rehash work.
+    void merge(const StatsCounters&) {} // Ignores the statistics of another table.
+    void addTo(HashTableStats&) const {} // Leaves a snapshot as is.
+};
+
+/**
+ * @brief Number of successful searches.
+ *
+ * @return sum of the hit probe-length histogram.
+ */
+inline uint64_t HashTableStats::hits() const {
+    uint64_t total = 0;
+    for (const uint64_t count : hitProbeLengths) {
+        total += count;
+    }
+    return total;
+}
+
+/**
+ * @brief Number of unsuccessful searches.
+ *
+ * @return sum of the miss probe-length histogram.
+ */
+inline uint64_t HashTableStats::misses() const {
+    uint64_t total = 0;
+    for (const uint64_t count : missProbeLengths) {
+        total += count;
+    }
+    return total;
+}
+
+/**
+ * @brief Mean of a probe-length histogram.
+ *
+ * Searches in the last entry are counted as HISTOGRAM_SIZE windows, so the mean is a lower bound if any are present.
+ *
+ * @param histogram searches by windows probed, minus one
+ * @return mean windows probed, or 0 if the histogram is empty.
+ */
+inline double HashTableStats::meanProbeLength(const std::array<uint64_t, HISTOGRAM_SIZE>& histogram) {
+    uint64_t numSearches = 0;
+    uint64_t numWindows = 0;
+    for (size_t length = 0; length < HISTOGRAM_SIZE; ++length) {
+        numSearches += histogram[length];
+        numWindows += histogram[length] * (length + 1);
+    }
+    return numSearches == 0 ? 0.0 : static_cast<double>(numWindows) / static_cast<double>(numSearches);
+}
+
+/**
+ * @brief Mean windows probed per successful search.
+ *
+ * @return mean probe length of hits, or 0 if there were none.
+ */
+inline double HashTableStats::meanHitProbeLength() const {
+    return meanProbeLength(hitProbeLengths);
+}
+
+/**
+ * @brief Mean windows probed per unsuccessful search.
+ *
+ * @return mean probe length of misses, or 0 if there were none.
+ */
+inline double HashTableStats::meanMissProbeLength() const {
+    return meanProbeLength(missProbeLengths);
+}
+
+/**
+ * @brief Mean tombstones crossed per search.
+ *
+ * A rising value means removals are lengthening probes faster than compaction clears them.
+ *
+ * @return mean tombstones in the windows probed, or 0 if there were no searches.
+ */
+inline double HashTableStats::tombstonesPerSearch() const {
+    const uint64_t numSearches = hits() + misses();
+    return numSearches == 0 ? 0.0 : static_cast<double>(tombstonesCrossed) / static_cast<double>(numSearches);
+}
+
+/**
+ * @brief Combines the statistics of another table.
+ *
+ * Every count and size is summed, except the maximum probe length, which is the larger of the two.
+ * Used to report the statistics of a table made of several (such as the shards of a ConcurrentHashTable).
+ *
+ * @param other statistics to be added
+ * @return these statistics.
+ */
+inline HashTableStats& HashTableStats::operator+=(const HashTableStats& other) {
+    for (size_t length = 0; length < HISTOGRAM_SIZE; ++length) {
+        hitProbeLengths[length] += other.hitProbeLengths[length];
+        missProbeLengths[length] += other.missProbeLengths[length];
+    }
+    tombstonesCrossed += other.tombstonesCrossed;
+    maxProbeLength = std::max(maxProbeLength, other.maxProbeLength);
+    numRehashes += other.numRehashes;
+    rehashTime += other.rehashTime;
+    bytesAllocated += other.bytesAllocated;
+    size += other.size;
+    capacity += other.capacity;
+    tombstones += other.tombstones;
+    return *this;
+}
+
+/**
+ * @brief Stops timing.
+ *
+ * Adds the time elapsed since construction to the rehash time of the counters.
+ */
+template<bool Enabled>
+StatsCounters<Enabled>::RehashTimer::~RehashTimer() {
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    counters.rehashNanoseconds.fetch_add(elapsed.count(), std::memory_order_relaxed);
+}
+
+/**
+ * @brief Copy constructor for StatsCounters.
+ *
+ * Atomics are not copyable, so every counter is loaded and stored individually.
+ *
+ * @param other counters to be copied
+ */
+template<bool Enabled>
+StatsCounters<Enabled>::StatsCounters(const StatsCounters& other) {
+    merge(other);
+}
+
+/**
+ * @brief Records a finished search.
+ *
+ * @param hit whether the key was found
+ * @param tally windows and tombstones passed by the search
+ */
+template<bool Enabled>
+void StatsCounters<Enabled>::recordSearch(const bool hit, const ProbeTally<true>& tally) {
+    const size_t entry = std::min(tally.windows, HashTableStats::HISTOGRAM_SIZE) - (tally.windows != 0);
+    (hit ? hitProbeLengths : missProbeLengths)[entry].fetch_add(1, std::memory_order_relaxed);
+    tombstonesCrossed.fetch_add(tally.tombstones, std::memory_order_relaxed);
+    size_t longest = maxProbeLength.load(std::memory_order_relaxed);
+    while (tally.windows > longest && !maxProbeLength.compare_exchange_weak(longest, tally.windows, std::memory_order_relaxed)) {}
+}
+
+/**
+ * @brief Records a rehash.
+ */
+template<bool Enabled>
+void StatsCounters<Enabled>::countRehash() {
+    numRehashes.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Starts timing rehash work.
+ *
+ * The time is recorded when the returned timer is destroyed.
+ *
+ * @return running timer.
+ */
+template<bool Enabled>
+typename StatsCounters<Enabled>::RehashTimer StatsCounters<Enabled>::timeRehash() {
+    return RehashTimer(*this);
+}
+
+/**
+ * @brief Adds the statistics of another table.
+ *
+ * Used to keep the searches of the old bucket arrays once an incremental rehash completes.
+ *
+ * @param other counters to be added
+ */
+template<bool Enabled>
+void StatsCounters<Enabled>::merge(const StatsCounters& other) {
+    for (size_t length = 0; length < HashTableStats::HISTOGRAM_SIZE; ++length) {
+        hitProbeLengths[length].fetch_add(other.hitProbeLengths[length].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        missProbeLengths[length].fetch_add(other.missProbeLengths[length].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    tombstonesCrossed.fetch_add(other.tombstonesCrossed.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    maxProbeLength.store(std::max(maxProbeLength.load(std::memory_order_relaxed), other.maxProbeLength.load(std::memory_order_relaxed)),
+        std::memory_order_relaxed);
+    numRehashes.fetch_add(other.numRehashes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    rehashNanoseconds.fetch_add(other.rehashNanoseconds.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+/**
+ * @brief Adds the statistics to a snapshot.
+ *
+ * @param snapshot snapshot to be added to
+ */
+template<bool Enabled>
+void StatsCounters<Enabled>::addTo(HashTableStats& snapshot) const {
+    for (size_t length = 0; length < HashTableStats::HISTOGRAM_SIZE; ++length) {
+        snapshot.hitProbeLengths[length] += hitProbeLengths[length].load(std::memory_order_relaxed);
+        snapshot.missProbeLengths[length] += missProbeLengths[length].load(std::memory_order_relaxed);
+    }
+    snapshot.tombstonesCrossed += tombstonesCrossed.load(std::memory_order_relaxed);
+    snapshot.maxProbeLength = std::max(snapshot.maxProbeLength, maxProbeLength.load(std::memory_order_relaxed));
+    snapshot.numRehashes += numRehashes.load(std::memory_order_relaxed);
+    snapshot.rehashTime += std::chrono::nanoseconds(rehashNanoseconds.load(std::memory_order_relaxed));
+}
+
+#endif // HASHTABLESTATS_H
@@ -22,6 +22,14 @@
 #include <type_traits>
 #include <optional>
 #include <string>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <filesystem>
+#include <random>
+#include <unordered_map>
 
 using namespace std;
 
@@ -40,6 +48,16 @@ using HashTable = HashTable_t<key_type, value_type>;
 #else
 #include "HashTable.h" // Must match key_type/value_type of the tested HashTable
 #endif
+#include "ConcurrentHashTable.h"
+using ConcurrentTable = ConcurrentHashTable_t<key_type, value_type>;
+#include "LockFreeHashTable.h"
+#include "ShardedHashTable.h"
+#include "FilteredHashTable.h"
+using ShardedTable = ShardedHashTable_t<key_type, value_type>;
+#include "FrozenHashTable.h"
+#include "RobinHoodHashTable.h"
+#include "HopscotchHashTable.h"
+using LockFreeTable = LockFreeHashTable_t<key_type, value_type>;
 
 // -----------------------------------------------------------------------------
 /** Helpers: make_key / make_value
@@ -102,6 +120,28 @@ const string evalName{""};
 #define HT_ALPHA
 #define HT_CAPACITY
 #define HT_SIZE
+#define HT_PROBE_MODES
+#define HT_INTEGER_KEYS
+#define HT_RESERVE
+#define HT_BATCH_INSERT
+#define HT_COMPACT
+#define HT_SHRINK
+#define HT_INCREMENTAL_REHASH
+#define HT_PARALLEL_REHASH
+#define HT_ARENA_KEYS
+#define HT_MEMORY_RESOURCE
+#define HT_UPSERT
+#define HT_BATCH_LOOKUP
+#define HT_ITERATION
+#define HT_STATS
+#define HT_SNAPSHOT
+#define HT_HASHERS
+#define HT_FROZEN
+#define HT_ENGINES
+#define HT_CONCURRENT
+#define HT_SHARDED
+#define HT_PREFILTER
+#define HT_LOCK_FREE
 
 // -----------------------------------------------------------------------------
 // Main
@@ -709,6 +749,1159 @@ int main(int, char**) {
     OUTSTREAM << "*** DID NOT TEST SIZE ***" << endl << endl;
 #endif
 
+    // =====================================================================
+    // PROBE MODES
+    // =====================================================================
+    OUTSTREAM << "Testing every probe mode under both capacity policies" << endl;
+    OUTSTREAM << "-----------------------------------------------------" << endl << endl;
+#ifdef HT_PROBE_MODES
+    try {
+        constexpr size_t NUM_KEYS = 500;
+        const HashTable::ProbeMode modes[] = {HashTable::ProbeMode::PSEUDO_RANDOM, HashTable::ProbeMode::LINEAR,
+                                              HashTable::ProbeMode::QUADRATIC, HashTable::ProbeMode::DOUBLE_HASH};
+        const char* modeNames[] = {"PSEUDO_RANDOM", "LINEAR", "QUADRATIC", "DOUBLE_HASH"};
+        const HashTable::CapacityPolicy policies[] = {HashTable::CapacityPolicy::POWER_OF_TWO, HashTable::CapacityPolicy::EXACT};
+        const char* policyNames[] = {"POWER_OF_TWO", "EXACT"};
+        auto probeKey = [](size_t i) { return "key" + to_string(i); };
+        bool ok = true;
+        for (size_t modeNum = 0; modeNum < 4; modeNum++) {
+            for (size_t policyNum = 0; policyNum < 2; policyNum++) {
+                // 37 buckets under EXACT gives single-bucket windows and a span the probe sequence must cycle-walk.
+                const size_t initCapacity = policyNum == 0 ? 32 : 37;
+                HashTable ht1(initCapacity, 0.5, 2.0, modes[modeNum], policies[policyNum]);
+                bool caseOk = true;
+                for (size_t i = 0; i < NUM_KEYS; i++)
+                    caseOk &= ht1.insert(probeKey(i), i);
+                for (size_t i = 0; i < NUM_KEYS; i += 3)
+                    caseOk &= ht1.remove(probeKey(i));
+                for (size_t i = 0; i < NUM_KEYS; i++)
+                    caseOk &= (i % 3 == 0) ? !ht1.contains(probeKey(i)) : ht1.get(probeKey(i)) == i;
+                for (size_t i = 0; i < NUM_KEYS; i += 3)
+                    caseOk &= ht1.insert(probeKey(i), i + NUM_KEYS);
+                for (size_t i = 0; i < NUM_KEYS; i++)
+                    caseOk &= ht1.get(probeKey(i)) == ((i % 3 == 0) ? i + NUM_KEYS : i);
+                caseOk &= (ht1.size() == NUM_KEYS) && (ht1.keys().size() == NUM_KEYS);
+
+                // insertTCT never rehashes, so the table can be filled to its last bucket; every probe sequence must reach it.
+                HashTable ht2(initCapacity, 0.5, 2.0, modes[modeNum], policies[policyNum]);
+                const size_t fullCapacity = ht2.capacity();
+                for (size_t i = 0; i < fullCapacity; i++)
+                    caseOk &= ht2.insertTCT(probeKey(i), i) <= fullCapacity;
+                caseOk &= (ht2.size() == fullCapacity) && (ht2.insertTCT(probeKey(fullCapacity), 0) == fullCapacity)
+                    && !ht2.contains(probeKey(fullCapacity));
+                for (size_t i = 0; i < fullCapacity; i += 2)
+                    caseOk &= ht2.removeTCT(probeKey(i)) <= fullCapacity;
+                for (size_t i = 0; i <= fullCapacity; i++) // Searches for missing keys cross every remaining bucket.
+                    caseOk &= (i % 2 == 0 || i == fullCapacity) ? !ht2.contains(probeKey(i)) : ht2.get(probeKey(i)) == i;
+
+                OUTSTREAM << "  " << modeNames[modeNum] << " / " << policyNames[policyNum] << ": "
+                          << (caseOk ? "ok" : "WRONG") << " (capacity " << ht1.capacity() << ", full table of " << fullCapacity << ")" << endl;
+                ok &= caseOk;
+            }
+        }
+        OUTSTREAM << (ok ? "SUCCESS: every probe mode and capacity policy kept the right entries through inserts, removes, and a full fill."
+                         : "FAILURE: a probe mode or capacity policy lost, duplicated, or misplaced entries.")
+                  << endl << endl;
+    } catch (exception& e) {
+        OUTSTREAM << "Exception: " << e.what() << endl << endl;
+    }
+#else
+    OUTSTREAM << "*** DID NOT TEST PROBE MODES ***" << endl << endl;
+#endif
+
+    // =====================================================================
+    // INTEGER KEYS
+    // =====================================================================
+    OUTSTREAM << "Testing group probing with integer keys" << endl;
+    OUTSTREAM << "---------------------------------------" << endl << endl;
+#ifdef HT_INTEGER_KEYS
+    try {
+        // std::hash returns an integer key itself, so these keys share home buckets and fingerprints unless the table mixes the hash.
+        using IntegerTable = HashTable_t<size_t, size_t>;
+        constexpr size_t NUM_KEYS = 20000;
+        bool ok = true;
+        for (const size_t stride : {size_t{1}, size_t{128}}) {
+            // A capacity multiple of 16 probes 16-bucket windows; one that is not probes single buckets.
+            for (const size_t initCapacity : {NUM_KEYS * 3 + 16, NUM_KEYS * 3 + 1}) {
+                IntegerTable it1(initCapacity, 0.5, 2.0, IntegerTable::ProbeMode::PSEUDO_RANDOM, IntegerTable::CapacityPolicy::EXACT);
+                size_t totalProbes = 0;
+                size_t maxProbes = 0;
+                for (size_t i = 0; i < NUM_KEYS; i++) {
+                    const size_t probes = it1.insertTCT(i * stride, i);
+                    totalProbes += probes;
+                    maxProbes = std::max(maxProbes, probes);
+                }
+                const double meanProbes = static_cast<double>(totalProbes) / NUM_KEYS;
+                OUTSTREAM << "  stride " << stride << ", capacity " << it1.capacity() << ": " << meanProbes
+                          << " probes per insert on average, " << maxProbes << " at most" << endl;
+                ok &= (it1.size() == NUM_KEYS) && (meanProbes < 2.0) && (maxProbes < 64);
+
+                for (size_t i = 0; i < NUM_KEYS; i += 2)
+                    ok &= it1.remove(i * stride);
+                for (size_t i = 0; i < NUM_KEYS; i++)
+                    ok &= (i % 2 == 0) ? !it1.contains(i * stride) : it1.get(i * stride) == i;
+                ok &= !it1.contains(NUM_KEYS * stride) && (it1.size() == NUM_KEYS / 2);
+            }
+        }
+        OUTSTREAM << (ok ? "SUCCESS: sequential and strided integer keys spread over the table and stayed reachable."
+                         : "FAILURE: integer keys clustered into long probe sequences or were lost.")
+                  << endl << endl;
+    } catch (exception& e) {
+        OUTSTREAM << "Exception: " << e.what() << endl << endl;
+    }
+#else
+    OUTSTREAM << "*** DID NOT TEST INTEGER KEYS ***" << endl << endl;
+#endif
+
+    // =====================================================================
+    // RESERVE
+    // =====================================================================
+    OUTSTREAM << "Testing HashTable::reserve()" << endl;
+    OUTSTREAM << "----------------------------" << endl << endl;
+#ifdef HT_RESERVE
+    try {
+        HashTable ht1;
+        OUTSTREAM << "Reserving room for " << MAXHASH * 2 << " entries..." << endl;
+        ht1.reserve(MAXHASH * 2);
+        size_t reservedCapacity = ht1.capacity();
+        OUTSTREAM << "Capacity after reserve: " << reservedCapacity << endl;
+
+        OUTSTREAM << "Inserting " << MAXHASH * 2 << " entries..." << endl;
+        for (size_t i = 1; i <= MAXHASH * 2; i++)
+            ht1.insert(make_key<key_type>(i), make_value<value_type>(i));
+
+        OUTSTREAM << "Capacity after inserts: " << ht1.capacity() << endl;
+        bool ok = (ht1.capacity() == reservedCapacity) && (ht1.size() == MAXHASH * 2);
+        OUTSTREAM << (ok ? "SUCCESS: reserve() prevented rehashing for the reserved entries."
+                         : "FAILURE: table rehashed or lost entries after reserve().")
+                  << endl << endl;
+    } catch (exception& e) {
+        OUTSTREAM << "Exception: " << e.what() << endl << endl;
+    }
+#else
+    OUTSTREAM << "*** DID NOT TEST RESERVE ***" << endl << endl;
+#endif
+
+    // =====================================================================
+    // BATCH INSERT
+    // =====================================================================
+    OUTSTREAM << "Testing HashTable::insert() with a batch of entries" << endl;
+    OUTSTREAM << "---------------------------------------------------" << endl << endl;
+#ifdef HT_BATCH_INSERT
+    try {
+        HashTable ht1;
+        std::vector<std::pair<key_type, value_type>> batch;
+        for (size_t i = 1; i <= MAXHASH * 2; i++)
+            batch.emplace_back(make_key<key_type>(i), make_value<value_type>(i));
+        batch.emplace_back(make_key<key_type>(1), make_value<value_type>(1)); // duplicate within batch
+
+        OUTSTREAM << "Inserting batch of " << batch.size() << " entries (one duplicate)..." << endl;
+        size_t n = ht1.insert(batch);
+        OUTSTREAM << "  insert(batch) -> " << n << endl;
+
+        OUTSTREAM << "Inserting the same entries again as an iterator range..." << endl;
+        size_t m = ht1.insert(batch.begin(), batch.end());
+        OUTSTREAM << "  insert(first, last) -> " << m << endl;
+
+        bool ok = (n == MAXHASH * 2) && (m == 0) && (ht1.size() == MAXHASH * 2);
+        for (size_t i = 1; i <= MAXHASH * 2; i++) {
+            auto got = ht1.get(make_key<key_type>(i));
+            ok &= got.has_value() && got.value() == make_value<value_type>(i);
+        }
+        OUTSTREAM << (ok ? "SUCCESS: batch insert stored every unique entry and skipped duplicates."
+                         : "FAILURE: batch insert count or contents were wrong.")
+                  << endl << endl;
+    } catch (exception& e) {
+        OUTSTREAM << "Exception: " << e.what() << endl << endl;
+    }
+#else
+    OUTSTREAM << "*** DID NOT TEST BATCH INSERT ***" << endl << endl;
+#endif
+
+    // =====================================================================
+    // COMPACT
+    // =====================================================================
+    OUTSTREAM << "Testing HashTable::compact()" << endl;
+    OUTSTREAM << "----------------------------" << endl << endl;
+#ifdef HT_COMPACT
+    try {
+        // Single-bucket probe windows (EXACT capacity not a multiple of 16) make every removal leave a tombstone.
+        HashTable ht1(MAXHASH * 8 - 4, 0.5, 2.0, HashTable::ProbeMode::PSEUDO_RANDOM, HashTable::CapacityPolicy::EXACT);
+        OUTSTREAM << "Inserting " << MAXHASH * 2 << " entries, then removing every other one..." << endl;
+        for (size_t i = 1; i <= MAXHASH * 2; i++)
+            ht1.insert(make_key<key_type>(i), make_value<value_type>(i));
+        for (size_t i = 1; i <= MAXHASH * 2; i += 2)
+            ht1.remove(make_key<key_type>(i));
+        OUTSTREAM << "Tombstones before compact: " << ht1.tombstones() << endl;
+        size_t tombstonesBefore = ht1.tombstones();
+
+        size_t capacityBefore = ht1.capacity();
+        ht1.compact();
+        OUTSTREAM << "Tombstones after compact: " << ht1.tombstones() << endl;
+
+        bool ok = (tombstonesBefore == MAXHASH) && (ht1.tombstones() == 0) && (ht1.capacity() == capacityBefore) && (ht1.size() == MAXHASH);
+        for (size_t i = 1; i <= MAXHASH * 2; i++)
+            ok &= ht1.contains(make_key<key_type>(i)) == (i % 2 == 0);
+        OUTSTREAM << (ok ? "SUCCESS: compact() cleared tombstones and kept the remaining entries."
+                         : "FAILURE: compact() left tombstones or changed the table contents.")
+                  << endl << endl;
+    } catch (exception& e) {
+        OUTSTREAM << "Exception: " << e.what() << endl << endl;
+    }
+#else
+    OUTSTREAM << "*** DID NOT TEST COMPACT ***" << endl << endl;
+#endif
+
+    // =====================================================================
+    // SHRINK
+    // =====================================================================
+    OUTSTREAM << "Testing HashTable::shrink_to_fit() and automatic shrinking" << endl;
+    OUTSTREAM << "-----------------------------------------------------------" << endl << endl;
+#ifdef HT_SHRINK
+    try {
+        HashTable ht1;
+        OUTSTREAM << "Inserting " << MAXHASH * 3 << " entries, then removing all but " << MAXHASH / 2 << "..." << endl;
+        for (size_t i = 1; i <= MAXHASH * 3; i++)
+            ht1.insert(make_key<key_type>(i), make_value<value_type>(i));
+        for (size_t i = MAXHASH / 2 + 1; i <= MAXHASH * 3; i++)
+            ht1.remove(make_key<key_type>(i));
+        size_t capacityBefore = ht1.capacity();
+        ht1.shrink_to_fit();
+        OUTSTREAM << "Capacity before shrink_to_fit: " << capacityBefore << ", after: " << ht1.capacity() << endl;
+
+        bool ok = (ht1.capacity() < capacityBefore) && (ht1.alpha() < 0.5) && (ht1.size() == MAXHASH / 2);
+        for (size_t i = 1; i <= MAXHASH / 2; i++)
+            ok &= ht1.get(make_key<key_type>(i)) == make_value<value_type>(i);
+
+        HashTable ht2(MAXHASH, 0.5, 2.0, HashTable::ProbeMode::PSEUDO_RANDOM, HashTable::CapacityPolicy::POWER_OF_TWO, 0.25, 0.125);
+        OUTSTREAM << "Repeating with a shrink threshold of 0.125 and no explicit shrink..." << endl;
+        for (size_t i = 1; i <= MAXHASH * 3; i++)
+            ht2.insert(make_key<key_type>(i), make_value<value_type>(i));
+        size_t grownCapacity = ht2.capacity();
+        for (size_t i = MAXHASH / 2 + 1; i <= MAXHASH * 3; i++)
+            ht2.remove(make_key<key_type>(i));
+        OUTSTREAM << "Capacity after inserts: " << grownCapacity << ", after removals: " << ht2.capacity() << endl;
+
+        ok &= (ht2.capacity() < grownCapacity) && (ht2.capacity() >= MAXHASH) && (ht2.size() == MAXHASH / 2);
+        for (size_t i = 1; i <= MAXHASH / 2; i++)
+            ok &= ht2.get(make_key<key_type>(i)) == make_value<value_type>(i);
+        OUTSTREAM << (ok ? "SUCCESS: tables shrank and kept their remaining entries."
+                         : "FAILURE: tables did not shrink or lost entries.")
+                  << endl << endl;
+    } catch (exception& e) {
+        OUTSTREAM << "Exception: " << e.what() << endl << endl;
+    }
+#else
+    OUTSTREAM << "*** DID NOT TEST SHRINK ***" << endl << endl;
+#endif
+
+    // =====================================================================
+    // INCREMENTAL REHASH
+    // =====================================================================
+    OUTSTREAM << "Testing incremental rehashing" << endl;
+    OUTSTREAM << "-----------------------------" << endl << endl;
+#ifdef HT_INCREMENTAL_REHASH
+    try {
+        HashTable ht1(MAXHASH, 0.5, 2.0, HashTable::ProbeMode::PSEUDO_RANDOM, HashTable::CapacityPolicy::POWER_OF_TWO, 0.25, 0.0, 1);
+        OUTSTREAM << "Inserting " << MAXHASH * 2 << " entries, migrating one old bucket per operation..." << endl;
+        bool sawMigration = false;
+        bool ok = true;
+        for (size_t i = 1; i <= MAXHASH * 2; i++) {
+            ht1.insert(make_key<key_type>(i), make_value<value_type>(i));
+            sawMigration |= ht1.isMigrating();
+            for (size_t j = 1; j <= i; j++) // Every entry must stay reachable mid-migration.
+                ok &= ht1.get(make_key<key_type>(j)) == make_value<value_type>(j);
+        }
+        OUTSTREAM << "Migration observed: " << (sawMigration ? "yes" : "no") << endl;
+
+        OUTSTREAM << "Removing first half while migrating..." << endl;
+        for (size_t i = 1; i <= MAXHASH; i++)
+            ok &= ht1.remove(make_key<key_type>(i));
+        for (size_t i = 1; i <= MAXHASH * 2; i++)
+            ok &= ht1.contains(make_key<key_type>(i)) == (i > MAXHASH);
+        ok &= sawMigration && (ht1.size() == MAXHASH) && (ht1.keys().size() == MAXHASH);
+        OUTSTREAM << (ok ? "SUCCESS: entries stayed reachable throughout incremental rehashing."
+                         : "FAILURE: entries were lost or duplicated during incremental rehashing.")
+                  << endl << endl;
+    } catch (exception& e) {
+        OUTSTREAM << "Exception: " << e.what() << endl << endl;
+    }
+#else
+    OUTSTREAM << "*** DID NOT TEST INCREMENTAL REHASH ***" << endl << endl;
+#endif
+
+    // =====================================================================
+    // PARALLEL REHASH
+    // =====================================================================
+    OUTSTREAM << "Testing rehashing with multiple threads" << endl;
+    OUTSTREAM << "---------------------------------------" << endl << endl;
+#ifdef HT_PARALLEL_REHASH
+    try {
+        constexpr size_t NUM_THREADS = 4;
+        constexpr size_t CAPACITY = size_t{1} << 18; // Large enough that each thread is given its minimum share of old buckets.
+        constexpr size_t NUM_KEYS = CAPACITY * 3 / 8; // Fills every thread's share of buckets, below the threshold of 0.5.
+        HashTable ht1(CAPACITY, 0.5, 2.0, HashTable::ProbeMode::PSEUDO_RANDOM, HashTable::CapacityPolicy::POWER_OF_TWO,
+                      0.25, 0.0, 0, NUM_THREADS);
+        for (size_t i = 0; i < NUM_KEYS; i++)
+            ht1.insert("key" + to_string(i), i);
+        for (size_t i = 0; i < NUM_KEYS; i += 2)
+            ht1.remove("key" + to_string(i));
+        OUTSTREAM << "Compacting a table of capacity " << ht1.capacity() << " holding " << ht1.size() << " entries with "
+                  << NUM_THREADS << " threads..." << endl;
+        ht1.compact();
+        bool ok = (ht1.capacity() == CAPACITY) && (ht1.size() == NUM_KEYS / 2) && (ht1.keys().size() == NUM_KEYS / 2) && (ht1.tombstones() == 0);
+        for (size_t i = 0; i < NUM_KEYS; i++)
+            ok &= (i % 2 == 0) ? !ht1.contains("key" + to_string(i)) : ht1.get("key" + to_string(i)) == optional<size_t>(i);
+
+        OUTSTREAM << "Reinserting removed entries until the table grows..." << endl;
+        for (size_t i = 0; i < NUM_KEYS; i += 2)
+            ok &= ht1.insert("key" + to_string(i), i);
+        for (size_t i = NUM_KEYS; ht1.capacity() == CAPACITY; i++)
+            ok &= ht1.insert("key" + to_string(i), i);
+        const size_t numGrown = ht1.size();
+        ok &= (ht1.capacity() == CAPACITY * 2) && (ht1.keys().size() == numGrown) && !ht1.insert("key0", 0);
+        for (size_t i = 0; i < numGrown; i++)
+            ok &= ht1.get("key" + to_string(i)) == optional<size_t>(i);
+        OUTSTREAM << (ok ? "SUCCESS: every entry survived compaction and growth split across threads."
+                         : "FAILURE: entries were lost or duplicated by a rehash split across threads.")
+                  << endl << endl;
+    } catch (exception& e) {
+        OUTSTREAM << "Exception: " << e.what() << endl << endl;
+    }
+#else
+    OUTSTREAM << "*** DID NOT TEST PARALLEL REHASH ***" << endl << endl;
+#endif
+
+    // =====================================================================
+    // ARENA KEYS
+    // =====================================================================
+    OUTSTREAM << "Testing arena key storage" << endl;
+    OUTSTREAM << "-------------------------" << endl << endl;
+#ifdef HT_ARENA_KEYS
+    try {
+        constexpr size_t NUM_KEYS = 3000; // Enough 40+ character keys to fill several slabs.
+        constexpr size_t NUM_KEPT = 10;
+        auto arenaKey = [](size_t i) { return string(40, 'k') + to_string(i); };
+        std::optional<ArenaHashTable> at1(std::in_place);
+        OUTSTREAM << "Inserting " << NUM_KEYS << " long keys..." << endl;
+        bool ok = true;
+        for (size_t i = 0; i < NUM_KEYS; i++)
+            ok &= at1->insert(arenaKey(i), i); // The key is copied into the arena before the string is destroyed.
+        ok &= !at1->insert(arenaKey(0), 0);
+        const size_t fullArena = at1->arenaCapacity();
+        OUTSTREAM << "Arena characters after inserts: " << fullArena << endl;
+
+        OUTSTREAM << "Removing all but " << NUM_KEPT << " keys and compacting..." << endl;
+        for (size_t i = NUM_KEPT; i < NUM_KEYS; i++)
+            ok &= at1->remove(arenaKey(i));
+        at1->compact();
+        OUTSTREAM << "Arena characters after compaction: " << at1->arenaCapacity() << endl;
+        ok &= at1->arenaCapacity() < fullArena;
+
+        OUTSTREAM << "Copying the table and destroying the original..." << endl;
+        ArenaHashTable at2(*at1);
+        at1.reset();
+        ok &= (at2.size() == NUM_KEPT) && (at2.keys().size() == NUM_KEPT);
+        for (size_t i = 0; i < NUM_KEYS; i++)
+            ok &= (i < NUM_KEPT) ? at2.get(arenaKey(i)) == i : !at2.contains(arenaKey(i));
+        OUTSTREAM << (ok ? "SUCCESS: arena keys survived removal, compaction, and copying, and compaction released arena space."
+                         : "FAILURE: arena keys were lost, or compaction did not release arena space.")
+                  << endl << endl;
+    } catch (exception& e) {
+        OUTSTREAM << "Exception: " << e.what() << endl << endl;
+    }
+#else
+    OUTSTREAM << "*** DID NOT TEST ARENA KEYS ***" << endl << endl;
+#endif
+
+    // =====================================================================
+    // MEMORY RESOURCE
+    // =====================================================================
+    OUTSTREAM << "Testing allocation from a memory resource" << endl;
+    OUTSTREAM << "-----------------------------------------" << endl << endl;
+#ifdef HT_MEMORY_RESOURCE
+    try {
+        // Upstream allocations throw, so the table must stay within the buffer (and never fall back to the global heap).
+        vector<std::byte> buffer(size_t{1} << 20);
+        std::pmr::monotonic_buffer_resource pool(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+        bool ok = true;
+        {
+            ArenaHashTable at1(MAXHASH, 0.5, 2.0, ArenaHashTable::ProbeMode::PSEUDO_RANDOM, ArenaHashTable::CapacityPolicy::POWER_OF_TWO,
+                               0.25, 0.0, 0, 1, &pool);
+            OUTSTREAM << "Inserting " << MAXHASH * 2 << " entries into a table backed by a monotonic buffer..." << endl;
+            for (size_t i = 1; i <= MAXHASH * 2; i++)
+                ok &= at1.insert(make_key<std::string>(i) + string(40, '_'), i); // Too long for the small string buffer.
+            for (size_t i = 1; i <= MAXHASH * 2; i++)
+                ok &= at1.get(make_key<std::string>(i) + string(40, '_')) == i;
+            OUTSTREAM << "Capacity after rehashing: " << at1.capacity() << endl;
+            ok &= (at1.memoryResource() == &pool) && (at1.capacity() > MAXHASH);
+        } // The buffer is only released by the pool, all at once.
+        OUTSTREAM << (ok ? "SUCCESS: the table allocated its buckets and keys from the given memory resource."
+                         : "FAILURE: the table did not work from the given memory resource.")
+                  << endl << endl;
+    } catch (exception& e) {
+        OUTSTREAM << "Exception: " << e.what() << endl << endl;
+    }
+#else
+    OUTSTREAM << "*** DID NOT TEST MEMORY RESOURCE ***" << endl << endl;
+#endif
+
+    // =====================================================================
+    // UPSERT
+    // =====================================================================
+    OUTSTREAM << "Testing HashTable::insert_or_assign(), try_emplace(), and getOrInsert()" << endl;
+    OUTSTREAM << "-----------------------------------------------------------------------" << endl << endl;
+#ifdef HT_UPSERT
+    try {
+        HashTable ht1;
+        bool ok = true;
+        OUTSTREAM << "insert_or_assign() on new and then existing keys..." << endl;
+        for (size_t i = 1; i <= MAXHASH; i++)
+            ok &= ht1.insert_or_assign(make_key<key_type>(i), make_value<value_type>(i));
+        for (size_t i = 1; i <= MAXHASH; i++)
+            ok &= !ht1.insert_or_assign(make_key<key_type>(i), make_value<value_type>(i + 1));
+        for (size_t i = 1; i <= MAXHASH; i++)
+            ok &= ht1.get(make_key<key_type>(i)) == make_value<value_type>(i + 1);
+
+        OUTSTREAM << "try_emplace() on existing and then new keys..." << endl;
+        for (size_t i = 1; i <= MAXHASH; i++)
+            ok &= !ht1.try_emplace(make_key<key_type>(i), make_value<value_type>(0));
+        for (size_t i = MAXHASH + 1; i <= MAXHASH * 2; i++)
+            ok &= ht1.try_emplace(make_key<key_type>(i), make_value<value_type>(i));
+        for (size_t i = 1; i <= MAXHASH * 2; i++)
+            ok &= ht1.get(make_key<key_type>(i)) == make_value<value_type>(i <= MAXHASH ? i + 1 : i);
+
+        OUTSTREAM << "getOrInsert() through several rehashes..." << endl;
+        HashTable ht2(2);
+        for (size_t i = 1; i <= MAXHASH * 2; i++)
+            ht2.getOrInsert(make_key<key_type>(i)) = make_value<value_type>(i); // Inserting may rehash before the reference is returned.
+        for (size_t i = 1; i <= MAXHASH * 2; i++)
+            ok &= ht2.getOrInsert(make_key<key_type>(i)) == make_value<value_type>(i);
+        ok &= (ht1.size() == MAXHASH * 2) && (ht2.size() == MAXHASH * 2);
+        OUTSTREAM << (ok ? "SUCCESS: upserts inserted absent keys and assigned or kept present ones."
+                         : "FAILURE: an upsert inserted a duplicate, or lost or ignored a value.")
+                  << endl << endl;
+    } catch (exception& e) {
+        OUTSTREAM << "Exception: " << e.what() << endl << endl;
+    }
+#else
+    OUTSTREAM << "*** DID NOT TEST UPSERT ***" << endl << endl;
+#endif
+
+    // =====================================================================
+    // BATCH LOOKUP
+    // =====================================================================
+    OUTSTREAM << "Testing HashTable::get_many(), contains_many(), and remove_many()" << endl;
+    OUTSTREAM << "-----------------------------------------------------------------" << endl << endl;
+#ifdef HT_BATCH_LOOKUP
+    try {
+        HashTable ht1;
+        for (size_t i = 1; i <= MAXHASH; i++)
+            ht1.insert(make_key<key_type>(i), make_value<value_type>(i));
+        // Look up present and missing keys alternately, more than PREFETCH_DISTANCE of them.
+        vector<key_type> keyStore;
+        for (size_t i = 1; i <= MAXHASH * 2; i++)
+            keyStore.push_back(make_key<key_type>(i));
+        const vector<HashTable::LookupKey> lookupKeys(keyStore.begin(), keyStore.end());
+        vector<optional<value_type>> values(lookupKeys.size());
+        unique_ptr<bool[]> found(new bool[lookupKeys.size()]);
+        OUTSTREAM << "Looking up " << lookupKeys.size() << " keys in one batch..." << endl;
+        bool ok = (ht1.get_many(lookupKeys, values) == MAXHASH)
+               && (ht1.contains_many(lookupKeys, std::span<bool>(found.get(), lookupKeys.size())) == MAXHASH);
+        for (size_t i = 0; i < lookupKeys.size(); i++) {
+            const bool present = i < MAXHASH;
+            ok &= (values[i] == (present ? optional<value_type>(make_value<value_type>(i + 1)) : nullopt)) && (found[i] == present);
+        }
+        OUTSTREAM << "Removing every key in one batch..." << endl;
+        ok &= (ht1.remove_many(lookupKeys) == MAXHASH) && (ht1.size() == 0);
+
+        // Batches are hashed in blocks; cover many full blocks and a partial one.
+        constexpr size_t NUM_INT_KEYS = 1000;
+        HashTable_t<size_t, size_t> ht2;
+        for (size_t i = 0; i < NUM_INT_KEYS; i++)
+            ht2.insert(i, i * 3);
+        vector<size_t> intKeys;
+        for (size_t i = 0; i < NUM_INT_KEYS * 2 + 37; i++)
+            intKeys.push_back(i);
+        vector<optional<size_t>> intValues(intKeys.size());
+        unique_ptr<bool[]> intFound(new bool[intKeys.size()]);
+        OUTSTREAM << "Looking up " << intKeys.size() << " integer keys in one batch..." << endl;
+        ok &= (ht2.get_many(intKeys, intValues) == NUM_INT_KEYS)
+           && (ht2.contains_many(intKeys, std::span<bool>(intFound.get(), intKeys.size())) == NUM_INT_KEYS);
+        for (size_t i = 0; i < intKeys.size(); i++) {
+            const bool present = i < NUM_INT_KEYS;
+            ok &= (intValues[i] == (present ? optional<size_t>(i * 3) : nullopt)) && (intFound[i] == present);
+        }
+        ok &= (ht2.remove_many(intKeys) == NUM_INT_KEYS) && (ht2.size() == 0);
+        OUTSTREAM << (ok ? "SUCCESS: batched lookups and removals matched the individual ones."
+                         : "FAILURE: batched lookups or removals gave wrong results.")
+                  << endl << endl;
+    } catch (exception& e) {
+        OUTSTREAM << "Exception: " << e.what() << endl << endl;
+    }
+#else
+    OUTSTREAM << "*** DID NOT TEST BATCH LOOKUP ***" << endl << endl;
+#endif
+
+    // =====================================================================
+    // ITERATION
+    // =====================================================================
+    OUTSTREAM << "Testing HashTable iterators and for_each()" << endl;
+    OUTSTREAM << "------------------------------------------" << endl << endl;
+#ifdef HT_ITERATION
+    try {
+        static_assert(std::forward_iterator<HashTable::iterator> && std::forward_iterator<HashTable::const_iterator>);
+        constexpr size_t NUM_KEYS = 1000;
+        HashTable ht1;
+        for (size_t i = 0; i < NUM_KEYS; i++)
+            ht1.insert("key" + to_string(i), i);
+        for (size_t i = 0; i < NUM_KEYS; i += 4)
+            ht1.remove("key" + to_string(i));
+        OUTSTREAM << "Incrementing every value through iterators..." << endl;
+        size_t numVisited = 0;
+        for (auto [key, value] : ht1) {
+            ++value;
+            ++numVisited;
+        }
+        bool ok = (numVisited == ht1.size()) && (std::distance(std::as_const(ht1).begin(), std::as_const(ht1).end()) == static_cast<std::ptrdiff_t>(ht1.size()));
+        for (size_t i = 0; ok && i < NUM_KEYS; i++)
+            ok &= ht1.get("key" + to_string(i)) == (i % 4 == 0 ? nullopt : optional<size_t>(i + 1));
+
+        OUTSTREAM << "Visiting with for_each, for_each_chunk, and parallel_for_each..." << endl;
+        size_t valueSum = 0;
+        std::as_const(ht1).for_each([&valueSum](const std::string&, const size_t value) { valueSum += value; });
+        size_t chunkSum = 0;
+        size_t numChunks = 0;
+        size_t cursor = 0;
+        do {
+            cursor = ht1.for_each_chunk(cursor, 100, [&chunkSum](const std::string&, const size_t value) { chunkSum += value; });
+            ++numChunks;
+        } while (cursor != 0);
+        ok &= (valueSum == chunkSum) && (numChunks == (ht1.capacity() + 99) / 100);
+        HashTable ht2(static_cast<size_t>(1) << 18, 0.5, 2.0, HashTable::ProbeMode::PSEUDO_RANDOM, HashTable::CapacityPolicy::POWER_OF_TWO, 0.25, 0.0, 0, 4);
+        for (size_t i = 0; i < NUM_KEYS; i++)
+            ht2.insert("key" + to_string(i), i);
+        std::atomic<size_t> parallelSum{0};
+        ht2.parallel_for_each([&parallelSum](const std::string&, size_t& value) { parallelSum += value; value = 0; });
+        ok &= (parallelSum == NUM_KEYS * (NUM_KEYS - 1) / 2) && (ht2.get("key7") == optional<size_t>(0));
+
+        OUTSTREAM << "Iterating during an incremental rehash, and copying a table through its iterators..." << endl;
+        HashTable ht3(8, 0.5, 2.0, HashTable::ProbeMode::PSEUDO_RANDOM, HashTable::CapacityPolicy::POWER_OF_TWO, 0.25, 0.0, 2);
+        for (size_t i = 0; i < NUM_KEYS; i++)
+            ht3.insert("key" + to_string(i), i);
+        ok &= ht3.isMigrating();
+        size_t migratingSum = 0;
+        for (const auto [key, value] : std::as_const(ht3))
+            migratingSum += value;
+        ConcurrentTable ct1;
+        ct1.insert(make_key<key_type>(0), make_value<value_type>(0));
+        size_t numConcurrent = 0;
+        ct1.for_each([&numConcurrent](const key_type&, const value_type&) { ++numConcurrent; });
+        HashTable ht4;
+        ok &= (migratingSum == NUM_KEYS * (NUM_KEYS - 1) / 2) && (ht4.insert(ht1.begin(), ht1.end()) == ht1.size()) && (ht4.get("key1") == optional<size_t>(2)) && (numConcurrent == 1);
+        OUTSTREAM << (ok ? "SUCCESS: every key-value pair was visited exactly once, and values were modified in place."
+                         : "FAILURE: a key-value pair was skipped, visited twice, or not modified.")
+                  << endl << endl;
+    } catch (exception& e) {
+        OUTSTREAM << "Exception: " << e.what() << endl << endl;
+    }
+#else
+    OUTSTREAM << "*** DID NOT TEST ITERATION ***" << endl << endl;
+#endif
+
+    // =====================================================================
+    // STATS
+    // =====================================================================
+    OUTSTREAM << "Testing HashTable::stats()" << endl;
+    OUTSTREAM << "--------------------------" << endl << endl;
+#ifdef HT_STATS
+    try {
+        HashTable ht1;
+        for (size_t i = 1; i <= MAXHASH; i++)
+            ht1.insert(make_key<key_type>(i), make_value<value_type>(i));
+        OUTSTREAM << "Looking up " << MAXHASH << " present and " << MAXHASH << " missing keys..." << endl;
+        for (size_t i = 1; i <= MAXHASH * 2; i++)
+            (void)ht1.contains(make_key<key_type>(i));
+        const HashTableStats stats = ht1.stats();
+        bool ok = (stats.size == ht1.size()) && (stats.capacity == ht1.capacity()) && (stats.tombstones == ht1.tombstones())
+               && (stats.bytesAllocated >= ht1.capacity());
+        if (stats.enabled) {
+            OUTSTREAM << "Statistics enabled: " << stats.hits() << " hits, " << stats.misses() << " misses, "
+                      << stats.numRehashes << " rehashes, longest probe " << stats.maxProbeLength << " windows" << endl;
+            // Every insertion of a new key is a miss, followed by MAXHASH hits and MAXHASH misses.
+            ok &= (stats.hits() == MAXHASH) && (stats.misses() == MAXHASH * 2) && (stats.numRehashes > 0)
+               && (stats.maxProbeLength >= 1) && (stats.meanHitProbeLength() >= 1.0) && (stats.tombstonesCrossed == 0);
+        }
+        else {
+            OUTSTREAM << "Statistics disabled (HASHTABLE_ENABLE_STATS not defined)" << endl;
+            ok &= (stats.hits() == 0) && (stats.misses() == 0) && (stats.numRehashes == 0);
+        }
+        OUTSTREAM << (ok ? "SUCCESS: stats() reported the operations performed."
+                         : "FAILURE: stats() reported wrong values.")
+                  << endl << endl;
+    } catch (exception& e) {
+        OUTSTREAM << "Exception: " << e.what() << endl << endl;
+    }
+#else
+    OUTSTREAM << "*** DID NOT TEST STATS ***" << endl << endl;
+#endif
+
+    // =====================================================================
+    // SNAPSHOT
+    // =====================================================================
+    OUTSTREAM << "Testing HashTable::save() and load()" << endl;
+    OUTSTREAM << "------------------------------------" << endl << endl;
+#ifdef HT_SNAPSHOT
+    try {
+        constexpr size_t NUM_KEYS = 1000;
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "hashtable_tests_snapshot.bin";
+        HashTable ht1;
+        for (size_t i = 0; i < NUM_KEYS; i++)
+            ht1.insert("key" + to_string(i), i);
+        for (size_t i = 0; i < NUM_KEYS; i += 3)
+            ht1.remove("key" + to_string(i));
+        OUTSTREAM << "Saving a table of " << ht1.size() << " keys and " << ht1.tombstones() << " tombstones..." << endl;
+        bool ok = ht1.save(path);
+        std::optional<HashTable> ht2 = HashTable::load(path);
+        ok &= ht2.has_value() && (ht2->size() == ht1.size()) && (ht2->capacity() == ht1.capacity()) && (ht2->tombstones() == ht1.tombstones());
+        for (size_t i = 0; ok && i < NUM_KEYS; i++)
+            ok &= (ht2->get("key" + to_string(i)) == (i % 3 == 0 ? nullopt : optional<value_type>(i)));
+        ok &= ht2.has_value() && ht2->insert("key0", 0) && !ht2->insert("key1", 1);
+
+        OUTSTREAM << "Saving and loading a table with arena keys..." << endl;
+        ArenaHashTable at1;
+        for (size_t i = 0; i < NUM_KEYS; i++)
+            at1.insert("key" + to_string(i), i);
+        ok &= at1.save(path);
+        std::optional<ArenaHashTable> at2 = ArenaHashTable::load(path);
+        ok &= at2.has_value() && (at2->size() == NUM_KEYS);
+        for (size_t i = 0; ok && i < NUM_KEYS; i++)
+            ok &= (at2->get("key" + to_string(i)) == optional<value_type>(i));
+
+        OUTSTREAM << "Loading a snapshot of the wrong key type, a truncated one, corrupt ones, and a missing one..." << endl;
+        ok &= !HashTable_t<size_t, size_t>::load(path).has_value();
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2);
+        ok &= !ArenaHashTable::load(path).has_value();
+        // Overwrites one header field of a fresh snapshot, and reports whether the snapshot still loads.
+        auto loadsWith = [&at1, &path](const size_t offset, const auto field) {
+            at1.save(path);
+            std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(static_cast<std::streamoff>(offset));
+            file.write(reinterpret_cast<const char*>(&field), sizeof(field));
+            file.close();
+            return ArenaHashTable::load(path).has_value();
+        };
+        ok &= !loadsWith(offsetof(SnapshotHeader, minCapacity), static_cast<uint64_t>(at1.capacity() * 2))
+           && !loadsWith(offsetof(SnapshotHeader, threshold), 0.0) && !loadsWith(offsetof(SnapshotHeader, threshold), 1.5)
+           && !loadsWith(offsetof(SnapshotHeader, threshold), std::numeric_limits<double>::quiet_NaN())
+           && !loadsWith(offsetof(SnapshotHeader, resizeFactor), 1.0)
+           && !loadsWith(offsetof(SnapshotHeader, resizeFactor), std::numeric_limits<double>::quiet_NaN())
+           && loadsWith(offsetof(SnapshotHeader, rehashThreads), static_cast<uint64_t>(1) << 40); // Capped, not rejected.
+        std::filesystem::remove(path);
+        ok &= !HashTable::load(path).has_value();
+        OUTSTREAM << (ok ? "SUCCESS: loaded tables matched the saved ones, and invalid snapshots were rejected."
+                         : "FAILURE: a loaded table differed from the saved one, or an invalid snapshot was accepted.")
+                  << endl << endl;
+    } catch (exception& e) {
+        OUTSTREAM << "Exception: " << e.what() << endl << endl;
+    }
+#else
+    OUTSTREAM << "*** DID NOT TEST SNAPSHOT ***" << endl << endl;
+#endif
+
+    // =====================================================================
+    // HASHERS
+    // =====================================================================
+    OUTSTREAM << "Testing seeded hash functions (Hashers.h)" << endl;
+    OUTSTREAM << "-----------------------------------------" << endl << endl;
+#ifdef HT_HASHERS
+    try {
+        constexpr size_t NUM_KEYS = 2000;
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "hashtable_tests_hashers.bin";
+        OUTSTREAM << "Checking reference values of wyhash and XXH64..." << endl;
+        bool ok = (WyHash(0)("") == 0x93228a4de0eec5a2ULL) && (WyHash(2)("abc") == 0xa97f2f7b1d9b3314ULL)
+               && (XXHash64(0)("") == 0xEF46DB3751D8E999ULL) && (XXHash64(0)("abc") == 0x44BC2CF5AD770999ULL);
+        const auto testHasher = [&]<typename Hasher>(const std::string& name) {
+            OUTSTREAM << "Rehashing, migrating, and snapshotting tables hashed by " << name << "..." << endl;
+            using StringTable = HashTable_t<std::string, size_t, Hasher>;
+            using IntegerTable = HashTable_t<size_t, size_t, Hasher>;
+            StringTable st1(8, 0.5, 2.0, StringTable::ProbeMode::PSEUDO_RANDOM, StringTable::CapacityPolicy::POWER_OF_TWO, 0.25, 0.0, 2);
+            IntegerTable it1(8, 0.5, 2.0, IntegerTable::ProbeMode::PSEUDO_RANDOM, IntegerTable::CapacityPolicy::POWER_OF_TWO, 0.25, 0.0, 2);
+            const StringTable st2;
+            const uint64_t seed = st1.hash_function().seed();
+            bool hasherOk = (seed != st2.hash_function().seed()) && (Hasher(seed)("key") == st1.hash_function()("key"))
+                         && (Hasher(seed)("key") != st2.hash_function()("key"));
+            for (size_t i = 0; i < NUM_KEYS; i++) {
+                st1.insert("key" + to_string(i), i);
+                it1.insert(i * 7919, i);
+                if (it1.isMigrating()) // Keys of the old buckets are hashed again as they are migrated.
+                    hasherOk &= it1.contains(0) && (it1.get(i / 2 * 7919) == optional<size_t>(i / 2));
+            }
+            for (size_t i = 0; i < NUM_KEYS; i += 2) {
+                st1.remove("key" + to_string(i));
+                it1.remove(i * 7919);
+            }
+            hasherOk &= (st1.hash_function().seed() == seed) && st1.save(path);
+            std::optional<StringTable> st3 = StringTable::load(path);
+            hasherOk &= st3.has_value() && (st3->hash_function().seed() == seed) && (st3->size() == NUM_KEYS / 2) && (it1.size() == NUM_KEYS / 2);
+            for (size_t i = 0; hasherOk && i < NUM_KEYS; i++)
+                hasherOk &= (st3->get("key" + to_string(i)) == (i % 2 == 0 ? nullopt : optional<size_t>(i)))
+                          && (it1.get(i * 7919) == (i % 2 == 0 ? nullopt : optional<size_t>(i)));
+            ok &= hasherOk;
+        };
+        testHasher.template operator()<WyHash>("WyHash");
+        testHasher.template operator()<XXHash64>("XXHash64");
+        testHasher.template operator()<AesHash>(AesHash::HARDWARE_ACCELERATED ? "AesHash (AES instructions)" : "AesHash (WyHash fallback)");
+        std::filesystem::remove(path);
+        OUTSTREAM << (ok ? "SUCCESS: every table kept one random seed through rehashing, migration, and snapshots."
+                         : "FAILURE: a hash value was wrong, or a table lost keys or its seed.")
+                  << endl << endl;
+    } catch (exception& e) {
+        OUTSTREAM << "Exception: " << e.what() << endl << endl;
+    }
+#else
+    OUTSTREAM << "*** DID NOT TEST HASHERS ***" << endl << endl;
+#endif
+
+    // =====================================================================
+    // FROZEN
+    // =====================================================================
+    OUTSTREAM << "Testing FrozenHashTable" << endl;
+    OUTSTREAM << "-----------------------" << endl << endl;
+#ifdef HT_FROZEN
+    try {
+        constexpr size_t NUM_KEYS = 10000;
+        HashTable ht1;
+        for (size_t i = 0; i < NUM_KEYS; i++)
+            ht1.insert("key" + to_string(i), i);
+        for (size_t i = 0; i < NUM_KEYS; i += 5)
+            ht1.remove("key" + to_string(i));
+        FrozenHashTable ft1(ht1);
+        OUTSTREAM << "Froze " << ft1.size() << " keys into " << ft1.capacity() << " slots (load factor " << ft1.alpha() << ")..." << endl;
+        bool ok = (ft1.size() == ht1.size()) && (ft1.keys().size() == ht1.size()) && (ft1.alpha() >= 0.98);
+        for (size_t i = 0; ok && i < NUM_KEYS; i++)
+            ok &= (ft1.get("key" + to_string(i)) == (i % 5 == 0 ? nullopt : optional<size_t>(i))) && (ft1.contains("key" + to_string(i)) == (i % 5 != 0));
+        ok &= !ft1.contains("") && !ft1.contains("missing");
+        ft1["key1"] = 100;
+        ok &= (ft1.get("key1") == optional<size_t>(100)) && (ht1.get("key1") == optional<size_t>(1));
+
+        OUTSTREAM << "Batched lookups..." << endl;
+        vector<std::string> batch;
+        for (size_t i = 0; i < 64; i++)
+            batch.push_back("key" + to_string(i));
+        vector<std::string_view> views(batch.begin(), batch.end());
+        vector<optional<size_t>> values(views.size());
+        std::unique_ptr<bool[]> results(new bool[views.size()]);
+        ok &= (ft1.get_many(views, values) == 51) && (ft1.contains_many(views, std::span<bool>(results.get(), views.size())) == 51);
+        for (size_t i = 2; ok && i < views.size(); i++)
+            ok &= (values[i] == (i % 5 == 0 ? nullopt : optional<size_t>(i))) && (results[i] == (i % 5 != 0));
+
+        OUTSTREAM << "Freezing tables with arena keys and integer keys..." << endl;
+        std::optional<FrozenHashTable_t<ArenaString, size_t>> ft2;
+        {
+            ArenaHashTable at1;
+            for (size_t i = 0; i < NUM_KEYS; i++)
+                at1.insert("key" + to_string(i), i);
+            ft2.emplace(at1);
+        }
+        HashTable_t<size_t, size_t> it1;
+        for (size_t i = 0; i < NUM_KEYS; i++)
+            it1.insert(i * 64, i);
+        FrozenHashTable_t<size_t, size_t> ft3(it1);
+        FrozenHashTable ft4{HashTable()};
+        for (size_t i = 0; ok && i < NUM_KEYS; i++)
+            ok &= (ft2->get("key" + to_string(i)) == optional<size_t>(i)) && (ft3.get(i * 64) == optional<size_t>(i)) && !ft3.contains(i * 64 + 1);
+        ok &= (ft4.size() == 0) && !ft4.contains("key0");
+        OUTSTREAM << (ok ? "SUCCESS: frozen tables held exactly the keys of the tables they were built from."
+                         : "FAILURE: a frozen table lost a key, or reported a key it was not built from.")
+                  << endl << endl;
+    } catch (exception& e) {
+        OUTSTREAM << "Exception: " << e.what() << endl << endl;
+    }
+#else
+    OUTSTREAM << "*** DID NOT TEST FROZEN ***" << endl << endl;
+#endif
+
+    // =====================================================================
+    // ENGINES
+    // =====================================================================
+    OUTSTREAM << "Testing RobinHoodHashTable and HopscotchHashTable" << endl;
+    OUTSTREAM << "-------------------------------------------------" << endl << endl;
+#ifdef HT_ENGINES
+    try {
+        constexpr size_t NUM_KEYS = 2000;
+        constexpr size_t NUM_OPERATIONS = 200000;
+        bool ok = true;
+        const auto testEngine = [&]<typename Table, typename IntegerTable>(const string& engine) {
+            OUTSTREAM << engine << ": inserting " << NUM_KEYS << " keys, removing every third..." << endl;
+            Table et1;
+            for (size_t i = 0; i < NUM_KEYS; i++)
+                ok &= et1.insert("key" + to_string(i), i) && !et1.insert("key" + to_string(i), i);
+            for (size_t i = 0; i < NUM_KEYS; i += 3)
+                ok &= et1.remove("key" + to_string(i)) && !et1.remove("key" + to_string(i));
+            ok &= (et1.size() == NUM_KEYS - (NUM_KEYS + 2) / 3) && (et1.keys().size() == et1.size()) && (et1.tombstones() == 0) && (et1.alpha() < 0.5);
+            for (size_t i = 0; ok && i < NUM_KEYS; i++)
+                ok &= (et1.get("key" + to_string(i)) == (i % 3 == 0 ? nullopt : optional<size_t>(i))) && (et1.contains("key" + to_string(i)) == (i % 3 != 0));
+            et1["key1"] = 100;
+            ok &= (et1["key1"] == 100) && !et1.insert_or_assign("key1", 101) && et1.insert_or_assign("key0", 0) && (et1.get("key1") == optional<size_t>(101));
+
+            OUTSTREAM << engine << ": " << NUM_OPERATIONS << " random operations on integer keys at load factor 0.9, checked against std::unordered_map..." << endl;
+            IntegerTable et2(1024, 0.9);
+            unordered_map<size_t, size_t> reference;
+            std::mt19937_64 rngEngine(42);
+            for (size_t op = 0; ok && op < NUM_OPERATIONS; op++) {
+                const size_t key = rngEngine() % 1024;
+                switch (rngEngine() % 3) {
+                    case 0: ok &= et2.insert(key, op) == reference.emplace(key, op).second; break;
+                    case 1: ok &= et2.remove(key) == (reference.erase(key) != 0); break;
+                    default: ok &= et2.get(key) == (reference.contains(key) ? optional<size_t>(reference.at(key)) : nullopt); break;
+                }
+            }
+            ok &= (et2.size() == reference.size()) && (et2.capacity() == 1024);
+            while (ok && et2.alpha() < 0.85)
+                ok &= et2.insertTCT(rngEngine(), 0) >= 1;
+            ok &= (et2.removeTCT(rngEngine()) >= 1) && (et2.tombstones() == 0);
+
+            // Keys 2^16 apart share the low bits of their hash under std::hash; mixing must still spread them.
+            OUTSTREAM << engine << ": inserting " << NUM_KEYS * 8 << " integer keys at a stride of 2^16..." << endl;
+            IntegerTable et3(NUM_KEYS * 32);
+            size_t totalProbes = 0;
+            for (size_t i = 0; i < NUM_KEYS * 8; i++)
+                totalProbes += et3.insertTCT(i << 16, i);
+            const double meanProbes = static_cast<double>(totalProbes) / static_cast<double>(NUM_KEYS * 8);
+            OUTSTREAM << engine << ": mean insert probes " << meanProbes << endl;
+            ok &= (meanProbes < 3.0) && (et3.size() == NUM_KEYS * 8) && (et3.get(size_t{5} << 16) == optional<size_t>(5));
+        };
+        testEngine.template operator()<RobinHoodHashTable, RobinHoodHashTable_t<size_t, size_t>>("RobinHoodHashTable");
+        testEngine.template operator()<HopscotchHashTable, HopscotchHashTable_t<size_t, size_t>>("HopscotchHashTable");
+
+        // More keys with one hash than a neighborhood holds can never be separated by growing the table.
+        OUTSTREAM << "HopscotchHashTable: inserting 100 keys with the same hash..." << endl;
+        struct ConstHash {
+            size_t operator()(int) const { return 7; }
+        };
+        HopscotchHashTable_t<int, int, ConstHash> et4;
+        for (int i = 0; i < 100; i++)
+            ok &= et4.insert(i, i) && !et4.insert(i, i);
+        ok &= (et4.size() == 100) && (et4.keys().size() == 100) && (et4.capacity() < 1024);
+        for (int i = 0; i < 100; i += 2)
+            ok &= et4.remove(i) && !et4.remove(i);
+        et4[99] = 199;
+        for (int i = 0; ok && i < 100; i++)
+            ok &= (et4.get(i) == (i % 2 == 0 ? nullopt : optional<int>(i == 99 ? 199 : i)));
+        ok &= (et4.size() == 50) && !et4.contains(100);
+        OUTSTREAM << (ok ? "SUCCESS: every engine stored exactly the keys inserted and not removed, without tombstones."
+                         : "FAILURE: an engine lost a key, kept a removed one, or left tombstones.")
+                  << endl << endl;
+    } catch (exception& e) {
+        OUTSTREAM << "Exception: " << e.what() << endl << endl;
+    }
+#else
+    OUTSTREAM << "*** DID NOT TEST ENGINES ***" << endl << endl;
+#endif
+
+    // =====================================================================
+    // CONCURRENT
+    // =====================================================================
+    OUTSTREAM << "Testing ConcurrentHashTable with multiple threads" << endl;
+    OUTSTREAM << "-------------------------------------------------" << endl << endl;
+#ifdef HT_CONCURRENT
+    try {
+        constexpr size_t NUM_THREADS = 4;
+        constexpr size_t NUM_KEYS = 20000;
+        ConcurrentHashTable_t<size_t, size_t> ct1(2, 4); // Small initial capacity and few shards, so every shard rehashes under contention.
+        std::atomic<size_t> numInserted{0};
+        OUTSTREAM << "Inserting " << NUM_KEYS << " entries from each of " << NUM_THREADS << " threads while reading..." << endl;
+        vector<thread> threads;
+        for (size_t t = 0; t < NUM_THREADS; t++) {
+            threads.emplace_back([&ct1, &numInserted] {
+                for (size_t i = 0; i < NUM_KEYS; i++) {
+                    numInserted += ct1.insert(i, i);
+                    (void)ct1.get(i / 2);
+                }
+            });
+        }
+        for (thread& th : threads)
+            th.join();
+        OUTSTREAM << "Successful inserts: " << numInserted << ", capacity: " << ct1.capacity() << endl;
+        bool ok = (numInserted == NUM_KEYS) && (ct1.size() == NUM_KEYS) && (ct1.keys().size() == NUM_KEYS);
+
+        // Each thread removes every third of its share of the keys while inserting as many new ones;
+        // the first thread also reserves room for all of them halfway through, racing the other threads' rehashes.
+        OUTSTREAM << "Removing a third of the entries while inserting " << NUM_KEYS << " more and reserving..." << endl;
+        std::atomic<size_t> numRemoved{0};
+        threads.clear();
+        for (size_t t = 0; t < NUM_THREADS; t++) {
+            threads.emplace_back([&ct1, &numInserted, &numRemoved, t] {
+                for (size_t i = t; i < NUM_KEYS; i += NUM_THREADS) {
+                    numInserted += ct1.insert(NUM_KEYS + i, NUM_KEYS + i);
+                    if (i % 3 == 0)
+                        numRemoved += ct1.remove(i);
+                    if (t == 0 && i == NUM_KEYS / 2)
+                        ct1.reserve(NUM_KEYS * 2);
+                }
+            });
+        }
+        for (thread& th : threads)
+            th.join();
+        OUTSTREAM << "Successful removes: " << numRemoved << ", capacity: " << ct1.capacity() << endl;
+
+        const size_t expectedRemoved = (NUM_KEYS + 2) / 3;
+        ok &= (numInserted == NUM_KEYS * 2) && (numRemoved == expectedRemoved) && (ct1.size() == NUM_KEYS * 2 - expectedRemoved)
+           && (ct1.keys().size() == ct1.size());
+        for (size_t i = 0; i < NUM_KEYS * 2; i++)
+            ok &= ct1.get(i) == (i < NUM_KEYS && i % 3 == 0 ? nullopt : optional<size_t>(i));
+
+        constexpr size_t NUM_NAMED_KEYS = 24; // Below the 26 distinct string keys make_key produces.
+        ConcurrentTable ct2;
+        threads.clear();
+        for (size_t t = 0; t < NUM_THREADS; t++) {
+            threads.emplace_back([&ct2, t] {
+                for (size_t i = t; i < NUM_NAMED_KEYS; i += NUM_THREADS)
+                    ct2.insert(make_key<key_type>(i), make_value<value_type>(i));
+            });
+        }
+        for (thread& th : threads)
+            th.join();
+        threads.clear();
+        ok &= (ct2.size() == NUM_NAMED_KEYS);
+        for (size_t i = 0; i < NUM_NAMED_KEYS; i++)
+            ok &= ct2.get(make_key<key_type>(i)) == make_value<value_type>(i);
+
+        if constexpr (std::is_arithmetic_v<value_type>) {
+            constexpr size_t NUM_UPDATES = 1000;
+            OUTSTREAM << "Incrementing one value " << NUM_UPDATES << " times from each thread..." << endl;
+            ct2.insert_or_assign(make_key<key_type>(0), 0);
+            for (size_t t = 0; t < NUM_THREADS; t++) {
+                threads.emplace_back([&ct2] {
+                    for (size_t u = 0; u < NUM_UPDATES; u++)
+                        ct2.update(make_key<key_type>(0), [](value_type& v) { v = v + 1; });
+                });
+            }
+            for (thread& th : threads)
+                th.join();
+            OUTSTREAM << "Final value: " << ct2.get(make_key<key_type>(0)).value_or(0) << endl;
+            ok &= ct2.get(make_key<key_type>(0)) == static_cast<value_type>(NUM_THREADS * NUM_UPDATES);
+        }
+        OUTSTREAM << (ok ? "SUCCESS: each key was inserted exactly once, removals held, and every entry and update survived rehashing."
+                         : "FAILURE: concurrent operations lost or corrupted entries.")
+                  << endl << endl;
+    } catch (exception& e) {
+        OUTSTREAM << "Exception: " << e.what() << endl << endl;
+    }
+#else
+    OUTSTREAM << "*** DID NOT TEST CONCURRENT ***" << endl << endl;
+#endif
+
+    // =====================================================================
+    // SHARDED
+    // =====================================================================
+    OUTSTREAM << "Testing ShardedHashTable with independent shards" << endl;
+    OUTSTREAM << "------------------------------------------------" << endl << endl;
+#ifdef HT_SHARDED
+    try {
+        constexpr size_t NUM_SHARDS = 8;
+        constexpr size_t NUM_KEYS = 40000; // Enough for shard bucket arrays to be allocated on their NUMA nodes.
+        ShardedHashTable_t<size_t, size_t> st1(8, NUM_SHARDS, 0.5, 2.0, ProbeMode::PSEUDO_RANDOM, CapacityPolicy::POWER_OF_TWO, true);
+        OUTSTREAM << "Inserting " << NUM_KEYS << " entries into " << st1.shardCount() << " shards pinned to NUMA nodes..." << endl;
+        bool ok = st1.shardCount() == NUM_SHARDS;
+        for (size_t i = 0; i < NUM_KEYS; i++)
+            ok &= st1.insert(i, i);
+        size_t shardSizes = 0;
+        size_t shardCapacities = 0;
+        for (size_t s = 0; s < st1.shardCount(); s++) {
+            shardSizes += st1.shard(s).size();
+            shardCapacities += st1.shard(s).capacity();
+            ok &= (st1.shard(s).size() > 0) && (st1.shardNode(s) >= 0);
+        }
+        ok &= (st1.size() == NUM_KEYS) && (shardSizes == NUM_KEYS) && (st1.capacity() == shardCapacities)
+           && (st1.alpha() == static_cast<double>(NUM_KEYS) / static_cast<double>(shardCapacities)) && (st1.keys().size() == NUM_KEYS);
+
+        OUTSTREAM << "Growing one shard without touching the others..." << endl;
+        const size_t grown = st1.shardIndex(NUM_KEYS);
+        vector<size_t> capacities;
+        for (size_t s = 0; s < st1.shardCount(); s++)
+            capacities.push_back(st1.shard(s).capacity());
+        for (size_t i = NUM_KEYS; capacities[grown] == st1.shard(grown).capacity(); i++) {
+            if (st1.shardIndex(i) == grown)
+                st1.insert(i, i);
+        }
+        for (size_t s = 0; s < st1.shardCount(); s++)
+            ok &= (s == grown) || (st1.shard(s).capacity() == capacities[s]);
+
+        OUTSTREAM << "Doubling every value from one thread per shard, then removing half the keys..." << endl;
+        st1.parallel_for_each([](const size_t&, size_t& value) { value *= 2; });
+        for (size_t i = 0; i < NUM_KEYS; i += 2)
+            ok &= st1.remove(i);
+        for (size_t i = 0; i < NUM_KEYS; i++)
+            ok &= st1.get(i) == (i % 2 == 0 ? nullopt : optional<size_t>(2 * i));
+
+        OUTSTREAM << "Rehashing shards incrementally, and searching them through a const reference..." << endl;
+        ShardedTable st2(16, 4, 0.5, 2.0, ProbeMode::PSEUDO_RANDOM, CapacityPolicy::POWER_OF_TWO, false, 0.25, 0.0, 1);
+        bool migrated = false;
+        for (size_t i = 0; i < 26; i++) {
+            st2.insert_or_assign(make_key<key_type>(i), make_value<value_type>(i));
+            for (size_t s = 0; s < st2.shardCount(); s++)
+                migrated |= st2.shard(s).isMigrating();
+        }
+        const ShardedTable& constSt2 = st2;
+        for (size_t i = 0; i < 26; i++)
+            ok &= constSt2.contains(make_key<key_type>(i)) && (constSt2.get(make_key<key_type>(i)) == make_value<value_type>(i));
+        ok &= migrated && (st2.shardNode(0) == -1) && (st2.size() == 26) && st2.remove(make_key<key_type>(0)) && !constSt2.contains(make_key<key_type>(0));
+        OUTSTREAM << (ok ? "SUCCESS: shards held every key once, rehashed independently, and were visited in parallel."
+                         : "FAILURE: a shard lost keys, or a rehash touched another shard.")
+                  << endl << endl;
+    } catch (exception& e) {
+        OUTSTREAM << "Exception: " << e.what() << endl << endl;
+    }
+#else
+    OUTSTREAM << "*** DID NOT TEST SHARDED ***" << endl << endl;
+#endif
+
+    // =====================================================================
+    // PREFILTER
+    // =====================================================================
+    OUTSTREAM << "Testing FilteredHashTable and CuckooFilter" << endl;
+    OUTSTREAM << "------------------------------------------" << endl << endl;
+#ifdef HT_PREFILTER
+    try {
+        constexpr size_t NUM_KEYS = 20000;
+        OUTSTREAM << "Overfilling a cuckoo filter..." << endl;
+        CuckooFilter cf1(1000);
+        std::mt19937_64 rng(7);
+        vector<size_t> hashes;
+        while (hashes.size() < 100000) {
+            hashes.push_back(rng());
+            if (!cf1.insert(hashes.back()))
+                break;
+        }
+        bool ok = (hashes.size() < 100000) && (cf1.size() == hashes.size());
+        for (const size_t h : hashes)
+            ok &= cf1.contains(h);
+        for (const size_t h : hashes)
+            ok &= cf1.remove(h);
+        ok &= (cf1.size() == 0) && cf1.insert(hashes.front());
+
+        OUTSTREAM << "Inserting " << NUM_KEYS << " keys through rehashes, then looking up as many absent keys..." << endl;
+        FilteredHashTable_t<size_t, size_t> ft1(8, 0.5, 2.0, ProbeMode::PSEUDO_RANDOM, CapacityPolicy::POWER_OF_TWO, 0.25, 0.05);
+        for (size_t i = 0; i < NUM_KEYS; i++)
+            ok &= ft1.insert(3 * i, i);
+        for (size_t i = 0; i < NUM_KEYS; i++)
+            ok &= ft1.contains(3 * i) && !ft1.contains(3 * i + 1);
+        const PrefilterStats afterLookups = ft1.filterStats();
+        OUTSTREAM << "Filter of " << ft1.filterBytes() << " bytes rejected " << afterLookups.rejected << " of " << NUM_KEYS
+                  << " absent keys (" << afterLookups.falsePositives << " false positives)" << endl;
+        ok &= (afterLookups.lookups == 2 * NUM_KEYS) && (afterLookups.hits() == NUM_KEYS) && (afterLookups.falsePositiveRate() < 0.01);
+
+        OUTSTREAM << "Removing most keys, shrinking the table..." << endl;
+        const size_t grownCapacity = ft1.capacity();
+        for (size_t i = 0; i < NUM_KEYS; i++) {
+            if (i % 16 != 0)
+                ok &= ft1.remove(3 * i);
+        }
+        ok &= (ft1.capacity() < grownCapacity) && (ft1.size() == NUM_KEYS / 16) && !ft1.remove(1);
+        for (size_t i = 0; i < NUM_KEYS; i++)
+            ok &= ft1.get(3 * i) == (i % 16 == 0 ? optional<size_t>(i) : nullopt);
+        ok &= !ft1.insert_or_assign(0, 42) && (ft1.get(0) == optional<size_t>(42));
+
+        FilteredHashTable_t<key_type, value_type> ft2;
+        for (size_t i = 0; i < 26; i++)
+            ft2.insert(make_key<key_type>(i), make_value<value_type>(i));
+        for (size_t i = 0; i < 26; i++)
+            ok &= ft2.get(make_key<key_type>(i)) == make_value<value_type>(i);
+        OUTSTREAM << (ok ? "SUCCESS: the filter never rejected a present key and rejected almost every absent one."
+                         : "FAILURE: the filter rejected a present key, or passed too many absent ones.")
+                  << endl << endl;
+    } catch (exception& e) {
+        OUTSTREAM << "Exception: " << e.what() << endl << endl;
+    }
+#else
+    OUTSTREAM << "*** DID NOT TEST PREFILTER ***" << endl << endl;
+#endif
+
+    // =====================================================================
+    // LOCK FREE
+    // =====================================================================
+    OUTSTREAM << "Testing LockFreeHashTable with multiple threads" << endl;
+    OUTSTREAM << "-----------------------------------------------" << endl << endl;
+#ifdef HT_LOCK_FREE
+    try {
+        constexpr size_t NUM_THREADS = 4;
+        constexpr size_t NUM_KEYS = 20000;
+        LockFreeHashTable_t<size_t, size_t> lf1(2); // Small initial capacity, so the threads resize the table cooperatively.
+        std::atomic<size_t> numInserted{0};
+        OUTSTREAM << "Inserting " << NUM_KEYS << " entries from each of " << NUM_THREADS << " threads..." << endl;
+        vector<thread> threads;
+        for (size_t t = 0; t < NUM_THREADS; t++) {
+            threads.emplace_back([&lf1, &numInserted] {
+                for (size_t i = 0; i < NUM_KEYS; i++) {
+                    numInserted += lf1.insert(i, i);
+                    (void)lf1.contains(i);
+                }
+            });
+        }
+        for (thread& th : threads)
+            th.join();
+        OUTSTREAM << "Successful inserts: " << numInserted << ", capacity: " << lf1.capacity() << endl;
+        bool ok = (numInserted == NUM_KEYS) && (lf1.size() == NUM_KEYS) && (lf1.capacity() >= NUM_KEYS);
+
+        // Each thread removes every third of its share of the keys while inserting as many new ones,
+        // so removals run against arrays that the inserts of every thread are resizing.
+        OUTSTREAM << "Removing a third of the entries while inserting " << NUM_KEYS << " more..." << endl;
+        const size_t startCapacity = lf1.capacity();
+        std::atomic<size_t> numRemoved{0};
+        threads.clear();
+        for (size_t t = 0; t < NUM_THREADS; t++) {
+            threads.emplace_back([&lf1, &numInserted, &numRemoved, t] {
+                for (size_t i = t; i < NUM_KEYS; i += NUM_THREADS) {
+                    numInserted += lf1.insert(NUM_KEYS + i, NUM_KEYS + i);
+                    if (i % 3 == 0)
+                        numRemoved += lf1.remove(i);
+                }
+            });
+        }
+        for (thread& th : threads)
+            th.join();
+        lf1.releaseRetired();
+        OUTSTREAM << "Successful removes: " << numRemoved << ", capacity: " << lf1.capacity() << endl;
+
+        const size_t expectedRemoved = (NUM_KEYS + 2) / 3;
+        ok &= (numInserted == NUM_KEYS * 2) && (numRemoved == expectedRemoved) && (lf1.capacity() > startCapacity)
+           && (lf1.size() == NUM_KEYS * 2 - expectedRemoved);
+        for (size_t i = 0; i < NUM_KEYS * 2; i++)
+            ok &= lf1.get(i) == (i < NUM_KEYS && i % 3 == 0 ? nullopt : optional<size_t>(i));
+
+        // Keys 2^16 apart, which an unmixed power-of-two index would pile into a few home buckets.
+        OUTSTREAM << "Inserting " << NUM_KEYS << " keys at a stride of 2^16 from " << NUM_THREADS << " threads..." << endl;
+        constexpr unsigned STRIDE_BITS = 16;
+        LockFreeHashTable_t<size_t, size_t> lf3(2);
+        threads.clear();
+        for (size_t t = 0; t < NUM_THREADS; t++) {
+            threads.emplace_back([&lf3, t] {
+                for (size_t i = t; i < NUM_KEYS; i += NUM_THREADS)
+                    lf3.insert(i << STRIDE_BITS, i);
+            });
+        }
+        for (thread& th : threads)
+            th.join();
+        ok &= lf3.size() == NUM_KEYS;
+        for (size_t i = 0; i < NUM_KEYS; i++)
+            ok &= (lf3.get(i << STRIDE_BITS) == optional<size_t>(i)) && !lf3.contains((i << STRIDE_BITS) + 1);
+
+        LockFreeTable lf2(2);
+        for (size_t i = 0; i < 26; i++)
+            ok &= lf2.insert(make_key<key_type>(i), make_value<value_type>(i));
+        ok &= lf2.remove(make_key<key_type>(0)) && !lf2.contains(make_key<key_type>(0)) && (lf2.get(make_key<key_type>(25)) == make_value<value_type>(25));
+        OUTSTREAM << (ok ? "SUCCESS: each key was inserted exactly once, removals held, and every entry survived resizing."
+                         : "FAILURE: lock-free inserts or removes duplicated or lost entries.")
+                  << endl << endl;
+    } catch (exception& e) {
+        OUTSTREAM << "Exception: " << e.what() << endl << endl;
+    }
+#else
+    OUTSTREAM << "*** DID NOT TEST LOCK FREE ***" << endl << endl;
+#endif
+
     OUTSTREAM << "All tests complete." << endl;
     return 0;
 }
@@ -0,0 +1,597 @@
+#ifndef HASHERS_H
+#define HASHERS_H
+
+/*
+ * Greg Rosen
+ * Project 4: HashTable
+ * Declaration and implementation of seeded hash functions for hash tables
+ */
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string_view>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+#if defined(__AES__) && defined(__SSE2__)
+#define HASHTABLE_HASH_AESNI
+#include <wmmintrin.h>
+#elif defined(__ARM_FEATURE_AES) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define HASHTABLE_HASH_ARM_AES
+#include <arm_neon.h>
+#endif
+
+/*
+ * Every hash function here hashes string keys (as std::string_view, so lookups stay transparent) and integer keys,
+ * and mixes a 64-bit seed into every hash. Without the seed, which keys collide is known in advance, so a client that
+ * chooses keys (HashDoS) can send many keys with the same home bucket and drive every probe to the length of the table.
+ * Tables draw a random seed for a SeededHash when they are constructed (see makeHash), so colliding keys cannot be
+ * predicted without knowing the seed. The functions are fast, not cryptographic; a client who can observe the
+ * order of keys or probe timings over many operations may still learn enough to build collisions.
+ * Words of a key are read in native byte order, so hashes agree with the reference algorithms on little-endian machines only.
+ */
+
+/**
+ * @brief High half of the 128-bit product of two words.
+ *
+ * Used for fastrange reductions and for folding multiplications in the hash functions.
+ * Compiles to a single multiplication with unsigned __int128 on GCC and Clang, and with the
+ * _umul128 / __umulh intrinsics on MSVC, which has no 128-bit integer type.
+ * Elsewhere the product is assembled from four 32 x 32 -> 64-bit multiplications.
+ *
+ * @param a first word
+ * @param b second word
+ * @return bits 64 to 127 of a * b.
+ */
+inline uint64_t mulhi64(const uint64_t a, const uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 Product; // __extension__ keeps -Wpedantic quiet about the non-standard type.
+    return static_cast<uint64_t>((static_cast<Product>(a) * b) >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    uint64_t high;
+    (void)_umul128(a, b, &high);
+    return high;
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+    return __umulh(a, b);
+#else
+    const uint64_t aLow = a & 0xFFFFFFFFULL;
+    const uint64_t aHigh = a >> 32;
+    const uint64_t bLow = b & 0xFFFFFFFFULL;
+    const uint64_t bHigh = b >> 32;
+    const uint64_t lowLow = aLow * bLow;
+    const uint64_t highLow = aHigh * bLow;
+    const uint64_t lowHigh = aLow * bHigh;
+    const uint64_t middle = (lowLow >> 32) + (highLow & 0xFFFFFFFFULL) + (lowHigh & 0xFFFFFFFFULL);
+    return aHigh * bHigh + (highLow >> 32) + (lowHigh >> 32) + (middle >> 32);
+#endif
+}
+
+/**
+ * @brief Scrambles a hash so that every bit of the result depends on every bit of the hash.
+ *
+ * Two rounds of multiplying by 2^64 / phi (Fibonacci hashing) and folding the high half of the 128-bit product
+ * into the low half. After one round, the high bits of the result are those of a plain product, which for
+ * structured keys (multiples of a power of two, and other strides) fall into a few repeating patterns;
+ * the second round breaks them up. Well-distributed hashes stay well distributed.
+ *
+ * @param hashValue hash to be mixed
+ * @return mixed hash.
+ */
+inline uint64_t mixHash(const uint64_t hashValue) {
+    constexpr uint64_t FIBONACCI_MULTIPLIER = 0x9E3779B97F4A7C15ULL; // 2^64 / phi, rounded to odd.
+    const uint64_t folded = (hashValue * FIBONACCI_MULTIPLIER) ^ mulhi64(hashValue, FIBONACCI_MULTIPLIER);
+    return (folded * FIBONACCI_MULTIPLIER) ^ mulhi64(folded, FIBONACCI_MULTIPLIER);
+}
+
+/**
+ * @concept SeededHash
+ * @brief Hash function constructed from a 64-bit seed, which it reports through seed().
+ *
+ * Tables give a SeededHash a random seed when they are constructed, and pass the same seed on to every table
+ * created by rehashing them and to snapshots, so that every copy of a key hashes alike.
+ */
+template<typename Hash>
+concept SeededHash = std::constructible_from<Hash, uint64_t> && std::copyable<Hash> && requires (const Hash& hash) {
+    { hash.seed() } -> std::convertible_to<uint64_t>;
+};
+
+/**
+ * @brief Creates the hash function of a new table.
+ *
+ * A SeededHash is given a random seed from std::random_device; any other hash function is default constructed.
+ *
+ * @return hash function.
+ */
+template<typename Hash>
+Hash makeHash() {
+    if constexpr (SeededHash<Hash>) {
+        std::random_device device;
+        const uint64_t high = device();
+        return Hash((high << 32) ^ device());
+    }
+    else {
+        return Hash();
+    }
+}
+
+/**
+ * @class WyHash
+ * @brief Seeded hash function following wyhash (final version 4, default secret).
+ *
+ * Reads keys in 8-byte words and mixes them by 64 x 64 -> 128-bit multiplication, folding the halves together.
+ * Keys of up to 16 bytes take one multiplication chain without loops, which makes it the fastest choice for short keys.
+ */
+class WyHash {
+private:
+    static constexpr uint64_t SECRET[4] = {0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL, 0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL}; // Default wyhash secret.
+
+    uint64_t hashSeed = 0; // Seed given at construction.
+    uint64_t mixedSeed = 0; // Seed mixed with the secret, as wyhash does at the start of every hash.
+
+    [[nodiscard]] static uint64_t mix(uint64_t a, uint64_t b); // Multiplies two words, folding the 128-bit product.
+
+public:
+    WyHash(); // Default constructor for WyHash (seed 0).
+    explicit WyHash(uint64_t inSeed); // Parameterized constructor for WyHash.
+
+    [[nodiscard]] uint64_t seed() const; // Getter for the seed.
+    [[nodiscard]] size_t operator()(std::string_view key) const; // Hashes a string key.
+    [[nodiscard]] size_t operator()(uint64_t key) const; // Hashes an integer key.
+};
+
+/**
+ * @class XXHash64
+ * @brief Seeded hash function computing XXH64.
+ *
+ * Keys of 32 bytes or more are consumed by four independent accumulators, so long keys hash at several bytes per cycle.
+ * Integer keys are hashed as their 8 bytes in memory, so agree with XXH64 of those bytes.
+ * XXH64 stands in for XXH3: XXH3 needs a 192-byte secret (re-derived from every seed for long keys) and six
+ * length-specialized paths, and its speed on short keys, the case that matters to the tables, is already offered by WyHash.
+ */
+class XXHash64 {
+private:
+    static constexpr uint64_t PRIME1 = 0x9E3779B185EBCA87ULL; // XXH64 prime 1.
+    static constexpr uint64_t PRIME2 = 0xC2B2AE3D27D4EB4FULL; // XXH64 prime 2.
+    static constexpr uint64_t PRIME3 = 0x165667B19E3779F9ULL; // XXH64 prime 3.
+    static constexpr uint64_t PRIME4 = 0x85EBCA77C2B2AE63ULL; // XXH64 prime 4.
+    static constexpr uint64_t PRIME5 = 0x27D4EB2F165667C5ULL; // XXH64 prime 5.
+
+    uint64_t hashSeed = 0; // Seed given at construction.
+
+    [[nodiscard]] static uint64_t round(uint64_t accumulator, uint64_t input); // Mixes one word into an accumulator.
+    [[nodiscard]] static uint64_t mergeRound(uint64_t hashValue, uint64_t accumulator); // Merges an accumulator into the hash.
+    [[nodiscard]] static uint64_t avalanche(uint64_t hashValue); // Final mixing of the hash.
+
+public:
+    XXHash64(); // Default constructor for XXHash64 (seed 0).
+    explicit XXHash64(uint64_t inSeed); // Parameterized constructor for XXHash64.
+
+    [[nodiscard]] uint64_t seed() const; // Getter for the seed.
+    [[nodiscard]] size_t operator()(std::string_view key) const; // Hashes a string key.
+    [[nodiscard]] size_t operator()(uint64_t key) const; // Hashes an integer key.
+};
+
+/**
+ * @class AesHash
+ * @brief Seeded hash function built from AES rounds.
+ *
+ * Each 16-byte block of the key is added into a 128-bit state, which is then put through one AES round keyed by the seed;
+ * two further rounds after the last block spread every input bit over the whole state, whose halves are folded together.
+ * A round is a single instruction with AES-NI on x86-64 (built with -maes or -march=native) and with the ARMv8 crypto extension,
+ * the choice being made at compile time. Elsewhere AesHash falls back to WyHash (see HARDWARE_ACCELERATED).
+ * Hashes differ between the x86-64 and ARM versions.
+ */
+class AesHash {
+public:
+#if defined(HASHTABLE_HASH_AESNI) || defined(HASHTABLE_HASH_ARM_AES)
+    static constexpr bool HARDWARE_ACCELERATED = true; // Whether hashes are computed with AES instructions.
+#else
+    static constexpr bool HARDWARE_ACCELERATED = false; // Whether hashes are computed with AES instructions.
+#endif
+
+private:
+    static constexpr size_t BLOCK_SIZE = 16; // Number of key bytes added into the state per round.
+    static constexpr uint64_t KEY_CONSTANTS[4] = {0x243F6A8885A308D3ULL, 0x13198A2E03707344ULL, 0xA4093822299F31D0ULL, 0x082EFA98EC4E6C89ULL}; // Digits of pi, separating the two round keys.
+
+    uint64_t hashSeed = 0; // Seed given at construction.
+#if defined(HASHTABLE_HASH_AESNI) || defined(HASHTABLE_HASH_ARM_AES)
+    uint64_t roundKeys[4] = {}; // Words of the two 128-bit round keys derived from the seed.
+
+    [[nodiscard]] uint64_t finish(const uint8_t* lastBlock, const uint8_t* blocks, size_t numBlocks, uint64_t length) const; // Absorbs blocks and folds the state.
+#else
+    WyHash fallback; // Hash function used without AES instructions.
+#endif
+
+public:
+    AesHash(); // Default constructor for AesHash (seed 0).
+    explicit AesHash(uint64_t inSeed); // Parameterized constructor for AesHash.
+
+    [[nodiscard]] uint64_t seed() const; // Getter for the seed.
+    [[nodiscard]] size_t operator()(std::string_view key) const; // Hashes a string key.
+    [[nodiscard]] size_t operator()(uint64_t key) const; // Hashes an integer key.
+};
+
+/**
+ * @brief Reads 8 bytes of a key as a word, in native byte order.
+ *
+ * @param bytes first byte read
+ * @return word.
+ */
+inline uint64_t readWord64(const uint8_t* const bytes) {
+    uint64_t word;
+    std::memcpy(&word, bytes, sizeof(word));
+    return word;
+}
+
+/**
+ * @brief Reads 4 bytes of a key as a word, in native byte order.
+ *
+ * @param bytes first byte read
+ * @return word, zero extended.
+ */
+inline uint64_t readWord32(const uint8_t* const bytes) {
+    uint32_t word;
+    std::memcpy(&word, bytes, sizeof(word));
+    return word;
+}
+
+/**
+ * @brief Multiplies two words, folding the 128-bit product.
+ *
+ * @param a first word
+ * @param b second word
+ * @return exclusive or of the low and high halves of a * b.
+ */
+inline uint64_t WyHash::mix(const uint64_t a, const uint64_t b) {
+    return (a * b) ^ mulhi64(a, b);
+}
+
+/**
+ * @brief Default constructor for WyHash.
+ *
+ * Equivalent to seed 0; tables replace it with a random seed (see makeHash).
+ */
+inline WyHash::WyHash() : WyHash(0) {}
+
+/**
+ * @brief Parameterized constructor for WyHash.
+ *
+ * @param inSeed seed mixed into every hash
+ */
+inline WyHash::WyHash(const uint64_t inSeed) : hashSeed(inSeed), mixedSeed(inSeed ^ mix(inSeed ^ SECRET[0], SECRET[1])) {}
+
+/**
+ * @brief Getter for the seed.
+ *
+ * @return seed given at construction.
+ */
+inline uint64_t WyHash::seed() const {
+    return hashSeed;
+}
+
+/**
+ * @brief Hashes a string key.
+ *
+ * Keys of 4 to 16 bytes are read as four overlapping 4-byte words, and shorter keys as their first, middle, and last bytes,
+ * so no key is read past its end. Longer keys are consumed 48 bytes at a time by three chains, then 16 at a time.
+ *
+ * @param key key hashed
+ * @return hash of key.
+ */
+inline size_t WyHash::operator()(const std::string_view key) const {
+    const auto* bytes = reinterpret_cast<const uint8_t*>(key.data());
+    const size_t length = key.size();
+    uint64_t state = mixedSeed;
+    uint64_t a = 0;
+    uint64_t b = 0;
+    if (length <= 16) {
+        if (length >= 4) {
+            const size_t middle = (length >> 3) << 2;
+            a = (readWord32(bytes) << 32) | readWord32(bytes + middle);
+            b = (readWord32(bytes + length - 4) << 32) | readWord32(bytes + length - 4 - middle);
+        }
+        else if (length > 0) {
+            a = (static_cast<uint64_t>(bytes[0]) << 16) | (static_cast<uint64_t>(bytes[length >> 1]) << 8) | bytes[length - 1];
+        }
+    }
+    else {
+        size_t remaining = length;
+        if (remaining > 48) {
+            uint64_t state1 = state;
+            uint64_t state2 = state;
+            do {
+                state = mix(readWord64(bytes) ^ SECRET[1], readWord64(bytes + 8) ^ state);
+                state1 = mix(readWord64(bytes + 16) ^ SECRET[2], readWord64(bytes + 24) ^ state1);
+                state2 = mix(readWord64(bytes + 32) ^ SECRET[3], readWord64(bytes + 40) ^ state2);
+                bytes += 48;
+                remaining -= 48;
+            } while (remaining > 48);
+            state ^= state1 ^ state2;
+        }
+        while (remaining > 16) {
+            state = mix(readWord64(bytes) ^ SECRET[1], readWord64(bytes + 8) ^ state);
+            bytes += 16;
+            remaining -= 16;
+        }
+        a = readWord64(bytes + remaining - 16);
+        b = readWord64(bytes + remaining - 8);
+    }
+    a ^= SECRET[1];
+    b ^= state;
+    return mix((a * b) ^ SECRET[0] ^ length, mulhi64(a, b) ^ SECRET[1]);
+}
+
+/**
+ * @brief Hashes an integer key.
+ *
+ * Two multiplications, without reading memory, as in wyhash's 64-bit integer hash.
+ *
+ * @param key key hashed
+ * @return hash of key.
+ */
+inline size_t WyHash::operator()(const uint64_t key) const {
+    return mix(mix(key ^ SECRET[0], mixedSeed ^ SECRET[1]) ^ SECRET[0], mixedSeed ^ SECRET[2]);
+}
+
+/**
+ * @brief Mixes one word into an accumulator.
+ *
+ * @param accumulator accumulator
+ * @param input word mixed in
+ * @return new accumulator.
+ */
+inline uint64_t XXHash64::round(uint64_t accumulator, const uint64_t input) {
+    accumulator += input * PRIME2;
+    accumulator = std::rotl(accumulator, 31);
+    return accumulator * PRIME1;
+}
+
+/**
+ * @brief Merges an accumulator into the hash.
+ *
+ * @param hashValue hash so far
+ * @param accumulator accumulator merged
+ * @return new hash.
+ */
+inline uint64_t XXHash64::mergeRound(uint64_t hashValue, const uint64_t accumulator) {
+    hashValue ^= round(0, accumulator);
+    return hashValue * PRIME1 + PRIME4;
+}
+
+/**
+ * @brief Final mixing of the hash.
+ *
+ * @param hashValue hash so far
+ * @return hash with every input bit spread over every output bit.
+ */
+inline uint64_t XXHash64::avalanche(uint64_t hashValue) {
+    hashValue ^= hashValue >> 33;
+    hashValue *= PRIME2;
+    hashValue ^= hashValue >> 29;
+    hashValue *= PRIME3;
+    return hashValue ^ (hashValue >> 32);
+}
+
+/**
+ * @brief Default constructor for XXHash64.
+ *
+ * Equivalent to seed 0; tables replace it with a random seed (see makeHash).
+ */
+inline XXHash64::XXHash64() = default;
+
+/**
+ * @brief Parameterized constructor for XXHash64.
+ *
+ * @param inSeed seed mixed into every hash
+ */
+inline XXHash64::XXHash64(const uint64_t inSeed) : hashSeed(inSeed) {}
+
+/**
+ * @brief Getter for the seed.
+ *
+ * @return seed given at construction.
+ */
+inline uint64_t XXHash64::seed() const {
+    return hashSeed;
+}
+
+/**
+ * @brief Hashes a string key.
+ *
+ * @param key key hashed
+ * @return XXH64 of the characters of key.
+ */
+inline size_t XXHash64::operator()(const std::string_view key) const {
+    const auto* bytes = reinterpret_cast<const uint8_t*>(key.data());
+    const uint8_t* const end = bytes + key.size();
+    uint64_t hashValue;
+    if (key.size() >= 32) {
+        uint64_t accumulators[4] = {hashSeed + PRIME1 + PRIME2, hashSeed + PRIME2, hashSeed, hashSeed - PRIME1};
+        do {
+            for (uint64_t& accumulator : accumulators) {
+                accumulator = round(accumulator, readWord64(bytes));
+                bytes += 8;
+            }
+        } while (end - bytes >= 32);
+        hashValue = std::rotl(accumulators[0], 1) + std::rotl(accumulators[1], 7) + std::rotl(accumulators[2], 12) + std::rotl(accumulators[3], 18);
+        for (const uint64_t accumulator : accumulators) {
+            hashValue = mergeRound(hashValue, accumulator);
+        }
+    }
+    else {
+        hashValue = hashSeed + PRIME5;
+    }
+    hashValue += key.size();
+    for (; end - bytes >= 8; bytes += 8) {
+        hashValue ^= round(0, readWord64(bytes));
+        hashValue = std::rotl(hashValue, 27) * PRIME1 + PRIME4;
+    }
+    if (end - bytes >= 4) {
+        hashValue ^= readWord32(bytes) * PRIME1;
+        hashValue = std::rotl(hashValue, 23) * PRIME2 + PRIME3;
+        bytes += 4;
+    }
+    for (; bytes != end; ++bytes) {
+        hashValue ^= *bytes * PRIME5;
+        hashValue = std::rotl(hashValue, 11) * PRIME1;
+    }
+    return avalanche(hashValue);
+}
+
+/**
+ * @brief Hashes an integer key.
+ *
+ * @param key key hashed
+ * @return XXH64 of the 8 bytes of key in memory.
+ */
+inline size_t XXHash64::operator()(const uint64_t key) const {
+    uint64_t hashValue = hashSeed + PRIME5 + sizeof(key);
+    hashValue ^= round(0, key);
+    hashValue = std::rotl(hashValue, 27) * PRIME1 + PRIME4;
+    return avalanche(hashValue);
+}
+
+/**
+ * @brief Default constructor for AesHash.
+ *
+ * Equivalent to seed 0; tables replace it with a random seed (see makeHash).
+ */
+inline AesHash::AesHash() : AesHash(0) {}
+
+#if defined(HASHTABLE_HASH_AESNI) || defined(HASHTABLE_HASH_ARM_AES)
+/**
+ * @brief Parameterized constructor for AesHash.
+ *
+ * The seed is spread over both round keys by multiplication, so that seeds differing in one bit give unrelated keys.
+ *
+ * @param inSeed seed mixed into every hash
+ */
+inline AesHash::AesHash(const uint64_t inSeed) : hashSeed(inSeed) {
+    for (size_t word = 0; word < 4; ++word) {
+        const uint64_t a = inSeed ^ KEY_CONSTANTS[word];
+        const uint64_t b = KEY_CONSTANTS[(word + 1) % 4] | 1;
+        roundKeys[word] = (a * b) ^ mulhi64(a, b);
+    }
+}
+
+/**
+ * @brief Absorbs blocks and folds the state.
+ *
+ * @param lastBlock final 16 bytes absorbed
+ * @param blocks first of the full blocks absorbed before lastBlock
+ * @param numBlocks number of full blocks absorbed before lastBlock
+ * @param length length of key, mixed into the initial state so that keys differing only in zero padding hash apart
+ * @return exclusive or of the two halves of the final state.
+ */
+inline uint64_t AesHash::finish(const uint8_t* lastBlock, const uint8_t* blocks, const size_t numBlocks, const uint64_t length) const {
+#if defined(HASHTABLE_HASH_AESNI)
+    const __m128i key0 = _mm_set_epi64x(static_cast<long long>(roundKeys[1]), static_cast<long long>(roundKeys[0]));
+    const __m128i key1 = _mm_set_epi64x(static_cast<long long>(roundKeys[3]), static_cast<long long>(roundKeys[2]));
+    __m128i state = _mm_xor_si128(key1, _mm_set_epi64x(0, static_cast<long long>(length)));
+    for (size_t blockNum = 0; blockNum < numBlocks; ++blockNum, blocks += BLOCK_SIZE) {
+        state = _mm_aesenc_si128(_mm_xor_si128(state, _mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks))), key0);
+    }
+    state = _mm_aesenc_si128(_mm_xor_si128(state, _mm_loadu_si128(reinterpret_cast<const __m128i*>(lastBlock))), key0);
+    state = _mm_aesenc_si128(_mm_aesenc_si128(state, key1), key0);
+    return static_cast<uint64_t>(_mm_cvtsi128_si64(state)) ^ static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(state, state)));
+#else
+    // AESE adds the round key before substitution, rather than after mixing as AESENC does; within one build either is a keyed round.
+    const uint8x16_t key0 = vreinterpretq_u8_u64(vld1q_u64(roundKeys));
+    const uint8x16_t key1 = vreinterpretq_u8_u64(vld1q_u64(roundKeys + 2));
+    uint8x16_t state = veorq_u8(key1, vreinterpretq_u8_u64(vcombine_u64(vcreate_u64(length), vcreate_u64(0))));
+    for (size_t blockNum = 0; blockNum < numBlocks; ++blockNum, blocks += BLOCK_SIZE) {
+        state = vaesmcq_u8(vaeseq_u8(veorq_u8(state, vld1q_u8(blocks)), key0));
+    }
+    state = vaesmcq_u8(vaeseq_u8(veorq_u8(state, vld1q_u8(lastBlock)), key0));
+    state = vaesmcq_u8(vaeseq_u8(vaesmcq_u8(vaeseq_u8(state, key1)), key0));
+    const uint64x2_t words = vreinterpretq_u64_u8(state);
+    return vgetq_lane_u64(words, 0) ^ vgetq_lane_u64(words, 1);
+#endif
+}
+
+/**
+ * @brief Getter for the seed.
+ *
+ * @return seed given at construction.
+ */
+inline uint64_t AesHash::seed() const {
+    return hashSeed;
+}
+
+/**
+ * @brief Hashes a string key.
+ *
+ * Keys of 16 bytes or more end with a block overlapping the one before it, so no key is read past its end;
+ * shorter keys are copied into one zero-padded block.
+ *
+ * @param key key hashed
+ * @return hash of key.
+ */
+inline size_t AesHash::operator()(const std::string_view key) const {
+    const auto* const bytes = reinterpret_cast<const uint8_t*>(key.data());
+    if (key.size() >= BLOCK_SIZE) {
+        return finish(bytes + key.size() - BLOCK_SIZE, bytes, (key.size() - 1) / BLOCK_SIZE, key.size());
+    }
+    uint8_t block[BLOCK_SIZE] = {};
+    if (!key.empty()) {
+        std::memcpy(block, bytes, key.size());
+    }
+    return finish(block, nullptr, 0, key.size());
+}
+
+/**
+ * @brief Hashes an integer key.
+ *
+ * @param key key hashed
+ * @return hash of the 8 bytes of key, zero padded to one block.
+ */
+inline size_t AesHash::operator()(const uint64_t key) const {
+    uint8_t block[BLOCK_SIZE] = {};
+    std::memcpy(block, &key, sizeof(key));
+    return finish(block, nullptr, 0, sizeof(key));
+}
+#else
+/**
+ * @brief Parameterized constructor for AesHash.
+ *
+ * @param inSeed seed mixed into every hash
+ */
+inline AesHash::AesHash(const uint64_t inSeed) : hashSeed(inSeed), fallback(inSeed) {}
+
+/**
+ * @brief Getter for the seed.
+ *
+ * @return seed given at construction.
+ */
+inline uint64_t AesHash::seed() const {
+    return hashSeed;
+}
+
+/**
+ * @brief Hashes a string key.
+ *
+ * @param key key hashed
+ * @return WyHash of key.
+ */
+inline size_t AesHash::operator()(const std::string_view key) const {
+    return fallback(key);
+}
+
+/**
+ * @brief Hashes an integer key.
+ *
+ * @param key key hashed
+ * @return WyHash of key.
+ */
+inline size_t AesHash::operator()(const uint64_t key) const {
+    return fallback(key);
+}
+#endif
+
+#endif // HASHERS_H
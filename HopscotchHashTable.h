@@ -0,0 +1,649 @@
+#ifndef HOPSCOTCHHASHTABLE_H
+#define HOPSCOTCHHASHTABLE_H
+
+/*
+ * Greg Rosen
+ * Project 4: HashTable
+ * Declaration and implementation of HopscotchHashTable_t class template
+ */
+
+#include "HashTableImpl.h"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @class HopscotchHashTable_t
+ * @brief HashTable for <K, V> key-value pairs using hopscotch hashing.
+ *
+ * Open addressing over a power-of-two bucket array, in which every key is stored within NEIGHBORHOOD buckets
+ * of its home bucket. Each home bucket keeps a bitmap of the buckets in its neighborhood holding its keys,
+ * so a lookup reads one bitmap and compares only the buckets it names; unsuccessful lookups of keys whose
+ * neighborhood is empty touch no bucket at all, and no lookup strays more than a few cache lines from home.
+ * Insertion probes linearly for an empty bucket, then hops it back towards the home bucket by moving keys that
+ * may also live closer to the empty bucket, until it lies within the neighborhood. If that fails, the table grows,
+ * unless the home neighborhood is already full of keys with the key's own hash, which no capacity could separate:
+ * such keys are kept in a small overflow list instead, searched when the neighborhood does not hold the key.
+ * Removal empties the bucket and clears its bit, so the table never holds tombstones.
+ * Buckets have a control byte (see ControlByte), ESS if empty or the fingerprint of their key, and cache the mixed hash of their key (see hashOf).
+ * Offers the core interface of HashTable_t, including insertTCT and removeTCT, so the engines can be compared directly.
+ *
+ * @warning ArenaString keys are not supported. A hash function giving more than NEIGHBORHOOD keys the same hash
+ * sends the rest of them to the overflow list, where lookups are linear.
+ *
+ * @author Greg Rosen
+ * @date November 2, 2025
+ */
+template<typename K, typename V, typename Hash = DefaultHash<K>, typename Eq = DefaultKeyEqual<K>>
+class HopscotchHashTable_t {
+    static_assert(!KeyTraits<K>::arenaStorage, "HopscotchHashTable_t keeps no key arena");
+
+public:
+    using KeyArg = typename KeyTraits<K>::lookup_type; // Parameter type accepted by lookups.
+    static constexpr size_t NEIGHBORHOOD = 32; // Number of buckets, starting at its home bucket, that may hold a key.
+
+private:
+    /**
+     * @struct Bucket
+     * @brief Bucket for HopscotchHashTable
+     *
+     * Whether the bucket is filled is kept in the control byte array of the table.
+     */
+    struct Bucket {
+        K key{}; // Key for hash table entry.
+        V value{}; // Value for hash table entry.
+        size_t hashValue = 0; // Mixed hash of key (see hashOf).
+    };
+
+    /**
+     * @struct InsertSlot
+     * @brief Outcome of probing for a key that is about to be inserted.
+     */
+    struct InsertSlot {
+        size_t index; // Index of the bucket the key was stored in, or NOT_FOUND if the table must grow first.
+        size_t probes; // Number of buckets examined.
+    };
+
+    static constexpr size_t NOT_FOUND = std::numeric_limits<size_t>::max(); // Index returned by find for missing keys.
+
+    const double threshold; // The load factor threshold for rehashing (default 0.5).
+    const double resizeFactor; // The factor by which the capacity of the hash table will be increased upon rehashing (default 2.0).
+    std::vector<uint8_t> control; // Control byte (ESS or fingerprint) of every bucket.
+    std::vector<uint32_t> neighborhoods; // For every home bucket, bit i is set if the bucket i places after it holds one of its keys.
+    std::vector<Bucket> tableData; // The hash table itself, implemented as a vector of Bucket elements.
+    std::vector<Bucket> overflow; // Key-value pairs whose home neighborhood is full of keys with the same hash (normally none).
+    size_t indexMask; // capacity - 1, for bucket indexing.
+    size_t neighborhoodSize; // Number of buckets in a neighborhood (NEIGHBORHOOD, or the capacity if smaller).
+    size_t numFilled; // The number of filled buckets in the hash table, not counting overflow.
+    [[no_unique_address]] Hash hash; // Using () overload, provides hash function size_t hash(KeyArg)
+    [[no_unique_address]] Eq equal; // Using () overload, provides key equality predicate bool equal(K, KeyArg)
+    V badKeyDrain; // Dummy variable for capturing invalid uses of subscript operator.
+
+    void rehash(); // Rehashes the table, increasing its size.
+    void rehash(size_t newCapacity); // Rehashes the table to a given capacity.
+    size_t insertHashed(Bucket entry); // Stores a key-value pair whose key is not in the table.
+    [[nodiscard]] InsertSlot tryPlace(Bucket& entry); // Stores a key-value pair in the neighborhood of its home bucket, if possible.
+    [[nodiscard]] bool sameHashNeighborhood(size_t hashValue) const; // Predicate for if a home neighborhood is full of keys with a given hash.
+    [[nodiscard]] Bucket& bucketAt(size_t index); // Bucket or overflow entry at an index returned by find.
+    [[nodiscard]] const Bucket& bucketAt(size_t index) const; // Bucket or overflow entry at an index returned by find.
+    void vacateBucket(size_t index); // Empties a filled bucket, or removes an overflow entry.
+    [[nodiscard]] std::pair<size_t, size_t> search(KeyArg key, size_t hashValue) const; // Find index of bucket containing key, and count buckets examined.
+    [[nodiscard]] size_t find(KeyArg key, size_t hashValue) const; // Find index of bucket containing key.
+    [[nodiscard]] size_t hashOf(KeyArg key) const; // Mixed hash of a key, from which its home bucket is taken.
+    [[nodiscard]] size_t homeIndex(size_t hashValue) const; // Home bucket for a key with given hash.
+
+public:
+    explicit HopscotchHashTable_t(size_t initCapacity = 8, double inThreshold = 0.5, double inResizeFactor = 2.0); // Default and parameterized constructor for hopscotch hash table.
+
+    V& operator[](KeyArg key); // Subscript operator overload for hopscotch hash table.
+
+    [[nodiscard]] size_t capacity() const; // Getter for capacity of the hopscotch hash table.
+    [[nodiscard]] size_t size() const; // Getter for size of the hopscotch hash table.
+    [[nodiscard]] double alpha() const; // Getter for the load factor of the hopscotch hash table.
+    [[nodiscard]] size_t tombstones() const; // Getter for number of tombstones in the hopscotch hash table (always 0).
+    [[nodiscard]] std::vector<K> keys() const; // Getter for a list of keys currently used in the hopscotch hash table.
+    [[nodiscard]] std::optional<V> get(KeyArg key) const; // Getter for value stored using a given key.
+
+    [[nodiscard]] bool contains(KeyArg key) const; // Predicate for if a given key is stored in table.
+
+    bool insert(const K& key, const V& value); // Insert key-value pair into table.
+    bool insert_or_assign(const K& key, const V& value); // Insert key-value pair, or assign value if key is present.
+    void reserve(size_t expectedElements); // Reserves capacity for a number of key-value pairs.
+    bool remove(KeyArg key); // Remove key-value pair from table.
+
+    size_t insertTCT(const K& key, const V& value); // Time-complexity testing version of insert.
+    size_t removeTCT(KeyArg key); // Time-complexity testing version of remove.
+
+    /**
+     * @brief Stream insertion operator overload for HopscotchHashTable.
+     *
+     * Outputs the filled buckets in the table bucket-by-bucket on separate lines, as "Bucket n: <key, value>".
+     *
+     * @param os output stream
+     * @param hashTable hash table to be output
+     * @return output stream with hash table output added
+     */
+    friend std::ostream& operator<<(std::ostream& os, const HopscotchHashTable_t& hashTable) {
+        for (size_t bucketNum = 0; bucketNum < hashTable.capacity(); ++bucketNum) {
+            if (ControlByte::isFull(slotAt(hashTable.control, bucketNum))) {
+                const Bucket& bucket = slotAt(hashTable.tableData, bucketNum);
+                os << "Bucket " << bucketNum << ": <" << bucket.key << ", " << bucket.value << ">" << std::endl;
+            }
+        }
+        for (const Bucket& entry : hashTable.overflow) {
+            os << "Overflow: <" << entry.key << ", " << entry.value << ">" << std::endl;
+        }
+        return os;
+    }
+};
+
+/**
+ * @brief HopscotchHashTable for <string, unsigned long> key-value pairs
+ *
+ * The HopscotchHashTable_t class template instantiated for string keys and unsigned long (size_t) values.
+ */
+using HopscotchHashTable = HopscotchHashTable_t<std::string, size_t>;
+
+/**
+ * @brief Default and parameterized constructor for hopscotch hash table.
+ *
+ * Creates a hash table with given number of initial empty buckets (default 8), rounded up to the next power of two.
+ *
+ * @param initCapacity Initial number of empty buckets in hash table.
+ * @param inThreshold The load factor threshold for rehashing (default 0.5).
+ * @param inResizeFactor The factor by which the capacity of the hash table will be increased upon rehashing (default 2.0).
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+HopscotchHashTable_t<K, V, Hash, Eq>::HopscotchHashTable_t(const size_t initCapacity, const double inThreshold, const double inResizeFactor) :
+    threshold(inThreshold), resizeFactor(inResizeFactor), control(std::bit_ceil(std::max(initCapacity, static_cast<size_t>(1))), ControlByte::ESS),
+    neighborhoods(control.size(), 0), tableData(control.size()), overflow(), indexMask(control.size() - 1),
+    neighborhoodSize(std::min(NEIGHBORHOOD, control.size())), numFilled(0), hash(makeHash<Hash>()), equal(), badKeyDrain() {}
+
+/**
+ * @brief Subscript operator overload for hopscotch hash table.
+ *
+ * Returns a reference to the value associated with key, like HashTable::operator[].
+ *
+ * @warning If the key is not in the table, the returned reference points to a dummy value field of the table.
+ *
+ * @param key Key to be searched.
+ * @return Reference to value associated with key.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+V& HopscotchHashTable_t<K, V, Hash, Eq>::operator[](const KeyArg key) {
+    if (const size_t index = find(key, hashOf(key)); index != NOT_FOUND) {
+        return bucketAt(index).value;
+    }
+    return badKeyDrain;
+}
+
+/**
+ * @brief Getter for capacity of the hopscotch hash table.
+ *
+ * @return capacity of hash table (number of buckets).
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t HopscotchHashTable_t<K, V, Hash, Eq>::capacity() const {
+    return tableData.size();
+}
+
+/**
+ * @brief Getter for size of the hopscotch hash table.
+ *
+ * @return number of filled buckets and overflow entries.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t HopscotchHashTable_t<K, V, Hash, Eq>::size() const {
+    return numFilled + overflow.size();
+}
+
+/**
+ * @brief Getter for the load factor of the hopscotch hash table.
+ *
+ * @return ratio of size to capacity.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+double HopscotchHashTable_t<K, V, Hash, Eq>::alpha() const {
+    return static_cast<double>(size())/static_cast<double>(capacity());
+}
+
+/**
+ * @brief Getter for number of tombstones in the hopscotch hash table.
+ *
+ * Removal empties buckets outright, so there are never any tombstones.
+ *
+ * @return 0.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t HopscotchHashTable_t<K, V, Hash, Eq>::tombstones() const {
+    return 0;
+}
+
+/**
+ * @brief Getter for a list of keys currently used in the hopscotch hash table.
+ *
+ * @return vector of keys present in the table, in bucket order followed by any overflow.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+std::vector<K> HopscotchHashTable_t<K, V, Hash, Eq>::keys() const {
+    std::vector<K> keyList;
+    keyList.reserve(size());
+    for (size_t bucketNum = 0; bucketNum < capacity(); ++bucketNum) {
+        if (ControlByte::isFull(slotAt(control, bucketNum))) {
+            keyList.push_back(slotAt(tableData, bucketNum).key);
+        }
+    }
+    for (const Bucket& entry : overflow) {
+        keyList.push_back(entry.key);
+    }
+    return keyList;
+}
+
+/**
+ * @brief Getter for value stored using a given key.
+ *
+ * @param key Key to be searched.
+ * @return value associated with key or nullopt.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+std::optional<V> HopscotchHashTable_t<K, V, Hash, Eq>::get(const KeyArg key) const {
+    if (const size_t index = find(key, hashOf(key)); index != NOT_FOUND) {
+        return bucketAt(index).value;
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Predicate for if a given key is stored in table.
+ *
+ * @param key Key to be searched.
+ * @return true if key found, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool HopscotchHashTable_t<K, V, Hash, Eq>::contains(const KeyArg key) const {
+    return find(key, hashOf(key)) != NOT_FOUND;
+}
+
+/**
+ * @brief Insert key-value pair into table.
+ *
+ * Returns false if the key is already present in the hash table.
+ * If the insertion raises the load factor of the hash table to or above the threshold (default 0.5), the table is rehashed.
+ *
+ * @param key of key-value pair to be inserted.
+ * @param value Value of key-value pair to be inserted.
+ *
+ * @return true if insertion successful, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool HopscotchHashTable_t<K, V, Hash, Eq>::insert(const K& key, const V& value) {
+    const size_t hashValue = hashOf(key);
+    if (find(key, hashValue) != NOT_FOUND) {
+        return false;
+    }
+    insertHashed(Bucket{key, value, hashValue});
+    if (alpha() >= threshold) { // Rehash if necessary.
+        rehash();
+    }
+    return true;
+}
+
+/**
+ * @brief Insert key-value pair, or assign value if key is present.
+ *
+ * @param key of key-value pair to be inserted or assigned.
+ * @param value Value to be stored.
+ *
+ * @return true if key was inserted, false if an existing value was assigned.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool HopscotchHashTable_t<K, V, Hash, Eq>::insert_or_assign(const K& key, const V& value) {
+    const size_t hashValue = hashOf(key);
+    if (const size_t index = find(key, hashValue); index != NOT_FOUND) {
+        bucketAt(index).value = value;
+        return false;
+    }
+    insertHashed(Bucket{key, value, hashValue});
+    if (alpha() >= threshold) { // Rehash if necessary.
+        rehash();
+    }
+    return true;
+}
+
+/**
+ * @brief Reserves capacity for a number of key-value pairs.
+ *
+ * Rehashes at once if necessary, so that expectedElements key-value pairs can be inserted without any further rehash
+ * (unless a neighborhood overflows).
+ *
+ * @param expectedElements number of key-value pairs to be held.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void HopscotchHashTable_t<K, V, Hash, Eq>::reserve(const size_t expectedElements) {
+    const auto required = static_cast<size_t>(static_cast<double>(expectedElements) / threshold) + 1;
+    if (required > capacity()) {
+        rehash(required);
+    }
+}
+
+/**
+ * @brief Remove key-value pair from table.
+ *
+ * @param key Key to be searched.
+ * @return true if removal successful, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool HopscotchHashTable_t<K, V, Hash, Eq>::remove(const KeyArg key) {
+    const size_t index = find(key, hashOf(key));
+    if (index == NOT_FOUND) {
+        return false; // key is not present in table
+    }
+    vacateBucket(index);
+    return true;
+}
+
+/**
+ * @brief Time-complexity testing version of insert.
+ *
+ * Like insert, but returns number of probes required to either insert key-value pair or determine key is a duplicate:
+ * the neighborhood bitmap and the buckets it names, then the buckets passed searching for an empty one
+ * and those examined while hopping it back. A neighborhood that cannot take the key still grows the table;
+ * otherwise the check for rehashing is omitted.
+ *
+ * @param key of key-value pair to be inserted.
+ * @param value Value of key-value pair to be inserted.
+ *
+ * @return number of probes required for insertion.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t HopscotchHashTable_t<K, V, Hash, Eq>::insertTCT(const K& key, const V& value) {
+    const size_t hashValue = hashOf(key);
+    const auto [index, probes] = search(key, hashValue);
+    if (index != NOT_FOUND) {
+        return probes;
+    }
+    return probes + insertHashed(Bucket{key, value, hashValue});
+}
+
+/**
+ * @brief Time-complexity testing version of remove.
+ *
+ * Like remove, but returns number of probes required to either remove key-value pair or determine key is not in the table:
+ * the neighborhood bitmap and the buckets compared.
+ *
+ * @param key Key to be searched.
+ * @return number of probes required for removal.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t HopscotchHashTable_t<K, V, Hash, Eq>::removeTCT(const KeyArg key) {
+    const auto [index, probes] = search(key, hashOf(key));
+    if (index != NOT_FOUND) {
+        vacateBucket(index);
+    }
+    return probes;
+}
+
+/**
+ * @brief Rehashes the table, increasing its size.
+ *
+ * Capacity grows by resizeFactor, rounded up to the next power of two.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void HopscotchHashTable_t<K, V, Hash, Eq>::rehash() {
+    // Capacity must grow by at least one bucket.
+    rehash(std::max(static_cast<size_t>(static_cast<double>(capacity()) * resizeFactor), capacity() + 1));
+}
+
+/**
+ * @brief Rehashes the table to a given capacity.
+ *
+ * Moves every key-value pair into new bucket arrays of at least newCapacity buckets (rounded up to a power of two),
+ * reusing the cached hash of each key. Should a neighborhood of the new arrays overflow, they grow again in turn;
+ * the old arrays are held here until every pair has been moved. Overflow entries are inserted again as well,
+ * so they return to the buckets once their neighborhood has room.
+ *
+ * @param newCapacity minimum number of buckets of the rehashed table.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void HopscotchHashTable_t<K, V, Hash, Eq>::rehash(const size_t newCapacity) {
+    const size_t roundedCapacity = std::bit_ceil(std::max(newCapacity, size() + 1));
+    std::vector<uint8_t> oldControl = std::exchange(control, std::vector<uint8_t>(roundedCapacity, ControlByte::ESS));
+    std::vector<Bucket> oldData = std::exchange(tableData, std::vector<Bucket>(roundedCapacity));
+    std::vector<Bucket> oldOverflow = std::exchange(overflow, std::vector<Bucket>());
+    neighborhoods.assign(roundedCapacity, 0);
+    indexMask = roundedCapacity - 1;
+    neighborhoodSize = std::min(NEIGHBORHOOD, roundedCapacity);
+    numFilled = 0;
+    for (size_t bucketNum = 0; bucketNum < oldData.size(); ++bucketNum) {
+        if (ControlByte::isFull(slotAt(oldControl, bucketNum))) {
+            insertHashed(std::move(slotAt(oldData, bucketNum)));
+        }
+    }
+    for (Bucket& entry : oldOverflow) {
+        insertHashed(std::move(entry));
+    }
+}
+
+/**
+ * @brief Stores a key-value pair whose key is not in the table.
+ *
+ * Grows the table until the neighborhood of the key's home bucket can take it. If the neighborhood is full of keys
+ * with the same hash as the key, growing could never make room, so the pair is appended to the overflow list instead.
+ *
+ * @param entry key-value pair to be stored, with the hash of its key.
+ * @return number of buckets examined in the final attempt, plus one if the pair went to the overflow list.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t HopscotchHashTable_t<K, V, Hash, Eq>::insertHashed(Bucket entry) {
+    InsertSlot slot = tryPlace(entry);
+    while (slot.index == NOT_FOUND) {
+        if (sameHashNeighborhood(entry.hashValue)) {
+            overflow.push_back(std::move(entry));
+            return slot.probes + 1;
+        }
+        rehash();
+        slot = tryPlace(entry);
+    }
+    return slot.probes;
+}
+
+/**
+ * @brief Predicate for if a home neighborhood is full of keys with a given hash.
+ *
+ * Keys with the same hash share a home bucket at every capacity, so once NEIGHBORHOOD of them fill the
+ * neighborhood, no rehash can place another.
+ *
+ * @param hashValue Mixed hash of key.
+ * @return true if every bucket of the full-sized neighborhood of the key's home bucket holds a key with hash hashValue.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool HopscotchHashTable_t<K, V, Hash, Eq>::sameHashNeighborhood(const size_t hashValue) const {
+    if (neighborhoodSize < NEIGHBORHOOD) {
+        return false; // A larger table has larger neighborhoods.
+    }
+    const size_t home = homeIndex(hashValue);
+    if (slotAt(neighborhoods, home) != std::numeric_limits<uint32_t>::max()) {
+        return false;
+    }
+    for (size_t offset = 0; offset < NEIGHBORHOOD; ++offset) {
+        if (slotAt(tableData, (home + offset) & indexMask).hashValue != hashValue) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Stores a key-value pair in the neighborhood of its home bucket, if possible.
+ *
+ * Probes linearly from the home bucket for an empty one. While it lies outside the neighborhood, the empty bucket
+ * is exchanged with the earliest filled bucket before it whose key may also occupy the empty bucket
+ * (found from the bitmaps of the NEIGHBORHOOD - 1 home buckets before it), moving it closer to home.
+ *
+ * @param entry key-value pair to be stored, moved from only if successful.
+ * @return index of the filled bucket, or NOT_FOUND if no empty bucket can be brought into the neighborhood;
+ * and the number of buckets examined.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+typename HopscotchHashTable_t<K, V, Hash, Eq>::InsertSlot HopscotchHashTable_t<K, V, Hash, Eq>::tryPlace(Bucket& entry) {
+    if (numFilled == capacity()) {
+        return {NOT_FOUND, 0};
+    }
+    const size_t home = homeIndex(entry.hashValue);
+    size_t distance = 0; // Distance of the empty bucket from home.
+    size_t probes = 1;
+    while (ControlByte::isFull(slotAt(control, (home + distance) & indexMask))) {
+        ++distance;
+        ++probes;
+    }
+    while (distance >= neighborhoodSize) {
+        const size_t empty = (home + distance) & indexMask;
+        bool moved = false;
+        for (size_t back = neighborhoodSize - 1; back > 0 && !moved; --back) {
+            const size_t candidateHome = (empty - back) & indexMask;
+            // Keys of candidateHome stored before the empty bucket, which is back places after it.
+            if (const uint32_t candidates = slotAt(neighborhoods, candidateHome) & ((static_cast<uint32_t>(1) << back) - 1); candidates != 0) {
+                const auto offset = static_cast<size_t>(std::countr_zero(candidates));
+                const size_t source = (candidateHome + offset) & indexMask;
+                slotAt(tableData, empty) = std::move(slotAt(tableData, source));
+                slotAt(control, empty) = slotAt(control, source);
+                slotAt(control, source) = ControlByte::ESS;
+                slotAt(neighborhoods, candidateHome) ^= (static_cast<uint32_t>(1) << offset) | (static_cast<uint32_t>(1) << back);
+                distance -= back - offset;
+                moved = true;
+            }
+            ++probes;
+        }
+        if (!moved) {
+            return {NOT_FOUND, probes};
+        }
+    }
+    const size_t index = (home + distance) & indexMask;
+    slotAt(control, index) = ControlByte::fingerprint(entry.hashValue);
+    slotAt(tableData, index) = std::move(entry);
+    slotAt(neighborhoods, home) |= static_cast<uint32_t>(1) << distance;
+    ++numFilled;
+    return {index, probes};
+}
+
+/**
+ * @brief Empties a filled bucket.
+ *
+ * Clears the bucket's bit in the bitmap of its key's home bucket and resets it, releasing any storage owned by its key.
+ * An overflow entry is replaced by the last one instead.
+ *
+ * @param index bucket to be emptied, or capacity() plus the position of an overflow entry.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void HopscotchHashTable_t<K, V, Hash, Eq>::vacateBucket(const size_t index) {
+    if (index >= capacity()) {
+        overflow[index - capacity()] = std::move(overflow.back());
+        overflow.pop_back();
+        return;
+    }
+    const size_t home = homeIndex(slotAt(tableData, index).hashValue);
+    slotAt(neighborhoods, home) &= ~(static_cast<uint32_t>(1) << ((index - home) & indexMask));
+    slotAt(control, index) = ControlByte::ESS;
+    slotAt(tableData, index) = Bucket();
+    --numFilled;
+}
+
+/**
+ * @brief Find index of bucket containing key, and count buckets examined.
+ *
+ * Compares the buckets named by the bitmap of the key's home bucket, first by control byte, then by cached hash and key.
+ * Only if the key is not among them and the overflow list is not empty is the list searched.
+ *
+ * @param key Key to be searched.
+ * @param hashValue Mixed hash of key.
+ * @return Index of bucket holding key (capacity() plus its position for an overflow entry), or NOT_FOUND;
+ * and the number of probes, counting the bitmap and every bucket or overflow entry compared before the key.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+std::pair<size_t, size_t> HopscotchHashTable_t<K, V, Hash, Eq>::search(const KeyArg key, const size_t hashValue) const {
+    const size_t home = homeIndex(hashValue);
+    const uint8_t fingerprint = ControlByte::fingerprint(hashValue);
+    size_t probes = 1;
+    for (uint32_t members = slotAt(neighborhoods, home); members != 0; members &= members - 1, ++probes) {
+        const size_t index = (home + static_cast<size_t>(std::countr_zero(members))) & indexMask;
+        if (slotAt(control, index) == fingerprint && slotAt(tableData, index).hashValue == hashValue && equal(slotAt(tableData, index).key, key)) {
+            return {index, probes + 1};
+        }
+    }
+    for (size_t entryNum = 0; entryNum < overflow.size(); ++entryNum, ++probes) {
+        if (overflow[entryNum].hashValue == hashValue && equal(overflow[entryNum].key, key)) {
+            return {capacity() + entryNum, probes + 1};
+        }
+    }
+    return {NOT_FOUND, probes};
+}
+
+/**
+ * @brief Bucket or overflow entry at an index returned by find.
+ *
+ * @param index index of a filled bucket, or capacity() plus the position of an overflow entry.
+ * @return bucket or overflow entry.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+typename HopscotchHashTable_t<K, V, Hash, Eq>::Bucket& HopscotchHashTable_t<K, V, Hash, Eq>::bucketAt(const size_t index) {
+    return index < capacity() ? slotAt(tableData, index) : overflow[index - capacity()];
+}
+
+/**
+ * @brief Bucket or overflow entry at an index returned by find.
+ *
+ * @param index index of a filled bucket, or capacity() plus the position of an overflow entry.
+ * @return bucket or overflow entry.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+const typename HopscotchHashTable_t<K, V, Hash, Eq>::Bucket& HopscotchHashTable_t<K, V, Hash, Eq>::bucketAt(const size_t index) const {
+    return index < capacity() ? slotAt(tableData, index) : overflow[index - capacity()];
+}
+
+/**
+ * @brief Find index of bucket containing key.
+ *
+ * @param key Key to be searched.
+ * @param hashValue Mixed hash of key.
+ * @return Index of bucket holding key, or NOT_FOUND.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t HopscotchHashTable_t<K, V, Hash, Eq>::find(const KeyArg key, const size_t hashValue) const {
+    return search(key, hashValue).first;
+}
+
+/**
+ * @brief Mixed hash of a key, from which its home bucket is taken.
+ *
+ * Computed once per operation and cached in the key's bucket. Mixing spreads keys with weak hashes
+ * (such as integers under std::hash, whose hash is the key) over the whole table, as in HashTable_t::hashOf.
+ *
+ * @param key Key to be hashed.
+ * @return mixHash of the hash of key.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+HASHTABLE_INLINE size_t HopscotchHashTable_t<K, V, Hash, Eq>::hashOf(const KeyArg key) const {
+    return static_cast<size_t>(mixHash(static_cast<uint64_t>(hash(key))));
+}
+
+/**
+ * @brief Home bucket for a key with given hash.
+ *
+ * The mixed hash is mapped onto the table by its high bits (fastrange).
+ *
+ * @param hashValue Mixed hash of key.
+ * @return index of the home bucket of the key.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+HASHTABLE_INLINE size_t HopscotchHashTable_t<K, V, Hash, Eq>::homeIndex(const size_t hashValue) const {
+    return static_cast<size_t>(mulhi64(hashValue, capacity()));
+}
+
+#endif // HOPSCOTCHHASHTABLE_H
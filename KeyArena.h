@@ -0,0 +1,321 @@
+#ifndef KEYARENA_H
+#define KEYARENA_H
+
+/*
+ * Greg Rosen
+ * Project 4: HashTable
+ * Declaration and implementation of arena storage for string keys
+ */
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+/**
+ * @class ArenaString
+ * @brief String key whose characters are stored in the key arena of the HashTable holding it.
+ *
+ * Used as the key type of a HashTable_t selects arena key storage: instead of every key owning a heap allocation,
+ * the table copies key characters into a KeyArena it owns, and each bucket holds only a pointer and a length.
+ * Outside a table, an ArenaString is a non-owning view of the characters it was constructed from,
+ * so std::string, std::string_view, and const char* keys are all inserted without a copy or allocation.
+ *
+ * @warning Keys returned by a table (such as by keys()) view the table's arena, and are invalidated
+ * when the key is removed or the table is rehashed.
+ */
+class ArenaString {
+private:
+    const char* characters = nullptr; // First character of key (not null-terminated).
+    size_t length = 0; // Number of characters in key.
+
+public:
+    ArenaString() = default; // Default constructor for ArenaString (empty key).
+    ArenaString(std::string_view view); // Constructs a view of the given characters.
+    ArenaString(const std::string& string); // Constructs a view of the characters of a string.
+    ArenaString(const char* string); // Constructs a view of a null-terminated string.
+
+    [[nodiscard]] std::string_view view() const; // Getter for the characters of key.
+    [[nodiscard]] size_t size() const; // Getter for number of characters in key.
+    operator std::string_view() const; // Conversion to the characters of key.
+
+    /**
+     * @brief Equality operator overload for ArenaString.
+     *
+     * Compares characters, so that keys stored in different arenas compare equal.
+     *
+     * @param key key to be compared
+     * @param other characters to be compared
+     * @return true if characters are equal, false if not.
+     */
+    friend bool operator==(const ArenaString& key, const std::string_view other) {
+        return key.view() == other;
+    }
+
+    /**
+     * @brief Stream insertion operator overload for ArenaString.
+     *
+     * @param os output stream
+     * @param key key to be output
+     * @return output stream with characters of key added
+     */
+    friend std::ostream& operator<<(std::ostream& os, const ArenaString& key) {
+        return os << key.view();
+    }
+};
+
+/**
+ * @class KeyArena
+ * @brief Bump allocator holding the characters of the ArenaString keys of a HashTable.
+ *
+ * Characters are appended to fixed-size slabs, so storing a key costs a copy and, once per slab, an allocation.
+ * Slabs are drawn from a std::pmr::memory_resource (the default resource unless one is given), and are linked
+ * through a header at the start of each, so the arena allocates nothing else.
+ * Slabs never move, so stored keys stay valid until the arena is destroyed, including when the arena is moved.
+ * Space is never freed individually; removed keys are only counted, and reclaimed when the table rehashes into a new arena.
+ * Keys longer than a quarter of a slab are given a slab of their own, so at most a quarter of a slab is abandoned.
+ * Copying an arena is not allowed, since the keys referring to it would still refer to the original.
+ * Keys may also view storage the arena did not allocate (such as a mapped snapshot file), which it then keeps alive.
+ */
+class KeyArena {
+public:
+    static constexpr size_t SLAB_SIZE = 64 * 1024; // Number of characters per slab.
+
+private:
+    /**
+     * @struct Slab
+     * @brief Header at the start of every slab, linking it to the slab allocated before it.
+     */
+    struct Slab {
+        Slab* previous; // Slab allocated before this one, or null.
+        size_t size; // Number of bytes allocated for the slab, header included.
+    };
+
+    std::pmr::memory_resource* resource; // Source of slab memory.
+    Slab* lastSlab = nullptr; // Most recently allocated slab, heading the list of every slab.
+    char* next = nullptr; // Next free character of the current slab.
+    size_t remaining = 0; // Number of free characters in the current slab.
+    size_t bytesReserved = 0; // Number of bytes allocated across all slabs.
+    size_t bytesReleased = 0; // Number of characters of keys that have been released.
+    std::shared_ptr<const void> adopted; // Storage not allocated by the arena holding some of its keys, or null.
+
+    [[nodiscard]] char* allocateSlab(size_t numCharacters); // Allocates a slab with room for a number of characters.
+
+public:
+    explicit KeyArena(std::pmr::memory_resource* inResource = std::pmr::get_default_resource()); // Default and parameterized constructor for KeyArena.
+    KeyArena(const KeyArena&) = delete;
+    KeyArena(KeyArena&& other) noexcept; // Move constructor for KeyArena.
+    KeyArena& operator=(const KeyArena&) = delete;
+    KeyArena& operator=(KeyArena&& other) noexcept; // Move assignment operator for KeyArena.
+    ~KeyArena(); // Destructor for KeyArena.
+
+    [[nodiscard]] ArenaString store(std::string_view key); // Copies the characters of a key into the arena.
+    void release(const ArenaString& key); // Records that a stored key is no longer used.
+    void adopt(std::shared_ptr<const void> storage, size_t numCharacters); // Keeps storage holding keys alive as long as the arena.
+    [[nodiscard]] size_t capacity() const; // Getter for number of bytes allocated by the arena.
+    [[nodiscard]] size_t released() const; // Getter for number of characters of released keys.
+};
+
+/**
+ * @brief Constructs a view of the given characters.
+ *
+ * @param view characters of key
+ */
+inline ArenaString::ArenaString(const std::string_view view) :
+    characters(view.data()), length(view.size()) {}
+
+/**
+ * @brief Constructs a view of the characters of a string.
+ *
+ * @warning The string must outlive the ArenaString, unless it is inserted into a table (which copies it).
+ * @param string string holding characters of key
+ */
+inline ArenaString::ArenaString(const std::string& string) :
+    ArenaString(std::string_view(string)) {}
+
+/**
+ * @brief Constructs a view of a null-terminated string.
+ *
+ * @param string null-terminated characters of key
+ */
+inline ArenaString::ArenaString(const char* string) :
+    ArenaString(std::string_view(string)) {}
+
+/**
+ * @brief Getter for the characters of key.
+ *
+ * @return view of characters of key.
+ */
+inline std::string_view ArenaString::view() const {
+    return {characters, length};
+}
+
+/**
+ * @brief Getter for number of characters in key.
+ *
+ * @return length of key.
+ */
+inline size_t ArenaString::size() const {
+    return length;
+}
+
+/**
+ * @brief Conversion to the characters of key.
+ *
+ * Lets ArenaString keys be hashed and compared as std::string_view.
+ *
+ * @return view of characters of key.
+ */
+inline ArenaString::operator std::string_view() const {
+    return view();
+}
+
+/**
+ * @brief Default and parameterized constructor for KeyArena.
+ *
+ * Creates an arena with no slabs; the first is allocated when the first key is stored.
+ *
+ * @param inResource Memory resource slabs are allocated from (default std::pmr::get_default_resource()).
+ */
+inline KeyArena::KeyArena(std::pmr::memory_resource* const inResource) :
+    resource(inResource) {}
+
+/**
+ * @brief Move constructor for KeyArena.
+ *
+ * Takes over the slabs of other, leaving it empty; keys stored in other stay valid.
+ *
+ * @param other arena to be moved from
+ */
+inline KeyArena::KeyArena(KeyArena&& other) noexcept :
+    resource(other.resource), lastSlab(std::exchange(other.lastSlab, nullptr)), next(std::exchange(other.next, nullptr)),
+    remaining(std::exchange(other.remaining, 0)), bytesReserved(std::exchange(other.bytesReserved, 0)),
+    bytesReleased(std::exchange(other.bytesReleased, 0)), adopted(std::move(other.adopted)) {}
+
+/**
+ * @brief Move assignment operator for KeyArena.
+ *
+ * Exchanges slabs and memory resources with other, which frees the previous slabs of this arena when destroyed.
+ *
+ * @param other arena to be moved from
+ * @return this arena
+ */
+inline KeyArena& KeyArena::operator=(KeyArena&& other) noexcept {
+    std::swap(resource, other.resource);
+    std::swap(lastSlab, other.lastSlab);
+    std::swap(next, other.next);
+    std::swap(remaining, other.remaining);
+    std::swap(bytesReserved, other.bytesReserved);
+    std::swap(bytesReleased, other.bytesReleased);
+    std::swap(adopted, other.adopted);
+    return *this;
+}
+
+/**
+ * @brief Destructor for KeyArena.
+ *
+ * Returns every slab to the memory resource it was allocated from.
+ */
+inline KeyArena::~KeyArena() {
+    while (lastSlab != nullptr) {
+        Slab* const previous = lastSlab->previous;
+        resource->deallocate(lastSlab, lastSlab->size, alignof(Slab));
+        lastSlab = previous;
+    }
+}
+
+/**
+ * @brief Allocates a slab with room for a number of characters.
+ *
+ * The slab is linked into the list of slabs, but does not become the current slab.
+ *
+ * @param numCharacters Number of characters the slab must hold.
+ * @return pointer to the first character of the slab.
+ */
+inline char* KeyArena::allocateSlab(const size_t numCharacters) {
+    const size_t size = sizeof(Slab) + numCharacters;
+    lastSlab = ::new (resource->allocate(size, alignof(Slab))) Slab{lastSlab, size};
+    bytesReserved += size;
+    return reinterpret_cast<char*>(lastSlab + 1);
+}
+
+/**
+ * @brief Copies the characters of a key into the arena.
+ *
+ * Appends to the current slab if the key fits, and starts a new slab otherwise.
+ * The unused end of the previous slab is abandoned.
+ *
+ * @param key characters to be stored
+ * @return key viewing the stored characters.
+ */
+inline ArenaString KeyArena::store(const std::string_view key) {
+    if (key.empty()) {
+        return {};
+    }
+    if (key.size() > remaining) {
+        if (key.size() > SLAB_SIZE / 4) { // Long keys get a slab of their own, leaving the current slab in use.
+            char* const stored = allocateSlab(key.size());
+            std::memcpy(stored, key.data(), key.size());
+            return std::string_view(stored, key.size());
+        }
+        next = allocateSlab(SLAB_SIZE);
+        remaining = SLAB_SIZE;
+    }
+    char* const stored = next;
+    std::memcpy(stored, key.data(), key.size());
+    next += key.size();
+    remaining -= key.size();
+    return std::string_view(stored, key.size());
+}
+
+/**
+ * @brief Records that a stored key is no longer used.
+ *
+ * The characters stay allocated until the arena is destroyed.
+ *
+ * @param key key previously returned by store
+ */
+inline void KeyArena::release(const ArenaString& key) {
+    bytesReleased += key.size();
+}
+
+/**
+ * @brief Keeps storage holding keys alive as long as the arena.
+ *
+ * Lets keys view characters stored elsewhere as if they had been stored in the arena; they are counted
+ * towards the capacity, and released like any other key. Only one such storage may be adopted at a time.
+ *
+ * @param storage owner of the characters
+ * @param numCharacters number of characters the keys view
+ */
+inline void KeyArena::adopt(std::shared_ptr<const void> storage, const size_t numCharacters) {
+    adopted = std::move(storage);
+    bytesReserved += numCharacters;
+}
+
+/**
+ * @brief Getter for number of bytes allocated by the arena.
+ *
+ * Includes slab headers, the unused ends of slabs, the characters of removed keys, and adopted storage.
+ *
+ * @return number of bytes allocated across all slabs.
+ */
+inline size_t KeyArena::capacity() const {
+    return bytesReserved;
+}
+
+/**
+ * @brief Getter for number of characters of released keys.
+ *
+ * @return number of characters released since the arena was created.
+ */
+inline size_t KeyArena::released() const {
+    return bytesReleased;
+}
+
+#endif // KEYARENA_H
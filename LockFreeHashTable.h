@@ -0,0 +1,593 @@
+#ifndef LOCKFREEHASHTABLE_H
+#define LOCKFREEHASHTABLE_H
+
+/*
+ * Greg Rosen
+ * Project 4: HashTable
+ * Declaration and implementation of LockFreeHashTable_t class template (experimental)
+ */
+
+#include "HashTableImpl.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+/**
+ * @class LockFreeHashTable_t
+ * @brief Experimental HashTable for <K, V> key-value pairs supporting concurrent inserts and lookups without locks.
+ *
+ * Open addressing with linear probing over a power-of-two bucket array, starting from the mixed hash of a key (see mixHash),
+ * which is computed once per operation and cached in the bucket. Every bucket has an atomic state byte,
+ * extending the ESS/EAR/NORMAL history types with transient states owned by a single thread:
+ * CLAIMED - An inserter won the CAS from ESS and is writing the key. Other threads wait for it to become NORMAL.
+ * UPDATING - A writer owns the value (update, insert_or_assign, remove).
+ * COPYING - A resizing thread is copying the pair into the next array.
+ * MOVED - The bucket's pair has been migrated; it lives in the next array.
+ * FROZEN - The bucket was empty when migrated. Like ESS, it ends a probe of this array, which continues in the next one.
+ * Keys are written once before being published and never modified afterwards, so lookups read them without locks;
+ * values are std::atomic<V>, so V must be trivially copyable.
+ *
+ * Removed buckets stay tombstones until the next resize (they are never reclaimed in place), so a key is always
+ * stored in the first bucket of its probe sequence that was ESS when it was inserted.
+ * Once the claimed buckets of the current array reach the load factor threshold, a larger array is attached to it
+ * and every later insert first helps migrate one chunk of CHUNK_SIZE buckets. The thread finishing the last chunk
+ * makes the new array current. Lookups search the current array and then any array attached to it.
+ * Replaced arrays may still be read by other threads, so they are only freed by releaseRetired or on destruction.
+ *
+ * @warning Experimental. Threads wait briefly on CLAIMED, UPDATING, and COPYING buckets, so progress is not
+ * strictly lock-free while a single bucket is being written.
+ *
+ * @author Greg Rosen
+ * @date November 2, 2025
+ */
+template<typename K, typename V, typename Hash = DefaultHash<K>, typename Eq = DefaultKeyEqual<K>>
+class LockFreeHashTable_t {
+    static_assert(std::is_trivially_copyable_v<V>, "LockFreeHashTable_t stores values in std::atomic<V>");
+
+public:
+    using KeyArg = typename KeyTraits<K>::lookup_type; // Parameter type accepted by lookups.
+    static constexpr size_t CHUNK_SIZE = 1024; // Number of buckets migrated by a thread at a time during a resize.
+
+private:
+    /**
+     * @enum BucketState
+     * @brief State of a bucket, stored in an atomic byte.
+     */
+    enum class BucketState : uint8_t {ESS, CLAIMED, NORMAL, UPDATING, EAR, COPYING, MOVED, FROZEN};
+
+    /**
+     * @struct Bucket
+     * @brief Bucket for LockFreeHashTable
+     *
+     * hashValue and key are only written while the bucket is CLAIMED, and are published by the release store of NORMAL.
+     */
+    struct Bucket {
+        std::atomic<BucketState> state{BucketState::ESS}; // History type of bucket.
+        size_t hashValue = 0; // Mixed hash of key (see hashOf).
+        K key{}; // Key for hash table entry.
+        std::atomic<V> value{}; // Value for hash table entry.
+    };
+
+    /**
+     * @struct BucketArray
+     * @brief One generation of buckets, with the progress of its migration into the next generation.
+     *
+     * Owns the next generation, so the first array owns every array ever made current.
+     */
+    struct BucketArray {
+        const size_t capacity; // Number of buckets (a power of two).
+        std::unique_ptr<Bucket[]> buckets; // The buckets.
+        std::atomic<size_t> numClaimed{0}; // Number of buckets that have left ESS, counting tombstones.
+        std::atomic<BucketArray*> next{nullptr}; // Array being migrated into, or null if no resize has started.
+        std::atomic<size_t> nextChunk{0}; // Index of the next chunk to be migrated.
+        std::atomic<size_t> chunksDone{0}; // Number of chunks fully migrated.
+
+        explicit BucketArray(size_t inCapacity); // Parameterized constructor for BucketArray.
+        ~BucketArray(); // Destructor for BucketArray; frees the next generation.
+        BucketArray(const BucketArray&) = delete;
+        BucketArray& operator=(const BucketArray&) = delete;
+
+        [[nodiscard]] size_t numChunks() const; // Number of chunks the array is migrated in.
+    };
+
+    /**
+     * @enum ClaimResult
+     * @brief Outcome of an attempt to insert a key into one array.
+     */
+    enum class ClaimResult {INSERTED, DUPLICATE, REDIRECT};
+
+    const double threshold; // The load factor threshold for resizing (default 0.5).
+    const double resizeFactor; // The factor by which the capacity will be increased upon resizing (default 2.0).
+    std::unique_ptr<BucketArray> first; // The oldest array still allocated, owning all later ones.
+    std::atomic<BucketArray*> current; // The array new operations start from.
+    std::atomic<size_t> numFilled{0}; // The number of key-value pairs in the table.
+    [[no_unique_address]] Hash hash; // Using () overload, provides hash function size_t hash(KeyArg)
+    [[no_unique_address]] Eq equal; // Using () overload, provides key equality predicate bool equal(K, KeyArg)
+
+    [[nodiscard]] size_t hashOf(KeyArg key) const; // Mixed hash of a key, from which its probe sequence starts.
+    ClaimResult claim(BucketArray& array, const K& key, size_t hashValue, V value); // Insert key-value pair into one array.
+    [[nodiscard]] Bucket* acquire(KeyArg key, size_t hashValue); // Find bucket containing key and take ownership of its value.
+    void startResize(BucketArray& array); // Attaches a larger array to an array, if none is attached yet.
+    void helpMigrate(BucketArray& array); // Migrates one chunk of an array being resized.
+    void migrateBucket(BucketArray& array, Bucket& bucket); // Migrates one bucket of an array being resized.
+
+public:
+    explicit LockFreeHashTable_t(size_t initCapacity = 8, double inThreshold = 0.5, double inResizeFactor = 2.0); // Default and parameterized constructor for lock-free hash table.
+    LockFreeHashTable_t(const LockFreeHashTable_t&) = delete;
+    LockFreeHashTable_t& operator=(const LockFreeHashTable_t&) = delete;
+
+    [[nodiscard]] size_t capacity() const; // Getter for capacity of the current array.
+    [[nodiscard]] size_t size() const; // Getter for size of the hash table.
+    [[nodiscard]] double alpha() const; // Getter for the load factor of the hash table.
+    [[nodiscard]] std::optional<V> get(KeyArg key) const; // Getter for value stored using a given key.
+
+    [[nodiscard]] bool contains(KeyArg key) const; // Predicate for if a given key is stored in table.
+
+    bool insert(const K& key, const V& value); // Insert key-value pair into table.
+    bool insert_or_assign(const K& key, const V& value); // Insert key-value pair, or assign value if key is present.
+    template<typename Function>
+    bool update(KeyArg key, Function function); // Modifies value stored using a given key.
+    bool remove(KeyArg key); // Remove key-value pair from table.
+
+    void releaseRetired(); // Frees arrays that have been replaced.
+};
+
+/**
+ * @brief LockFreeHashTable for <string, unsigned long> key-value pairs
+ *
+ * The LockFreeHashTable_t class template instantiated for string keys and unsigned long (size_t) values.
+ */
+using LockFreeHashTable = LockFreeHashTable_t<std::string, size_t>;
+
+/**
+ * @brief Parameterized constructor for BucketArray.
+ *
+ * @param inCapacity Number of buckets (a power of two).
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+LockFreeHashTable_t<K, V, Hash, Eq>::BucketArray::BucketArray(const size_t inCapacity) :
+    capacity(inCapacity), buckets(std::make_unique<Bucket[]>(inCapacity)) {}
+
+/**
+ * @brief Destructor for BucketArray; frees the next generation.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+LockFreeHashTable_t<K, V, Hash, Eq>::BucketArray::~BucketArray() {
+    delete next.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Number of chunks the array is migrated in.
+ *
+ * @return capacity / CHUNK_SIZE, rounded up.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t LockFreeHashTable_t<K, V, Hash, Eq>::BucketArray::numChunks() const {
+    return (capacity + CHUNK_SIZE - 1) / CHUNK_SIZE;
+}
+
+/**
+ * @brief Default and parameterized constructor for lock-free hash table.
+ *
+ * Creates a hash table with given number of initial empty buckets, rounded up to the next power of two.
+ *
+ * @param initCapacity Initial number of empty buckets in hash table (default 8).
+ * @param inThreshold The load factor threshold for resizing (default 0.5).
+ * @param inResizeFactor The factor by which the capacity will be increased upon resizing (default 2.0).
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+LockFreeHashTable_t<K, V, Hash, Eq>::LockFreeHashTable_t(const size_t initCapacity, const double inThreshold, const double inResizeFactor) :
+    threshold(inThreshold), resizeFactor(inResizeFactor),
+    first(std::make_unique<BucketArray>(std::bit_ceil(std::max(initCapacity, static_cast<size_t>(1))))), current(first.get()), hash(makeHash<Hash>()), equal() {}
+
+/**
+ * @brief Getter for capacity of the current array.
+ *
+ * @return capacity of hash table
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t LockFreeHashTable_t<K, V, Hash, Eq>::capacity() const {
+    return current.load(std::memory_order_acquire)->capacity;
+}
+
+/**
+ * @brief Getter for size of hash table.
+ *
+ * Exact when no operation is in progress.
+ *
+ * @return size of hash table
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t LockFreeHashTable_t<K, V, Hash, Eq>::size() const {
+    return numFilled.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Getter for load factor (alpha) of hash table.
+ *
+ * @return load factor (alpha) of hash table
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+double LockFreeHashTable_t<K, V, Hash, Eq>::alpha() const {
+    return static_cast<double>(size())/static_cast<double>(capacity());
+}
+
+/**
+ * @brief Getter for value stored using a given key.
+ *
+ * Searches the current array, then the arrays attached to it during a resize.
+ * In each array, probing stops at an ESS or FROZEN bucket; tombstones and MOVED buckets are skipped.
+ * A pair being copied is still read from the old array, since its value cannot change until the copy is complete.
+ *
+ * @param key Key to be searched.
+ * @return value associated with key or nullopt.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+std::optional<V> LockFreeHashTable_t<K, V, Hash, Eq>::get(const KeyArg key) const {
+    const size_t hashValue = hashOf(key);
+    for (const BucketArray* array = current.load(std::memory_order_acquire); array != nullptr; array = array->next.load(std::memory_order_acquire)) {
+        const size_t indexMask = array->capacity - 1;
+        for (size_t probeNum = 0; probeNum < array->capacity; ++probeNum) {
+            const Bucket& currBucket = array->buckets[(hashValue + probeNum) & indexMask];
+            BucketState state = currBucket.state.load(std::memory_order_acquire);
+            while (state == BucketState::CLAIMED) { // Wait for the key to be written.
+                std::this_thread::yield();
+                state = currBucket.state.load(std::memory_order_acquire);
+            }
+            if (state == BucketState::ESS || state == BucketState::FROZEN) { // Key cannot be further along in this array.
+                break;
+            }
+            if (state != BucketState::EAR && state != BucketState::MOVED
+                && currBucket.hashValue == hashValue && equal(currBucket.key, key)) {
+                return currBucket.value.load(std::memory_order_acquire);
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Predicate for if a given key is stored in table.
+ *
+ * @param key Key to be searched.
+ * @return true if key found, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool LockFreeHashTable_t<K, V, Hash, Eq>::contains(const KeyArg key) const {
+    return get(key).has_value();
+}
+
+/**
+ * @brief Insert key-value pair into table.
+ *
+ * Helps with any resize in progress, then claims the first ESS bucket in the key's probe sequence of the current array
+ * with a CAS. Threads inserting the same key follow the same sequence, so all but one of them find it as a duplicate.
+ * If the current array has no ESS bucket left or is being resized, the key is inserted into the array attached to it
+ * (attaching one if needed), once it has been checked not to be a duplicate in the current array.
+ * Starts a resize if the claimed buckets of the current array reach the load factor threshold.
+ *
+ * @param key of key-value pair to be inserted.
+ * @param value Value of key-value pair to be inserted.
+ * @return true if insertion successful, false if key already present.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool LockFreeHashTable_t<K, V, Hash, Eq>::insert(const K& key, const V& value) {
+    const size_t hashValue = hashOf(key);
+    BucketArray* array = current.load(std::memory_order_acquire);
+    helpMigrate(*array);
+    while (true) {
+        switch (claim(*array, key, hashValue, value)) {
+            case ClaimResult::INSERTED:
+                numFilled.fetch_add(1, std::memory_order_relaxed);
+                if (static_cast<double>(array->numClaimed.load(std::memory_order_relaxed)) >= threshold * static_cast<double>(array->capacity)
+                    && array == current.load(std::memory_order_acquire)) { // Resize if necessary.
+                    startResize(*array);
+                }
+                return true;
+            case ClaimResult::DUPLICATE:
+                return false;
+            case ClaimResult::REDIRECT:
+                startResize(*array);
+                array = array->next.load(std::memory_order_acquire);
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Insert key-value pair, or assign value if key is present.
+ *
+ * @param key of key-value pair to be inserted or assigned.
+ * @param value Value to be stored.
+ * @return true if the pair was inserted, false if an existing value was assigned.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool LockFreeHashTable_t<K, V, Hash, Eq>::insert_or_assign(const K& key, const V& value) {
+    while (true) {
+        if (update(key, [&value](V& stored) {stored = value;})) {
+            return false;
+        }
+        if (insert(key, value)) {
+            return true;
+        }
+        // Another thread inserted the key in between; assign to it instead.
+    }
+}
+
+/**
+ * @brief Modifies value stored using a given key.
+ *
+ * function is called with a copy of the value while this thread owns the bucket (UPDATING),
+ * and the result is stored back, so concurrent updates of the same key are applied one at a time.
+ * E.G:
+ * table.update("name", [](size_t& count) {++count;});
+ *
+ * @param key Key to be searched.
+ * @param function Callable taking V&; must not access the table.
+ * @return true if key found and function applied, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+template<typename Function>
+bool LockFreeHashTable_t<K, V, Hash, Eq>::update(const KeyArg key, Function function) {
+    Bucket* foundBucket = acquire(key, hashOf(key));
+    if (foundBucket == nullptr) {
+        return false;
+    }
+    V value = foundBucket->value.load(std::memory_order_relaxed);
+    function(value);
+    foundBucket->value.store(value, std::memory_order_relaxed);
+    foundBucket->state.store(BucketState::NORMAL, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Remove key-value pair from table.
+ *
+ * The bucket is marked EAR (tombstone); it is not reused until the next resize.
+ *
+ * @param key Key to be searched.
+ * @return true if removal successful, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool LockFreeHashTable_t<K, V, Hash, Eq>::remove(const KeyArg key) {
+    Bucket* foundBucket = acquire(key, hashOf(key));
+    if (foundBucket == nullptr) {
+        return false;
+    }
+    foundBucket->state.store(BucketState::EAR, std::memory_order_release);
+    numFilled.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+/**
+ * @brief Frees arrays that have been replaced.
+ *
+ * @warning Must not be called while any other operation on the table is in progress.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void LockFreeHashTable_t<K, V, Hash, Eq>::releaseRetired() {
+    BucketArray* const live = current.load(std::memory_order_acquire);
+    while (first.get() != live) {
+        std::unique_ptr<BucketArray> retired = std::move(first);
+        first.reset(retired->next.exchange(nullptr, std::memory_order_acq_rel)); // Detach before the retired array frees it.
+    }
+}
+
+/**
+ * @brief Mixed hash of a key, from which its probe sequence starts.
+ *
+ * Hash functions such as std::hash return integer keys unchanged, so strided keys would share a few home buckets
+ * of a power-of-two array; mixing spreads them over the whole array.
+ *
+ * @param key Key to be hashed.
+ * @return mixHash of the hash of key.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t LockFreeHashTable_t<K, V, Hash, Eq>::hashOf(const KeyArg key) const {
+    return static_cast<size_t>(mixHash(static_cast<uint64_t>(hash(key))));
+}
+
+/**
+ * @brief Insert key-value pair into one array.
+ *
+ * Probes the array for the key, skipping tombstones and MOVED buckets, and claims the first ESS bucket found.
+ * A FROZEN bucket ends the probe, since the array is being resized and the key belongs in the next array.
+ * A failed CAS re-examines the same bucket, since another thread may just have claimed it for the same key.
+ * After a successful CAS, the claim is abandoned (leaving a tombstone) if a resize of the array has started:
+ * a thread that saw the resize may already have searched past the bucket. Both the CAS and the check are
+ * sequentially consistent with the store attaching the next array, so either this thread sees the resize,
+ * or every thread that sees it also sees the claimed bucket.
+ *
+ * @param array Array to insert into.
+ * @param key of key-value pair to be inserted.
+ * @param hashValue Full hash of key.
+ * @param value Value of key-value pair to be inserted.
+ * @return INSERTED, DUPLICATE if key found in the array, or REDIRECT if the key must go to the next array
+ * (no ESS bucket left in the probe sequence, or a resize has started).
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+typename LockFreeHashTable_t<K, V, Hash, Eq>::ClaimResult LockFreeHashTable_t<K, V, Hash, Eq>::claim(BucketArray& array, const K& key,
+    const size_t hashValue, const V value) {
+    const size_t indexMask = array.capacity - 1;
+    for (size_t probeNum = 0; probeNum < array.capacity; ++probeNum) {
+        Bucket& currBucket = array.buckets[(hashValue + probeNum) & indexMask];
+        BucketState state = currBucket.state.load(std::memory_order_acquire);
+        while (state == BucketState::ESS || state == BucketState::CLAIMED) {
+            if (state == BucketState::CLAIMED) { // Wait for the key to be written.
+                std::this_thread::yield();
+                state = currBucket.state.load(std::memory_order_acquire);
+            }
+            else if (currBucket.state.compare_exchange_weak(state, BucketState::CLAIMED, std::memory_order_seq_cst, std::memory_order_acquire)) {
+                if (array.next.load(std::memory_order_seq_cst) != nullptr) { // A resize has started; give the bucket up as a tombstone.
+                    currBucket.state.store(BucketState::EAR, std::memory_order_release);
+                    array.numClaimed.fetch_add(1, std::memory_order_relaxed);
+                    return ClaimResult::REDIRECT;
+                }
+                currBucket.hashValue = hashValue;
+                currBucket.key = key;
+                currBucket.value.store(value, std::memory_order_relaxed);
+                currBucket.state.store(BucketState::NORMAL, std::memory_order_release);
+                array.numClaimed.fetch_add(1, std::memory_order_relaxed);
+                return ClaimResult::INSERTED;
+            }
+        }
+        if (state == BucketState::FROZEN) { // No key was inserted past this bucket before the resize froze it.
+            return ClaimResult::REDIRECT;
+        }
+        if (state != BucketState::EAR && state != BucketState::MOVED
+            && currBucket.hashValue == hashValue && equal(currBucket.key, key)) {
+            return ClaimResult::DUPLICATE;
+        }
+    }
+    return ClaimResult::REDIRECT;
+}
+
+/**
+ * @brief Find bucket containing key and take ownership of its value.
+ *
+ * Searches like get, but moves the bucket found from NORMAL to UPDATING with a CAS; the caller then stores NORMAL
+ * (or EAR) to release it. If the bucket is being copied, waits for the copy and continues in the next array.
+ * If it was removed in the meantime, probing continues, since the key may have been inserted again further along.
+ *
+ * @param key Key to be searched.
+ * @param hashValue Full hash of key.
+ * @return Pointer to owned bucket, or nullptr if key not found.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+typename LockFreeHashTable_t<K, V, Hash, Eq>::Bucket* LockFreeHashTable_t<K, V, Hash, Eq>::acquire(const KeyArg key, const size_t hashValue) {
+    for (BucketArray* array = current.load(std::memory_order_acquire); array != nullptr; array = array->next.load(std::memory_order_acquire)) {
+        const size_t indexMask = array->capacity - 1;
+        for (size_t probeNum = 0; probeNum < array->capacity; ++probeNum) {
+            Bucket& currBucket = array->buckets[(hashValue + probeNum) & indexMask];
+            BucketState state = currBucket.state.load(std::memory_order_acquire);
+            while (state == BucketState::CLAIMED) { // Wait for the key to be written.
+                std::this_thread::yield();
+                state = currBucket.state.load(std::memory_order_acquire);
+            }
+            if (state == BucketState::ESS || state == BucketState::FROZEN) { // Key cannot be further along in this array.
+                break;
+            }
+            if (state == BucketState::EAR || state == BucketState::MOVED
+                || currBucket.hashValue != hashValue || !equal(currBucket.key, key)) {
+                continue;
+            }
+            while (state == BucketState::NORMAL || state == BucketState::UPDATING || state == BucketState::COPYING) {
+                if (state == BucketState::NORMAL) {
+                    if (currBucket.state.compare_exchange_weak(state, BucketState::UPDATING, std::memory_order_acquire)) {
+                        return &currBucket;
+                    }
+                }
+                else { // Wait for the current owner.
+                    std::this_thread::yield();
+                    state = currBucket.state.load(std::memory_order_acquire);
+                }
+            }
+            if (state == BucketState::MOVED) { // The pair now lives in the next array.
+                break;
+            }
+            // Removed (EAR) in the meantime; keep probing.
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Attaches a larger array to an array, if none is attached yet.
+ *
+ * Threads racing to start the same resize each allocate an array; one CAS succeeds and the others free theirs.
+ *
+ * @param array Array to be resized.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void LockFreeHashTable_t<K, V, Hash, Eq>::startResize(BucketArray& array) {
+    if (array.next.load(std::memory_order_acquire) != nullptr) {
+        return;
+    }
+    const auto grown = static_cast<size_t>(static_cast<double>(array.capacity) * resizeFactor);
+    auto newArray = std::make_unique<BucketArray>(std::bit_ceil(std::max(grown, array.capacity * 2)));
+    if (BucketArray* expected = nullptr;
+        array.next.compare_exchange_strong(expected, newArray.get(), std::memory_order_seq_cst)) {
+        newArray.release(); // Now owned by array.
+    }
+}
+
+/**
+ * @brief Migrates one chunk of an array being resized.
+ *
+ * Chunks are handed out with fetch_add, so any number of threads may help at once.
+ * The thread completing the last chunk makes the next array current.
+ * Does nothing if the array is not being resized or all of its chunks have been handed out.
+ *
+ * @param array Array being resized.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void LockFreeHashTable_t<K, V, Hash, Eq>::helpMigrate(BucketArray& array) {
+    BucketArray* const next = array.next.load(std::memory_order_acquire);
+    if (next == nullptr) {
+        return;
+    }
+    const size_t chunkNum = array.nextChunk.fetch_add(1, std::memory_order_relaxed);
+    if (chunkNum >= array.numChunks()) {
+        return;
+    }
+    const size_t stop = std::min((chunkNum + 1) * CHUNK_SIZE, array.capacity);
+    for (size_t bucketNum = chunkNum * CHUNK_SIZE; bucketNum < stop; ++bucketNum) {
+        migrateBucket(array, array.buckets[bucketNum]);
+    }
+    if (array.chunksDone.fetch_add(1, std::memory_order_acq_rel) + 1 == array.numChunks()) { // Last chunk done.
+        BucketArray* expected = &array;
+        current.compare_exchange_strong(expected, next, std::memory_order_acq_rel);
+    }
+}
+
+/**
+ * @brief Migrates one bucket of an array being resized.
+ *
+ * ESS buckets are marked FROZEN so that no key can be inserted behind the migration; probes stop at them
+ * as they would at ESS, rather than scanning on as they do past MOVED buckets.
+ * NORMAL buckets are taken with a CAS to COPYING, copied into the next array, and then marked MOVED.
+ * Buckets owned by other threads (CLAIMED, UPDATING) are waited for; tombstones are left as they are.
+ * If the next array has filled up or started resizing in the meantime, the pair goes to the array attached to that one.
+ *
+ * @param array Array being resized.
+ * @param bucket Bucket of array to be migrated.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void LockFreeHashTable_t<K, V, Hash, Eq>::migrateBucket(BucketArray& array, Bucket& bucket) {
+    BucketState state = bucket.state.load(std::memory_order_acquire);
+    while (true) {
+        if (state == BucketState::ESS) {
+            if (bucket.state.compare_exchange_weak(state, BucketState::FROZEN, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                return;
+            }
+        }
+        else if (state == BucketState::NORMAL) {
+            if (bucket.state.compare_exchange_weak(state, BucketState::COPYING, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                break;
+            }
+        }
+        else if (state == BucketState::CLAIMED || state == BucketState::UPDATING) { // Wait for the current owner.
+            std::this_thread::yield();
+            state = bucket.state.load(std::memory_order_acquire);
+        }
+        else { // EAR, MOVED, or FROZEN.
+            return;
+        }
+    }
+    const V value = bucket.value.load(std::memory_order_relaxed);
+    BucketArray* target = array.next.load(std::memory_order_acquire);
+    while (claim(*target, bucket.key, bucket.hashValue, value) == ClaimResult::REDIRECT) { // Cannot be a duplicate.
+        startResize(*target);
+        target = target->next.load(std::memory_order_acquire);
+    }
+    bucket.state.store(BucketState::MOVED, std::memory_order_release);
+}
+
+#endif // LOCKFREEHASHTABLE_H
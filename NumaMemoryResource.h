@@ -0,0 +1,184 @@
+#ifndef NUMAMEMORYRESOURCE_H
+#define NUMAMEMORYRESOURCE_H
+
+/*
+ * Greg Rosen
+ * Project 4: HashTable
+ * Declaration and implementation of NumaMemoryResource class
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__linux__) && __has_include(<sys/mman.h>) && __has_include(<sys/syscall.h>)
+#define HASHTABLE_NUMA_MBIND
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @class NumaMemoryResource
+ * @brief Memory resource placing large allocations on a chosen NUMA node.
+ *
+ * Allocations of at least LARGE_ALLOCATION bytes, such as the bucket arrays and key slabs of a table, are mapped
+ * directly with mmap and bound to the node with mbind (preferred policy, so the kernel falls back to other nodes
+ * rather than failing when the node is full). Pages are placed when first touched, so they land on the node
+ * whichever thread fills them. Smaller allocations are passed to an upstream resource.
+ * Without mbind (other platforms, or node -1), every allocation is passed upstream.
+ * A kernel built without NUMA support rejects mbind; the memory is then used wherever the kernel put it.
+ *
+ * @author Greg Rosen
+ * @date November 2, 2025
+ */
+class NumaMemoryResource : public std::pmr::memory_resource {
+public:
+    static constexpr size_t LARGE_ALLOCATION = static_cast<size_t>(1) << 16; // Smallest allocation bound to the node.
+
+private:
+    static constexpr unsigned long MPOL_PREFERRED_MODE = 1; // MPOL_PREFERRED of <numaif.h>, defined here to avoid depending on libnuma.
+    static constexpr size_t MAX_NODE_BITS = 64 * 16; // Number of nodes covered by the node mask passed to mbind.
+
+    const int node; // NUMA node of large allocations, or -1 for none.
+    std::pmr::memory_resource* const upstream; // Resource of small allocations.
+
+    [[nodiscard]] bool bindsAllocation(size_t bytes, size_t alignment) const; // Predicate for if an allocation is mapped and bound to the node.
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override; // Allocates memory, on the node if large.
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override; // Releases memory allocated by do_allocate.
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override; // Predicate for if memory of one resource can be released by another.
+
+public:
+    explicit NumaMemoryResource(int inNode, std::pmr::memory_resource* inUpstream = std::pmr::get_default_resource()); // Parameterized constructor for NumaMemoryResource.
+
+    [[nodiscard]] int numaNode() const; // Getter for the NUMA node of large allocations.
+
+    [[nodiscard]] static std::vector<int> onlineNodes(); // Getter for the NUMA nodes of this machine.
+};
+
+/**
+ * @brief Parameterized constructor for NumaMemoryResource.
+ *
+ * @param inNode NUMA node of large allocations (-1 to pass every allocation upstream)
+ * @param inUpstream resource of small allocations (default resource unless given)
+ */
+inline NumaMemoryResource::NumaMemoryResource(const int inNode, std::pmr::memory_resource* const inUpstream) :
+    node(inNode), upstream(inUpstream) {}
+
+/**
+ * @brief Getter for the NUMA node of large allocations.
+ *
+ * @return node, or -1 if allocations are not bound.
+ */
+inline int NumaMemoryResource::numaNode() const {
+    return node;
+}
+
+/**
+ * @brief Getter for the NUMA nodes of this machine.
+ *
+ * Parses /sys/devices/system/node/online, a list of node numbers and ranges such as "0-1,4".
+ *
+ * @return online nodes in increasing order, or {0} if not available on this platform.
+ */
+inline std::vector<int> NumaMemoryResource::onlineNodes() {
+    std::vector<int> nodes;
+#if defined(HASHTABLE_NUMA_MBIND)
+    std::ifstream online("/sys/devices/system/node/online");
+    std::string range;
+    while (std::getline(online, range, ',')) {
+        const size_t dash = range.find('-');
+        try {
+            const int first = std::stoi(range.substr(0, dash));
+            const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            for (int nodeNum = first; nodeNum <= last; ++nodeNum) {
+                nodes.push_back(nodeNum);
+            }
+        } catch (const std::exception&) {
+            break; // Unreadable list; fall back to node 0.
+        }
+    }
+#endif
+    if (nodes.empty()) {
+        nodes.push_back(0);
+    }
+    return nodes;
+}
+
+/**
+ * @brief Predicate for if an allocation is mapped and bound to the node.
+ *
+ * Depends only on the size and alignment of an allocation, so do_deallocate reaches the same decision as do_allocate.
+ *
+ * @param bytes size of allocation
+ * @param alignment alignment of allocation
+ * @return true if the allocation is mapped with mmap.
+ */
+inline bool NumaMemoryResource::bindsAllocation([[maybe_unused]] const size_t bytes, [[maybe_unused]] const size_t alignment) const {
+#if defined(HASHTABLE_NUMA_MBIND)
+    return node >= 0 && static_cast<size_t>(node) < MAX_NODE_BITS && bytes >= LARGE_ALLOCATION
+        && alignment <= static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Allocates memory, on the node if large.
+ *
+ * @param bytes size of allocation
+ * @param alignment alignment of allocation
+ * @return allocated memory.
+ * @throws std::bad_alloc if memory cannot be mapped.
+ */
+inline void* NumaMemoryResource::do_allocate(const size_t bytes, const size_t alignment) {
+#if defined(HASHTABLE_NUMA_MBIND)
+    if (bindsAllocation(bytes, alignment)) {
+        void* const mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapping == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        unsigned long nodeMask[MAX_NODE_BITS / (8 * sizeof(unsigned long))] = {};
+        nodeMask[static_cast<size_t>(node) / (8 * sizeof(unsigned long))] = 1UL << (static_cast<size_t>(node) % (8 * sizeof(unsigned long)));
+        (void)syscall(SYS_mbind, mapping, bytes, MPOL_PREFERRED_MODE, nodeMask, MAX_NODE_BITS + 1, 0); // Placement is a hint; failure leaves default placement.
+        return mapping;
+    }
+#endif
+    return upstream->allocate(bytes, alignment);
+}
+
+/**
+ * @brief Releases memory allocated by do_allocate.
+ *
+ * @param pointer memory released
+ * @param bytes size of allocation
+ * @param alignment alignment of allocation
+ */
+inline void NumaMemoryResource::do_deallocate(void* const pointer, const size_t bytes, const size_t alignment) {
+#if defined(HASHTABLE_NUMA_MBIND)
+    if (bindsAllocation(bytes, alignment)) {
+        munmap(pointer, bytes);
+        return;
+    }
+#endif
+    upstream->deallocate(pointer, bytes, alignment);
+}
+
+/**
+ * @brief Predicate for if memory of one resource can be released by another.
+ *
+ * @param other resource compared
+ * @return true only for the same resource, since mappings are bound to the node of their resource.
+ */
+inline bool NumaMemoryResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+#endif // NUMAMEMORYRESOURCE_H
@@ -0,0 +1,142 @@
+#ifndef PROBESEQUENCE_H
+#define PROBESEQUENCE_H
+
+/*
+ * Greg Rosen
+ * Project 4: HashTable
+ * Declaration and implementation of the probe sequences used by HashTable
+ */
+
+#include <bit>
+#include <cstddef>
+#include <iterator>
+
+/**
+ * @enum ProbeMode
+ * @brief Collision resolution strategy of HashTable.
+ *
+ * Every mode probes the home bucket first and visits every bucket in the table exactly once.
+ * PSEUDO_RANDOM - Offsets follow a full-period linear congruential generator seeded per table.
+ * LINEAR - Offsets are 0, 1, 2, ...
+ * QUADRATIC - Offsets are the triangular numbers 0, 1, 3, 6, ...
+ * DOUBLE_HASH - Offsets are multiples of an odd step derived from the upper bits of the key's hash.
+ */
+enum class ProbeMode {PSEUDO_RANDOM, LINEAR, QUADRATIC, DOUBLE_HASH};
+
+/**
+ * @enum CapacityPolicy
+ * @brief Rounding applied to the capacity of HashTable.
+ *
+ * POWER_OF_TWO - Capacity is rounded up to a power of two at construction and on every rehash. Buckets are indexed with a bitmask.
+ * EXACT - Capacity is used as given. Home buckets are found with a multiply-shift (fastrange) reduction instead of a modulo.
+ */
+enum class CapacityPolicy {POWER_OF_TWO, EXACT};
+
+/**
+ * @class ProbeSequence
+ * @brief Generator for the offsets probed for a given key.
+ *
+ * Offsets are generated as a permutation of [0, span), where span is the smallest power of two not less than
+ * the table capacity. Offsets not less than the capacity are skipped, so exactly capacity offsets are produced.
+ * The first offset is always 0, guaranteeing that the home bucket is probed first.
+ * Usable directly as a range: for (const size_t offset : ProbeSequence(...)).
+ * Defined inline, as it is stepped once per probe.
+ */
+class ProbeSequence {
+private:
+    size_t length; // Number of offsets to produce (the table capacity).
+    size_t spanMask; // Mask for reducing offsets modulo span.
+    ProbeMode mode; // Collision resolution strategy.
+    size_t multiplier; // LCG multiplier (PSEUDO_RANDOM only).
+    size_t step; // LCG increment (PSEUDO_RANDOM) or stride (DOUBLE_HASH).
+    size_t current; // Current offset.
+    size_t spanIndex; // Position of the current offset within the permutation of [0, span).
+    size_t produced; // Number of offsets produced so far, including the current one.
+
+public:
+    ProbeSequence(size_t inLength, ProbeMode inMode, size_t inMultiplier, size_t inIncrement, size_t hashValue); // Constructor for ProbeSequence.
+
+    [[nodiscard]] ProbeSequence begin() const; // Start of range (a copy of the sequence).
+    [[nodiscard]] std::default_sentinel_t end() const; // End of range.
+
+    [[nodiscard]] size_t operator*() const; // Current offset.
+    ProbeSequence& operator++(); // Advances to the next offset.
+    [[nodiscard]] bool operator==(std::default_sentinel_t) const; // Predicate for if every offset has been produced.
+};
+
+/**
+ * @brief Constructor for ProbeSequence.
+ *
+ * The stride for double hashing is taken from the upper half of the hash so that it
+ * is independent of the home location, and is forced odd so that it is coprime with the span.
+ *
+ * @param inLength Number of offsets to produce (the table capacity).
+ * @param inMode Collision resolution strategy.
+ * @param inMultiplier LCG multiplier for pseudo-random probing.
+ * @param inIncrement LCG increment for pseudo-random probing.
+ * @param hashValue Full hash of the key being probed.
+ */
+inline ProbeSequence::ProbeSequence(const size_t inLength, const ProbeMode inMode, const size_t inMultiplier,
+    const size_t inIncrement, const size_t hashValue) :
+    length(inLength), spanMask(std::bit_ceil(inLength) - 1), mode(inMode), multiplier(inMultiplier),
+    step(inMode == ProbeMode::DOUBLE_HASH ? (hashValue >> 32) | 1 : inIncrement), current(0), spanIndex(0), produced(1) {}
+
+/**
+ * @brief Start of range (a copy of the sequence).
+ *
+ * @return copy of the sequence at its current offset.
+ */
+inline ProbeSequence ProbeSequence::begin() const {
+    return *this;
+}
+
+/**
+ * @brief End of range.
+ *
+ * @return sentinel compared against by operator==.
+ */
+inline std::default_sentinel_t ProbeSequence::end() const {
+    return std::default_sentinel;
+}
+
+/**
+ * @brief Current offset.
+ *
+ * @return offset from the home location of the bucket to be probed.
+ */
+inline size_t ProbeSequence::operator*() const {
+    return current;
+}
+
+/**
+ * @brief Advances to the next offset.
+ *
+ * Each mode steps through a permutation of [0, span). Steps landing on offsets not less than the
+ * table capacity are repeated (cycle walking), which never happens when the capacity is a power of two.
+ *
+ * @return reference to this sequence.
+ */
+inline ProbeSequence& ProbeSequence::operator++() {
+    if (++produced > length) {return *this;}
+    do {
+        ++spanIndex;
+        switch (mode) {
+            case ProbeMode::PSEUDO_RANDOM: current = (multiplier * current + step) & spanMask; break;
+            case ProbeMode::LINEAR: current = (current + 1) & spanMask; break;
+            case ProbeMode::QUADRATIC: current = (current + spanIndex) & spanMask; break;
+            case ProbeMode::DOUBLE_HASH: current = (current + step) & spanMask; break;
+        }
+    } while (current >= length);
+    return *this;
+}
+
+/**
+ * @brief Predicate for if every offset has been produced.
+ *
+ * @return true if the sequence is exhausted, false otherwise.
+ */
+inline bool ProbeSequence::operator==(std::default_sentinel_t) const {
+    return produced > length;
+}
+
+#endif // PROBESEQUENCE_H
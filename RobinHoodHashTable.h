@@ -0,0 +1,567 @@
+#ifndef ROBINHOODHASHTABLE_H
+#define ROBINHOODHASHTABLE_H
+
+/*
+ * Greg Rosen
+ * Project 4: HashTable
+ * Declaration and implementation of RobinHoodHashTable_t class template
+ */
+
+#include "HashTableImpl.h"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @class RobinHoodHashTable_t
+ * @brief HashTable for <K, V> key-value pairs using Robin Hood hashing with backward-shift deletion.
+ *
+ * Open addressing with linear probing over a power-of-two bucket array, so every probe after the first reads
+ * the bucket next to the one before it. Inserting keys displace keys closer to their home bucket than themselves
+ * ("take from the rich"), which keeps the keys of a probe run sorted by displacement: a search stops as soon as
+ * it reaches a bucket whose key is closer to home than the key searched for would be, so unsuccessful lookups
+ * are about as short as successful ones.
+ * Removal shifts the following keys of the run back by one bucket instead of leaving a tombstone, so the table never
+ * holds tombstones and never needs compacting.
+ * The displacement of every bucket (plus one, or 0 if empty) is kept in a dense byte array apart from the buckets,
+ * which also cache the mixed hash of their key (see hashOf); keys are only compared on buckets whose displacement and hash match.
+ * Displacements are bounded by MAX_DISPLACEMENT; an insertion that would exceed it grows the table instead.
+ * Offers the core interface of HashTable_t, including insertTCT and removeTCT, so the engines can be compared directly.
+ *
+ * @warning ArenaString keys are not supported. A hash function giving more than MAX_DISPLACEMENT keys the same hash
+ * makes insertion grow the table without bound.
+ *
+ * @author Greg Rosen
+ * @date November 2, 2025
+ */
+template<typename K, typename V, typename Hash = DefaultHash<K>, typename Eq = DefaultKeyEqual<K>>
+class RobinHoodHashTable_t {
+    static_assert(!KeyTraits<K>::arenaStorage, "RobinHoodHashTable_t keeps no key arena");
+
+public:
+    using KeyArg = typename KeyTraits<K>::lookup_type; // Parameter type accepted by lookups.
+
+private:
+    /**
+     * @struct Bucket
+     * @brief Bucket for RobinHoodHashTable
+     *
+     * Whether the bucket is filled, and how far it is from its home bucket, is kept in the displacement array of the table.
+     */
+    struct Bucket {
+        K key{}; // Key for hash table entry.
+        V value{}; // Value for hash table entry.
+        size_t hashValue = 0; // Mixed hash of key (see hashOf).
+    };
+
+    /**
+     * @struct InsertSlot
+     * @brief Outcome of probing for a key that is about to be inserted.
+     */
+    struct InsertSlot {
+        size_t found; // Index of bucket already holding the key, or NOT_FOUND.
+        size_t index; // Index of the bucket the key would be stored in.
+        size_t distance; // Displacement of that bucket from the key's home bucket, plus one.
+        size_t probes; // Number of buckets examined.
+    };
+
+    static constexpr uint8_t EMPTY = 0; // Displacement byte of an empty bucket.
+    static constexpr size_t MAX_DISPLACEMENT = 254; // Largest displacement stored (plus one, it fits in a byte).
+    static constexpr size_t NOT_FOUND = std::numeric_limits<size_t>::max(); // Index returned by find for missing keys.
+
+    const double threshold; // The load factor threshold for rehashing (default 0.5).
+    const double resizeFactor; // The factor by which the capacity of the hash table will be increased upon rehashing (default 2.0).
+    std::vector<uint8_t> displacements; // Displacement from its home bucket, plus one, of every bucket (EMPTY if empty).
+    std::vector<Bucket> tableData; // The hash table itself, implemented as a vector of Bucket elements.
+    size_t indexMask; // capacity - 1, for bucket indexing.
+    size_t numFilled; // The number of filled buckets in the hash table.
+    [[no_unique_address]] Hash hash; // Using () overload, provides hash function size_t hash(KeyArg)
+    [[no_unique_address]] Eq equal; // Using () overload, provides key equality predicate bool equal(K, KeyArg)
+    V badKeyDrain; // Dummy variable for capturing invalid uses of subscript operator.
+
+    void rehash(); // Rehashes the table, increasing its size.
+    void rehash(size_t newCapacity); // Rehashes the table to a given capacity.
+    [[nodiscard]] InsertSlot probeForInsert(KeyArg key, size_t hashValue) const; // Finds a key, or the bucket it would be inserted into.
+    size_t place(Bucket carried, size_t index, size_t distance); // Stores a key-value pair, displacing keys closer to home.
+    size_t vacateBucket(size_t index); // Empties a filled bucket, shifting the rest of its run back.
+    [[nodiscard]] size_t find(KeyArg key, size_t hashValue) const; // Find index of bucket containing key.
+    [[nodiscard]] size_t hashOf(KeyArg key) const; // Mixed hash of a key, from which its home bucket is taken.
+    [[nodiscard]] size_t homeIndex(size_t hashValue) const; // Home bucket for a key with given hash.
+    [[nodiscard]] size_t nextIndex(size_t index) const; // Index of the bucket after a given one.
+
+public:
+    explicit RobinHoodHashTable_t(size_t initCapacity = 8, double inThreshold = 0.5, double inResizeFactor = 2.0); // Default and parameterized constructor for Robin Hood hash table.
+
+    V& operator[](KeyArg key); // Subscript operator overload for Robin Hood hash table.
+
+    [[nodiscard]] size_t capacity() const; // Getter for capacity of the Robin Hood hash table.
+    [[nodiscard]] size_t size() const; // Getter for size of the Robin Hood hash table.
+    [[nodiscard]] double alpha() const; // Getter for the load factor of the Robin Hood hash table.
+    [[nodiscard]] size_t tombstones() const; // Getter for number of tombstones in the Robin Hood hash table (always 0).
+    [[nodiscard]] std::vector<K> keys() const; // Getter for a list of keys currently used in the Robin Hood hash table.
+    [[nodiscard]] std::optional<V> get(KeyArg key) const; // Getter for value stored using a given key.
+
+    [[nodiscard]] bool contains(KeyArg key) const; // Predicate for if a given key is stored in table.
+
+    bool insert(const K& key, const V& value); // Insert key-value pair into table.
+    bool insert_or_assign(const K& key, const V& value); // Insert key-value pair, or assign value if key is present.
+    void reserve(size_t expectedElements); // Reserves capacity for a number of key-value pairs.
+    bool remove(KeyArg key); // Remove key-value pair from table.
+
+    size_t insertTCT(const K& key, const V& value); // Time-complexity testing version of insert.
+    size_t removeTCT(KeyArg key); // Time-complexity testing version of remove.
+
+    /**
+     * @brief Stream insertion operator overload for RobinHoodHashTable.
+     *
+     * Outputs the filled buckets in the table bucket-by-bucket on separate lines, as "Bucket n: <key, value>".
+     *
+     * @param os output stream
+     * @param hashTable hash table to be output
+     * @return output stream with hash table output added
+     */
+    friend std::ostream& operator<<(std::ostream& os, const RobinHoodHashTable_t& hashTable) {
+        for (size_t bucketNum = 0; bucketNum < hashTable.capacity(); ++bucketNum) {
+            if (slotAt(hashTable.displacements, bucketNum) != EMPTY) {
+                const Bucket& bucket = slotAt(hashTable.tableData, bucketNum);
+                os << "Bucket " << bucketNum << ": <" << bucket.key << ", " << bucket.value << ">" << std::endl;
+            }
+        }
+        return os;
+    }
+};
+
+/**
+ * @brief RobinHoodHashTable for <string, unsigned long> key-value pairs
+ *
+ * The RobinHoodHashTable_t class template instantiated for string keys and unsigned long (size_t) values.
+ */
+using RobinHoodHashTable = RobinHoodHashTable_t<std::string, size_t>;
+
+/**
+ * @brief Default and parameterized constructor for Robin Hood hash table.
+ *
+ * Creates a hash table with given number of initial empty buckets (default 8), rounded up to the next power of two.
+ *
+ * @param initCapacity Initial number of empty buckets in hash table.
+ * @param inThreshold The load factor threshold for rehashing (default 0.5).
+ * @param inResizeFactor The factor by which the capacity of the hash table will be increased upon rehashing (default 2.0).
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+RobinHoodHashTable_t<K, V, Hash, Eq>::RobinHoodHashTable_t(const size_t initCapacity, const double inThreshold, const double inResizeFactor) :
+    threshold(inThreshold), resizeFactor(inResizeFactor), displacements(std::bit_ceil(std::max(initCapacity, static_cast<size_t>(1))), EMPTY),
+    tableData(displacements.size()), indexMask(displacements.size() - 1), numFilled(0), hash(makeHash<Hash>()), equal(), badKeyDrain() {}
+
+/**
+ * @brief Subscript operator overload for Robin Hood hash table.
+ *
+ * Returns a reference to the value associated with key, like HashTable::operator[].
+ *
+ * @warning If the key is not in the table, the returned reference points to a dummy value field of the table.
+ *
+ * @param key Key to be searched.
+ * @return Reference to value associated with key.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+V& RobinHoodHashTable_t<K, V, Hash, Eq>::operator[](const KeyArg key) {
+    if (const size_t index = find(key, hashOf(key)); index != NOT_FOUND) {
+        return slotAt(tableData, index).value;
+    }
+    return badKeyDrain;
+}
+
+/**
+ * @brief Getter for capacity of the Robin Hood hash table.
+ *
+ * @return capacity of hash table (number of buckets).
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t RobinHoodHashTable_t<K, V, Hash, Eq>::capacity() const {
+    return tableData.size();
+}
+
+/**
+ * @brief Getter for size of the Robin Hood hash table.
+ *
+ * @return number of filled buckets.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t RobinHoodHashTable_t<K, V, Hash, Eq>::size() const {
+    return numFilled;
+}
+
+/**
+ * @brief Getter for the load factor of the Robin Hood hash table.
+ *
+ * @return ratio of size to capacity.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+double RobinHoodHashTable_t<K, V, Hash, Eq>::alpha() const {
+    return static_cast<double>(size())/static_cast<double>(capacity());
+}
+
+/**
+ * @brief Getter for number of tombstones in the Robin Hood hash table.
+ *
+ * Removal shifts keys back instead of leaving tombstones, so there are never any.
+ *
+ * @return 0.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t RobinHoodHashTable_t<K, V, Hash, Eq>::tombstones() const {
+    return 0;
+}
+
+/**
+ * @brief Getter for a list of keys currently used in the Robin Hood hash table.
+ *
+ * @return vector of keys present in the table, in bucket order.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+std::vector<K> RobinHoodHashTable_t<K, V, Hash, Eq>::keys() const {
+    std::vector<K> keyList;
+    keyList.reserve(numFilled);
+    for (size_t bucketNum = 0; bucketNum < capacity(); ++bucketNum) {
+        if (slotAt(displacements, bucketNum) != EMPTY) {
+            keyList.push_back(slotAt(tableData, bucketNum).key);
+        }
+    }
+    return keyList;
+}
+
+/**
+ * @brief Getter for value stored using a given key.
+ *
+ * @param key Key to be searched.
+ * @return value associated with key or nullopt.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+std::optional<V> RobinHoodHashTable_t<K, V, Hash, Eq>::get(const KeyArg key) const {
+    if (const size_t index = find(key, hashOf(key)); index != NOT_FOUND) {
+        return slotAt(tableData, index).value;
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Predicate for if a given key is stored in table.
+ *
+ * @param key Key to be searched.
+ * @return true if key found, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool RobinHoodHashTable_t<K, V, Hash, Eq>::contains(const KeyArg key) const {
+    return find(key, hashOf(key)) != NOT_FOUND;
+}
+
+/**
+ * @brief Insert key-value pair into table.
+ *
+ * A single probe finds either the key or the bucket it belongs in, where it displaces the rest of the run.
+ * Returns false if the key is already present in the hash table.
+ * If the insertion raises the load factor of the hash table to or above the threshold (default 0.5), the table is rehashed.
+ *
+ * @param key of key-value pair to be inserted.
+ * @param value Value of key-value pair to be inserted.
+ *
+ * @return true if insertion successful, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool RobinHoodHashTable_t<K, V, Hash, Eq>::insert(const K& key, const V& value) {
+    const size_t hashValue = hashOf(key);
+    const InsertSlot slot = probeForInsert(key, hashValue);
+    if (slot.found != NOT_FOUND) {
+        return false;
+    }
+    place(Bucket{key, value, hashValue}, slot.index, slot.distance);
+    if (alpha() >= threshold) { // Rehash if necessary.
+        rehash();
+    }
+    return true;
+}
+
+/**
+ * @brief Insert key-value pair, or assign value if key is present.
+ *
+ * @param key of key-value pair to be inserted or assigned.
+ * @param value Value to be stored.
+ *
+ * @return true if key was inserted, false if an existing value was assigned.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool RobinHoodHashTable_t<K, V, Hash, Eq>::insert_or_assign(const K& key, const V& value) {
+    const size_t hashValue = hashOf(key);
+    if (const InsertSlot slot = probeForInsert(key, hashValue); slot.found != NOT_FOUND) {
+        slotAt(tableData, slot.found).value = value;
+        return false;
+    }
+    else {
+        place(Bucket{key, value, hashValue}, slot.index, slot.distance);
+    }
+    if (alpha() >= threshold) { // Rehash if necessary.
+        rehash();
+    }
+    return true;
+}
+
+/**
+ * @brief Reserves capacity for a number of key-value pairs.
+ *
+ * Rehashes at once if necessary, so that expectedElements key-value pairs can be inserted without any further rehash.
+ *
+ * @param expectedElements number of key-value pairs to be held.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void RobinHoodHashTable_t<K, V, Hash, Eq>::reserve(const size_t expectedElements) {
+    const auto required = static_cast<size_t>(static_cast<double>(expectedElements) / threshold) + 1;
+    if (required > capacity()) {
+        rehash(required);
+    }
+}
+
+/**
+ * @brief Remove key-value pair from table.
+ *
+ * The keys following the removed one in its run are shifted back by one bucket, up to the first key
+ * already in its home bucket (or an empty bucket), so no tombstone is left.
+ *
+ * @param key Key to be searched.
+ * @return true if removal successful, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool RobinHoodHashTable_t<K, V, Hash, Eq>::remove(const KeyArg key) {
+    const size_t index = find(key, hashOf(key));
+    if (index == NOT_FOUND) {
+        return false; // key is not present in table
+    }
+    vacateBucket(index);
+    return true;
+}
+
+/**
+ * @brief Time-complexity testing version of insert.
+ *
+ * Like insert, but returns number of probes required to either insert key-value pair or determine key is a duplicate:
+ * the buckets examined while searching, plus those whose keys are displaced up to the empty bucket ending the run.
+ * Also omits check for rehashing, although an insertion exceeding MAX_DISPLACEMENT still grows the table.
+ *
+ * @param key of key-value pair to be inserted.
+ * @param value Value of key-value pair to be inserted.
+ *
+ * @return number of probes required for insertion.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t RobinHoodHashTable_t<K, V, Hash, Eq>::insertTCT(const K& key, const V& value) {
+    const size_t hashValue = hashOf(key);
+    const InsertSlot slot = probeForInsert(key, hashValue);
+    if (slot.found != NOT_FOUND) {
+        return slot.probes;
+    }
+    return slot.probes - 1 + place(Bucket{key, value, hashValue}, slot.index, slot.distance);
+}
+
+/**
+ * @brief Time-complexity testing version of remove.
+ *
+ * Like remove, but returns number of probes required to either remove key-value pair or determine key is not in the table:
+ * the buckets examined while searching, plus those examined while shifting the rest of the run back.
+ *
+ * @param key Key to be searched.
+ * @return number of probes required for removal.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t RobinHoodHashTable_t<K, V, Hash, Eq>::removeTCT(const KeyArg key) {
+    const size_t hashValue = hashOf(key);
+    const InsertSlot slot = probeForInsert(key, hashValue);
+    if (slot.found == NOT_FOUND) {
+        return slot.probes;
+    }
+    return slot.probes + vacateBucket(slot.found);
+}
+
+/**
+ * @brief Rehashes the table, increasing its size.
+ *
+ * Capacity grows by resizeFactor, rounded up to the next power of two.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void RobinHoodHashTable_t<K, V, Hash, Eq>::rehash() {
+    // Capacity must grow by at least one bucket.
+    rehash(std::max(static_cast<size_t>(static_cast<double>(capacity()) * resizeFactor), capacity() + 1));
+}
+
+/**
+ * @brief Rehashes the table to a given capacity.
+ *
+ * Moves every key-value pair into new bucket arrays of at least newCapacity buckets (rounded up to a power of two),
+ * reusing the cached hash of each key. Should an insertion into the new arrays exceed MAX_DISPLACEMENT, they grow
+ * again in turn; the old arrays are held here until every pair has been moved.
+ *
+ * @param newCapacity minimum number of buckets of the rehashed table.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void RobinHoodHashTable_t<K, V, Hash, Eq>::rehash(const size_t newCapacity) {
+    const size_t roundedCapacity = std::bit_ceil(std::max(newCapacity, numFilled + 1));
+    std::vector<uint8_t> oldDisplacements = std::exchange(displacements, std::vector<uint8_t>(roundedCapacity, EMPTY));
+    std::vector<Bucket> oldData = std::exchange(tableData, std::vector<Bucket>(roundedCapacity));
+    indexMask = tableData.size() - 1;
+    numFilled = 0;
+    for (size_t bucketNum = 0; bucketNum < oldData.size(); ++bucketNum) {
+        if (slotAt(oldDisplacements, bucketNum) != EMPTY) {
+            Bucket& currBucket = slotAt(oldData, bucketNum);
+            // Keys in the old arrays are distinct, so the probe only locates the insertion point.
+            size_t index = homeIndex(currBucket.hashValue);
+            size_t distance = 1;
+            while (slotAt(displacements, index) >= distance) {
+                index = nextIndex(index);
+                ++distance;
+            }
+            place(std::move(currBucket), index, distance);
+        }
+    }
+}
+
+/**
+ * @brief Finds a key, or the bucket it would be inserted into.
+ *
+ * Probes buckets in order from the home bucket of the key until it finds the key, an empty bucket,
+ * or a bucket whose key is closer to its own home than the searched key would be (in which case the key is absent,
+ * and would be stored there).
+ *
+ * @param key Key to be searched.
+ * @param hashValue Mixed hash of key.
+ * @return index of the key's bucket if found; otherwise, the insertion point. Always the number of buckets examined.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+typename RobinHoodHashTable_t<K, V, Hash, Eq>::InsertSlot RobinHoodHashTable_t<K, V, Hash, Eq>::probeForInsert(const KeyArg key, const size_t hashValue) const {
+    size_t index = homeIndex(hashValue);
+    for (size_t distance = 1; ; ++distance, index = nextIndex(index)) {
+        const uint8_t currDisplacement = slotAt(displacements, index);
+        if (currDisplacement < distance) { // Empty, or richer than the key: the key would have displaced it.
+            return {NOT_FOUND, index, distance, distance};
+        }
+        if (currDisplacement == distance && slotAt(tableData, index).hashValue == hashValue && equal(slotAt(tableData, index).key, key)) {
+            return {index, index, distance, distance};
+        }
+    }
+}
+
+/**
+ * @brief Stores a key-value pair, displacing keys closer to home.
+ *
+ * Fills the bucket at index with carried; the key previously there, if any, is carried on to the next bucket
+ * that it can take from a richer key, and so on until an empty bucket is filled.
+ * If a displacement would exceed MAX_DISPLACEMENT, or the table is full, the table grows and the pair being carried is inserted into the new arrays.
+ *
+ * @param carried key-value pair to be stored, whose key is not in the table.
+ * @param index bucket to be filled, found by probing.
+ * @param distance displacement of that bucket from the key's home, plus one.
+ * @return number of buckets examined, including the one filled.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t RobinHoodHashTable_t<K, V, Hash, Eq>::place(Bucket carried, size_t index, size_t distance) {
+    for (size_t probes = 1; ; ++probes) {
+        if (distance > MAX_DISPLACEMENT || numFilled == capacity()) { // The run is too long, or never ends; spread it over a larger table.
+            rehash();
+            const InsertSlot slot = probeForInsert(carried.key, carried.hashValue);
+            return probes + place(std::move(carried), slot.index, slot.distance);
+        }
+        uint8_t& currDisplacement = slotAt(displacements, index);
+        if (currDisplacement == EMPTY) {
+            currDisplacement = static_cast<uint8_t>(distance);
+            slotAt(tableData, index) = std::move(carried);
+            ++numFilled;
+            return probes;
+        }
+        if (currDisplacement < distance) { // Take the bucket from the richer key, and carry it on instead.
+            std::swap(slotAt(tableData, index), carried);
+            const size_t carriedDistance = currDisplacement;
+            currDisplacement = static_cast<uint8_t>(distance);
+            distance = carriedDistance;
+        }
+        index = nextIndex(index);
+        ++distance;
+    }
+}
+
+/**
+ * @brief Empties a filled bucket, shifting the rest of its run back.
+ *
+ * Every following key that is not in its home bucket moves back one bucket, up to the first empty bucket
+ * or key in its home bucket. The bucket finally emptied is reset, releasing any storage owned by its key.
+ *
+ * @param index bucket to be emptied.
+ * @return number of buckets examined after the removed one.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t RobinHoodHashTable_t<K, V, Hash, Eq>::vacateBucket(size_t index) {
+    size_t probes = 1;
+    for (size_t next = nextIndex(index); slotAt(displacements, next) > 1; index = next, next = nextIndex(next), ++probes) {
+        slotAt(tableData, index) = std::move(slotAt(tableData, next));
+        slotAt(displacements, index) = static_cast<uint8_t>(slotAt(displacements, next) - 1);
+    }
+    slotAt(displacements, index) = EMPTY;
+    slotAt(tableData, index) = Bucket();
+    --numFilled;
+    return probes;
+}
+
+/**
+ * @brief Find index of bucket containing key.
+ *
+ * @param key Key to be searched.
+ * @param hashValue Mixed hash of key.
+ * @return Index of bucket holding key, or NOT_FOUND.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t RobinHoodHashTable_t<K, V, Hash, Eq>::find(const KeyArg key, const size_t hashValue) const {
+    return probeForInsert(key, hashValue).found;
+}
+
+/**
+ * @brief Mixed hash of a key, from which its home bucket is taken.
+ *
+ * Computed once per operation and cached in the key's bucket. Mixing spreads keys with weak hashes
+ * (such as integers under std::hash, whose hash is the key) over the whole table, as in HashTable_t::hashOf.
+ *
+ * @param key Key to be hashed.
+ * @return mixHash of the hash of key.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+HASHTABLE_INLINE size_t RobinHoodHashTable_t<K, V, Hash, Eq>::hashOf(const KeyArg key) const {
+    return static_cast<size_t>(mixHash(static_cast<uint64_t>(hash(key))));
+}
+
+/**
+ * @brief Home bucket for a key with given hash.
+ *
+ * The mixed hash is mapped onto the table by its high bits (fastrange).
+ *
+ * @param hashValue Mixed hash of key.
+ * @return index of the home bucket of the key.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+HASHTABLE_INLINE size_t RobinHoodHashTable_t<K, V, Hash, Eq>::homeIndex(const size_t hashValue) const {
+    return static_cast<size_t>(mulhi64(hashValue, capacity()));
+}
+
+/**
+ * @brief Index of the bucket after a given one.
+ *
+ * @param index index of bucket
+ * @return index of the following bucket, wrapping around at the end of the table.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+HASHTABLE_INLINE size_t RobinHoodHashTable_t<K, V, Hash, Eq>::nextIndex(const size_t index) const {
+    return (index + 1) & indexMask;
+}
+
+#endif // ROBINHOODHASHTABLE_H
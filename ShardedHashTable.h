@@ -0,0 +1,532 @@
+#ifndef SHARDEDHASHTABLE_H
+#define SHARDEDHASHTABLE_H
+
+/*
+ * Greg Rosen
+ * Project 4: HashTable
+ * Declaration and implementation of ShardedHashTable_t class template
+ */
+
+#include "HashTableImpl.h"
+#include "NumaMemoryResource.h"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @class ShardedHashTable_t
+ * @brief HashTable for <K, V> key-value pairs, split into independent shards.
+ *
+ * The table is split into a power-of-two number of shards, each a HashTable_t with its own bucket arrays.
+ * Keys are routed to shards by their hash, so each shard holds about 1/N of the pairs
+ * and grows, shrinks, and compacts on its own: a rehash moves only the pairs of one shard.
+ * Every shard shares one hash function, so a key is hashed once, and the shard's table is given that hash.
+ * Optionally, shards are pinned to the NUMA nodes of the machine in turn: every shard allocates its buckets
+ * and keys from a NumaMemoryResource bound to its node (see shardNode), so threads working on a shard can be
+ * run on the same node.
+ *
+ * The table is not locked (see ConcurrentHashTable_t for that). Shards share no state, however, so different threads
+ * may modify different shards at once, through shard(), as parallel_for_each does; the routing of keys never changes.
+ * Aggregate queries (size, capacity, alpha, stats, keys) combine every shard.
+ *
+ * @author Greg Rosen
+ * @date November 2, 2025
+ */
+template<typename K, typename V, typename Hash = DefaultHash<K>, typename Eq = DefaultKeyEqual<K>>
+class ShardedHashTable_t {
+public:
+    using Table = HashTable_t<K, V, Hash, Eq>; // Table type of each shard.
+    using ProbeMode = typename Table::ProbeMode; // Collision resolution strategy, see ProbeSequence.h.
+    using CapacityPolicy = typename Table::CapacityPolicy; // Capacity rounding, see ProbeSequence.h.
+    using KeyArg = typename Table::KeyArg; // Parameter type accepted by lookups.
+
+private:
+    /**
+     * @struct Shard
+     * @brief One shard: a table and the memory resource it allocates from.
+     *
+     * The resource is declared first, so it outlives the table's allocations.
+     */
+    struct Shard {
+        NumaMemoryResource resource; // Resource of the table, bound to the shard's NUMA node if pinned.
+        Table table; // Key-value pairs routed to this shard.
+
+        Shard(int inNode, size_t initCapacity, double inThreshold, double inResizeFactor, ProbeMode inProbeMode,
+            CapacityPolicy inCapacityPolicy, double inTombstoneThreshold, double inShrinkThreshold, size_t inMigrationStep,
+            size_t inRehashThreads, const Hash& inHash); // Parameterized constructor for Shard.
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards; // The shards, indexed by bits of the mixed hash of a key.
+    const unsigned shardBits; // log2 of the number of shards.
+
+    [[nodiscard]] size_t hashOf(KeyArg key) const; // Mixed hash of a key, as computed by every shard.
+    [[nodiscard]] size_t shardOf(size_t hashValue) const; // Index of the shard responsible for a key with a given hash.
+    [[nodiscard]] Table& tableFor(size_t hashValue); // Table of the shard responsible for a key with a given hash.
+    [[nodiscard]] const Table& tableFor(size_t hashValue) const; // Table of the shard responsible for a key with a given hash.
+
+public:
+    explicit ShardedHashTable_t(size_t initCapacity = 8, size_t inNumShards = 16, double inThreshold = 0.5, double inResizeFactor = 2.0,
+        ProbeMode inProbeMode = ProbeMode::PSEUDO_RANDOM, CapacityPolicy inCapacityPolicy = CapacityPolicy::POWER_OF_TWO,
+        bool inPinShards = false, double inTombstoneThreshold = 0.25, double inShrinkThreshold = 0.0, size_t inMigrationStep = 0,
+        size_t inRehashThreads = 1); // Default and parameterized constructor for sharded hash table.
+
+    V& operator[](KeyArg key); // Subscript operator overload for sharded hash table.
+
+    [[nodiscard]] size_t shardCount() const; // Getter for number of shards.
+    [[nodiscard]] size_t shardIndex(KeyArg key) const; // Getter for the index of the shard responsible for a key.
+    [[nodiscard]] Table& shard(size_t shardNum); // Getter for the table of a shard.
+    [[nodiscard]] const Table& shard(size_t shardNum) const; // Getter for the table of a shard.
+    [[nodiscard]] int shardNode(size_t shardNum) const; // Getter for the NUMA node a shard is pinned to.
+    [[nodiscard]] size_t capacity() const; // Getter for total capacity of the shards.
+    [[nodiscard]] size_t size() const; // Getter for total size of the shards.
+    [[nodiscard]] double alpha() const; // Getter for the overall load factor.
+    [[nodiscard]] HashTableStats stats() const; // Getter for the combined statistics of the shards.
+    [[nodiscard]] std::vector<K> keys() const; // Getter for a list of keys currently used in the table.
+    template<typename Function>
+    void for_each(Function function); // Calls a function with the key and value of every key-value pair.
+    template<typename Function>
+    void for_each(Function function) const; // Calls a function with the key and value of every key-value pair, without modifying them.
+    template<typename Function>
+    void parallel_for_each(Function function, size_t numThreads = 0); // Calls a function with every key-value pair, from one thread per shard.
+    [[nodiscard]] std::optional<V> get(KeyArg key) const; // Getter for value stored using a given key.
+
+    [[nodiscard]] bool contains(KeyArg key) const; // Predicate for if a given key is stored in table.
+
+    bool insert(const K& key, const V& value); // Insert key-value pair into table.
+    bool insert_or_assign(const K& key, const V& value); // Insert key-value pair, or assign value if key is present.
+    void reserve(size_t expectedElements); // Reserves capacity for a number of key-value pairs.
+    bool remove(KeyArg key); // Remove key-value pair from table.
+    void compact(); // Rehashes every shard at its current capacity, clearing all tombstones.
+    void shrink_to_fit(); // Rehashes every shard to the smallest capacity that holds its key-value pairs.
+};
+
+/**
+ * @brief ShardedHashTable for <string, unsigned long> key-value pairs
+ *
+ * The ShardedHashTable_t class template instantiated for string keys and unsigned long (size_t) values,
+ * with one HashTable per shard.
+ */
+using ShardedHashTable = ShardedHashTable_t<std::string, size_t>;
+
+/**
+ * @brief Parameterized constructor for Shard.
+ *
+ * @param inNode NUMA node of the shard's allocations (-1 for no pinning).
+ * @param initCapacity Initial number of empty buckets in the shard's table.
+ * @param inThreshold The load factor threshold for rehashing.
+ * @param inResizeFactor The factor by which the capacity of the shard's table will be increased upon rehashing.
+ * @param inProbeMode The collision resolution strategy.
+ * @param inCapacityPolicy The rounding applied to the capacity.
+ * @param inTombstoneThreshold The fraction of tombstones that triggers compaction of the shard's table.
+ * @param inShrinkThreshold The load factor below which the shard's table shrinks after a removal.
+ * @param inMigrationStep The number of buckets migrated per operation during an incremental rehash (0 rehashes at once).
+ * @param inRehashThreads The number of threads rehashing the shard's table.
+ * @param inHash The hash function shared by every shard.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+ShardedHashTable_t<K, V, Hash, Eq>::Shard::Shard(const int inNode, const size_t initCapacity, const double inThreshold, const double inResizeFactor,
+    const ProbeMode inProbeMode, const CapacityPolicy inCapacityPolicy, const double inTombstoneThreshold, const double inShrinkThreshold,
+    const size_t inMigrationStep, const size_t inRehashThreads, const Hash& inHash) :
+    resource(inNode), table(initCapacity, inThreshold, inResizeFactor, inProbeMode, inCapacityPolicy, inTombstoneThreshold, inShrinkThreshold,
+        inMigrationStep, inRehashThreads, &resource, inHash) {}
+
+/**
+ * @brief Default and parameterized constructor for sharded hash table.
+ *
+ * Creates inNumShards shards (rounded up to a power of two), sharing initCapacity buckets and one hash function between them.
+ * The remaining parameters are passed to the table of every shard.
+ *
+ * @param initCapacity Initial total number of empty buckets (default 8).
+ * @param inNumShards Number of shards (default 16).
+ * @param inThreshold The load factor threshold for rehashing a shard (default 0.5).
+ * @param inResizeFactor The factor by which the capacity of a shard will be increased upon rehashing (default 2.0).
+ * @param inProbeMode The collision resolution strategy (default PSEUDO_RANDOM).
+ * @param inCapacityPolicy The rounding applied to the capacity of each shard (default POWER_OF_TWO).
+ * @param inPinShards Whether shards are pinned to the NUMA nodes of the machine in turn (default false).
+ * @param inTombstoneThreshold The fraction of tombstones that triggers compaction of a shard (default 0.25).
+ * @param inShrinkThreshold The load factor below which a shard shrinks after a removal (default 0.0, never shrink).
+ * @param inMigrationStep The number of buckets a shard migrates per operation during an incremental rehash (default 0, rehash at once).
+ * @param inRehashThreads The number of threads rehashing each shard (default 1).
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+ShardedHashTable_t<K, V, Hash, Eq>::ShardedHashTable_t(const size_t initCapacity, const size_t inNumShards, const double inThreshold,
+    const double inResizeFactor, const ProbeMode inProbeMode, const CapacityPolicy inCapacityPolicy, const bool inPinShards,
+    const double inTombstoneThreshold, const double inShrinkThreshold, const size_t inMigrationStep, const size_t inRehashThreads) :
+    shards(), shardBits(static_cast<unsigned>(std::countr_zero(std::bit_ceil(std::max(inNumShards, static_cast<size_t>(1)))))) {
+    const size_t numShards = static_cast<size_t>(1) << shardBits;
+    const size_t shardCapacity = (initCapacity + numShards - 1) / numShards;
+    const std::vector<int> nodes = inPinShards ? NumaMemoryResource::onlineNodes() : std::vector<int>{-1};
+    const Hash sharedHash = makeHash<Hash>();
+    shards.reserve(numShards);
+    for (size_t shardNum = 0; shardNum < numShards; ++shardNum) {
+        shards.push_back(std::make_unique<Shard>(nodes[shardNum % nodes.size()], shardCapacity, inThreshold, inResizeFactor,
+            inProbeMode, inCapacityPolicy, inTombstoneThreshold, inShrinkThreshold, inMigrationStep, inRehashThreads, sharedHash));
+    }
+}
+
+/**
+ * @brief Subscript operator overload for sharded hash table.
+ *
+ * Behaves as HashTable_t::operator[] on the shard responsible for key.
+ *
+ * @param key Key to be searched.
+ * @return reference to value associated with key.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+V& ShardedHashTable_t<K, V, Hash, Eq>::operator[](const KeyArg key) {
+    return tableFor(hashOf(key))[key];
+}
+
+/**
+ * @brief Getter for number of shards.
+ *
+ * @return number of shards (a power of two).
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t ShardedHashTable_t<K, V, Hash, Eq>::shardCount() const {
+    return shards.size();
+}
+
+/**
+ * @brief Getter for the index of the shard responsible for a key.
+ *
+ * @param key Key to be routed.
+ * @return index of the shard holding key, if present.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t ShardedHashTable_t<K, V, Hash, Eq>::shardIndex(const KeyArg key) const {
+    return shardOf(hashOf(key));
+}
+
+/**
+ * @brief Getter for the table of a shard.
+ *
+ * Keys inserted directly into a shard must belong to it (see shardIndex), or they cannot be found through the sharded table.
+ *
+ * @param shardNum index of shard
+ * @return table of shard.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+typename ShardedHashTable_t<K, V, Hash, Eq>::Table& ShardedHashTable_t<K, V, Hash, Eq>::shard(const size_t shardNum) {
+    return shards[shardNum]->table;
+}
+
+/**
+ * @brief Getter for the table of a shard.
+ *
+ * @param shardNum index of shard
+ * @return table of shard.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+const typename ShardedHashTable_t<K, V, Hash, Eq>::Table& ShardedHashTable_t<K, V, Hash, Eq>::shard(const size_t shardNum) const {
+    return shards[shardNum]->table;
+}
+
+/**
+ * @brief Getter for the NUMA node a shard is pinned to.
+ *
+ * @param shardNum index of shard
+ * @return NUMA node of shard's allocations, or -1 if shards are not pinned.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+int ShardedHashTable_t<K, V, Hash, Eq>::shardNode(const size_t shardNum) const {
+    return shards[shardNum]->resource.numaNode();
+}
+
+/**
+ * @brief Getter for total capacity of the shards.
+ *
+ * @return sum of shard capacities.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t ShardedHashTable_t<K, V, Hash, Eq>::capacity() const {
+    size_t total = 0;
+    for (const std::unique_ptr<Shard>& shard : shards) {
+        total += shard->table.capacity();
+    }
+    return total;
+}
+
+/**
+ * @brief Getter for total size of the shards.
+ *
+ * @return sum of shard sizes.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t ShardedHashTable_t<K, V, Hash, Eq>::size() const {
+    size_t total = 0;
+    for (const std::unique_ptr<Shard>& shard : shards) {
+        total += shard->table.size();
+    }
+    return total;
+}
+
+/**
+ * @brief Getter for the overall load factor.
+ *
+ * Calculated as the ratio between the total size and total capacity of the shards.
+ *
+ * @return load factor (alpha) of table
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+double ShardedHashTable_t<K, V, Hash, Eq>::alpha() const {
+    return static_cast<double>(size())/static_cast<double>(capacity());
+}
+
+/**
+ * @brief Getter for the combined statistics of the shards.
+ *
+ * The maximum probe length is the largest of any shard.
+ *
+ * @return combined statistics of every shard (see HashTable_t::stats).
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+HashTableStats ShardedHashTable_t<K, V, Hash, Eq>::stats() const {
+    HashTableStats total;
+    for (const std::unique_ptr<Shard>& shard : shards) {
+        total += shard->table.stats();
+    }
+    return total;
+}
+
+/**
+ * @brief Getter for a list of keys currently used in the table.
+ *
+ * Collects the keys of every shard in shard order, reserving room for all of them first.
+ *
+ * @return vector of keys present in the table.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+std::vector<K> ShardedHashTable_t<K, V, Hash, Eq>::keys() const {
+    std::vector<K> keyList;
+    keyList.reserve(size());
+    for_each([&keyList](const K& key, const V&) { keyList.push_back(key); });
+    return keyList;
+}
+
+/**
+ * @brief Calls a function with the key and value of every key-value pair.
+ *
+ * Visits the shards in order (see HashTable_t::for_each).
+ *
+ * @param function function called with every key-value pair, as function(const K& key, V& value)
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+template<typename Function>
+void ShardedHashTable_t<K, V, Hash, Eq>::for_each(Function function) {
+    for (const std::unique_ptr<Shard>& shard : shards) {
+        shard->table.for_each(std::ref(function)); // One function object visits every shard.
+    }
+}
+
+/**
+ * @brief Calls a function with the key and value of every key-value pair, without modifying them.
+ *
+ * @param function function called with every key-value pair, as function(const K& key, const V& value)
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+template<typename Function>
+void ShardedHashTable_t<K, V, Hash, Eq>::for_each(Function function) const {
+    for (const std::unique_ptr<Shard>& shard : shards) {
+        std::as_const(shard->table).for_each(std::ref(function));
+    }
+}
+
+/**
+ * @brief Calls a function with every key-value pair, from one thread per shard.
+ *
+ * Each worker thread visits whole shards (worker t visits shards t, t + numThreads, ...), so no two threads
+ * share a bucket array, and a shard pinned to a NUMA node is visited by a single thread.
+ * function is called concurrently and must be safe to call from several threads at once.
+ *
+ * @param function function called with every key-value pair, as function(const K& key, V& value)
+ * @param numThreads number of threads (default 0, one per shard up to the number of hardware threads)
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+template<typename Function>
+void ShardedHashTable_t<K, V, Hash, Eq>::parallel_for_each(Function function, size_t numThreads) {
+    if (numThreads == 0) {
+        numThreads = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    numThreads = std::min(numThreads, shards.size());
+    if (numThreads <= 1) {
+        for_each(std::ref(function));
+        return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(numThreads);
+    for (size_t worker = 0; worker < numThreads; ++worker) {
+        workers.emplace_back([this, &function, worker, numThreads] {
+            for (size_t shardNum = worker; shardNum < shards.size(); shardNum += numThreads) {
+                shards[shardNum]->table.for_each(std::ref(function));
+            }
+        });
+    }
+    for (std::thread& workerThread : workers) {
+        workerThread.join();
+    }
+}
+
+/**
+ * @brief Getter for value stored using a given key.
+ *
+ * Does not advance an incremental rehash of the shard (see HashTable_t::get with a precomputed hash).
+ *
+ * @param key Key to be searched.
+ * @return value associated with key or nullopt.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+std::optional<V> ShardedHashTable_t<K, V, Hash, Eq>::get(const KeyArg key) const {
+    const size_t hashValue = hashOf(key);
+    return tableFor(hashValue).get(key, hashValue);
+}
+
+/**
+ * @brief Predicate for if a given key is stored in table.
+ *
+ * Does not advance an incremental rehash of the shard, like get.
+ *
+ * @param key Key to be searched.
+ * @return true if key found, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool ShardedHashTable_t<K, V, Hash, Eq>::contains(const KeyArg key) const {
+    const size_t hashValue = hashOf(key);
+    return tableFor(hashValue).contains(key, hashValue);
+}
+
+/**
+ * @brief Insert key-value pair into table.
+ *
+ * Only the shard responsible for key may rehash.
+ *
+ * @param key of key-value pair to be inserted.
+ * @param value Value of key-value pair to be inserted.
+ * @return true if insertion successful, false if key already present.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool ShardedHashTable_t<K, V, Hash, Eq>::insert(const K& key, const V& value) {
+    const size_t hashValue = hashOf(key);
+    return tableFor(hashValue).insert(key, value, hashValue);
+}
+
+/**
+ * @brief Insert key-value pair, or assign value if key is present.
+ *
+ * @param key of key-value pair to be inserted or assigned.
+ * @param value Value to be stored.
+ * @return true if the pair was inserted, false if an existing value was assigned.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool ShardedHashTable_t<K, V, Hash, Eq>::insert_or_assign(const K& key, const V& value) {
+    const size_t hashValue = hashOf(key);
+    return tableFor(hashValue).insert_or_assign(key, value, hashValue);
+}
+
+/**
+ * @brief Reserves capacity for a number of key-value pairs.
+ *
+ * Reserves an even share of expectedElements in every shard.
+ *
+ * @param expectedElements Number of key-value pairs the table should hold without rehashing.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void ShardedHashTable_t<K, V, Hash, Eq>::reserve(const size_t expectedElements) {
+    const size_t perShard = (expectedElements + shards.size() - 1) / shards.size();
+    for (const std::unique_ptr<Shard>& shard : shards) {
+        shard->table.reserve(perShard);
+    }
+}
+
+/**
+ * @brief Remove key-value pair from table.
+ *
+ * Only the shard responsible for key may shrink or compact.
+ *
+ * @param key Key to be searched.
+ * @return true if removal successful, false otherwise.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+bool ShardedHashTable_t<K, V, Hash, Eq>::remove(const KeyArg key) {
+    const size_t hashValue = hashOf(key);
+    return tableFor(hashValue).remove(key, hashValue);
+}
+
+/**
+ * @brief Rehashes every shard at its current capacity, clearing all tombstones.
+ *
+ * Shards without tombstones are left alone (see HashTable_t::compact).
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void ShardedHashTable_t<K, V, Hash, Eq>::compact() {
+    for (const std::unique_ptr<Shard>& shard : shards) {
+        shard->table.compact();
+    }
+}
+
+/**
+ * @brief Rehashes every shard to the smallest capacity that holds its key-value pairs.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+void ShardedHashTable_t<K, V, Hash, Eq>::shrink_to_fit() {
+    for (const std::unique_ptr<Shard>& shard : shards) {
+        shard->table.shrink_to_fit();
+    }
+}
+
+/**
+ * @brief Mixed hash of a key, as computed by every shard.
+ *
+ * @param key Key to be hashed.
+ * @return HashTable_t::hashOf(key) of every shard.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t ShardedHashTable_t<K, V, Hash, Eq>::hashOf(const KeyArg key) const {
+    return shards.front()->table.hashOf(key);
+}
+
+/**
+ * @brief Index of the shard responsible for a key with a given hash.
+ *
+ * Shard tables take home buckets from the high bits of the hash and fingerprints from its low 7 bits,
+ * so the bits just above the fingerprint select the shard, leaving each shard's keys spread over its buckets.
+ *
+ * @param hashValue hashOf(key) of the key to be routed.
+ * @return index of the shard holding key, if present.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+size_t ShardedHashTable_t<K, V, Hash, Eq>::shardOf(const size_t hashValue) const {
+    return (hashValue >> 7) & (shards.size() - 1);
+}
+
+/**
+ * @brief Table of the shard responsible for a key with a given hash.
+ *
+ * @param hashValue hashOf(key) of the key to be routed.
+ * @return table holding key, if present.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+typename ShardedHashTable_t<K, V, Hash, Eq>::Table& ShardedHashTable_t<K, V, Hash, Eq>::tableFor(const size_t hashValue) {
+    return shards[shardOf(hashValue)]->table;
+}
+
+/**
+ * @brief Table of the shard responsible for a key with a given hash.
+ *
+ * @param hashValue hashOf(key) of the key to be routed.
+ * @return table holding key, if present.
+ */
+template<typename K, typename V, typename Hash, typename Eq>
+const typename ShardedHashTable_t<K, V, Hash, Eq>::Table& ShardedHashTable_t<K, V, Hash, Eq>::tableFor(const size_t hashValue) const {
+    return shards[shardOf(hashValue)]->table;
+}
+
+#endif // SHARDEDHASHTABLE_H
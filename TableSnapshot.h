@@ -0,0 +1,180 @@
+#ifndef TABLESNAPSHOT_H
+#define TABLESNAPSHOT_H
+
+/*
+ * Greg Rosen
+ * Project 4: HashTable
+ * Declaration and implementation of the binary snapshot format of HashTable
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+
+#if __has_include(<sys/mman.h>) && __has_include(<fcntl.h>) && __has_include(<unistd.h>)
+#define HASHTABLE_SNAPSHOT_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @struct SnapshotHeader
+ * @brief Header at the start of a HashTable snapshot file, written by save and checked by load.
+ *
+ * The header is followed by these sections, each starting at a multiple of SECTION_ALIGNMENT bytes:
+ * 1. The control byte array, mirrored bytes included (capacity + 15 bytes).
+ * 2. The cached hash of every filled bucket, in bucket order (absent if buckets do not cache hashes).
+ * 3. The value of every filled bucket, in bucket order.
+ * 4. For inline keys, the key of every filled bucket, in bucket order. For string keys, the end offset
+ *    of every filled bucket's key within the key blob, followed by the key blob (the characters of every key, packed).
+ * All fields are stored in the byte order of the machine that saved the snapshot; a snapshot saved on a machine
+ * of the other byte order fails the magic check.
+ */
+struct SnapshotHeader {
+    static constexpr uint64_t MAGIC = 0x313050414E535448; // "HTSNAP01" read as a little-endian integer.
+    static constexpr uint32_t VERSION = 3; // Version of the format.
+    static constexpr size_t SECTION_ALIGNMENT = 8; // Alignment of every section after the header.
+
+    uint64_t magic = MAGIC; // Identifies the file as a HashTable snapshot.
+    uint32_t version = VERSION; // Version of the format.
+    uint32_t stringKeys = 0; // 1 if keys are stored in the key blob, 0 if stored inline.
+    uint64_t keySize = 0; // Size of an inline key (0 for string keys).
+    uint64_t valueSize = 0; // Size of a value.
+    uint64_t cachedHashes = 0; // 1 if the cached hash section is present.
+    uint64_t capacity = 0; // Number of buckets.
+    uint64_t minCapacity = 0; // Capacity below which the table never shrinks automatically.
+    uint64_t numFilled = 0; // Number of filled buckets.
+    uint64_t numTombstones = 0; // Number of EAR buckets.
+    double threshold = 0.0; // Load factor threshold for rehashing.
+    double resizeFactor = 0.0; // Factor by which capacity grows upon rehashing.
+    double tombstoneThreshold = 0.0; // Fraction of buckets that may be tombstones before compaction.
+    double shrinkThreshold = 0.0; // Load factor below which removals shrink the table.
+    uint64_t migrationStep = 0; // Number of old buckets migrated per operation during an incremental rehash.
+    uint64_t rehashThreads = 0; // Number of threads moving key-value pairs during a rehash.
+    uint32_t probeMode = 0; // Collision resolution strategy.
+    uint32_t capacityPolicy = 0; // Rounding applied to the capacity.
+    uint64_t probeMultiplier = 0; // LCG multiplier for pseudo-random probing.
+    uint64_t probeIncrement = 0; // LCG increment for pseudo-random probing.
+    uint64_t keyBlobSize = 0; // Number of characters in the key blob (0 for inline keys).
+    uint64_t hashSeed = 0; // Seed of a seeded hash function (0 for other hash functions).
+
+    [[nodiscard]] static constexpr size_t align(size_t offset); // Rounds an offset up to the next section boundary.
+};
+
+/**
+ * @class MappedFile
+ * @brief Read-only view of the whole contents of a file.
+ *
+ * Maps the file into memory where mmap is available, so that its pages are loaded on first access
+ * and shared with every other process mapping the same file. Elsewhere, the file is read into a buffer.
+ * Held by shared pointer, so that tables with ArenaString keys viewing its characters can keep it alive.
+ *
+ * @warning A mapped file must not be truncated or rewritten while mapped.
+ */
+class MappedFile {
+private:
+    const std::byte* bytes = nullptr; // First byte of the file contents.
+    size_t length = 0; // Number of bytes in the file.
+#if !defined(HASHTABLE_SNAPSHOT_MMAP)
+    std::unique_ptr<std::byte[]> buffer; // Contents of the file, read into memory.
+#endif
+
+    MappedFile() = default; // Default constructor for MappedFile (no contents).
+
+public:
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile(); // Destructor for MappedFile.
+
+    [[nodiscard]] static std::shared_ptr<const MappedFile> open(const std::filesystem::path& path); // Maps the contents of a file.
+    [[nodiscard]] const std::byte* data() const; // Getter for the first byte of the file contents.
+    [[nodiscard]] size_t size() const; // Getter for the number of bytes in the file.
+};
+
+/**
+ * @brief Rounds an offset up to the next section boundary.
+ *
+ * @param offset offset in bytes from the start of the file
+ * @return smallest multiple of SECTION_ALIGNMENT not less than offset.
+ */
+constexpr size_t SnapshotHeader::align(const size_t offset) {
+    return (offset + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+}
+
+/**
+ * @brief Destructor for MappedFile.
+ *
+ * Unmaps the file, if it was mapped.
+ */
+inline MappedFile::~MappedFile() {
+#if defined(HASHTABLE_SNAPSHOT_MMAP)
+    if (length != 0) {
+        munmap(const_cast<std::byte*>(bytes), length);
+    }
+#endif
+}
+
+/**
+ * @brief Maps the contents of a file.
+ *
+ * @param path path of file
+ * @return view of the file contents, or null if the file cannot be opened or read.
+ */
+inline std::shared_ptr<const MappedFile> MappedFile::open(const std::filesystem::path& path) {
+    std::shared_ptr<MappedFile> file(new MappedFile());
+#if defined(HASHTABLE_SNAPSHOT_MMAP)
+    const int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        return nullptr;
+    }
+    struct stat status {};
+    if (fstat(descriptor, &status) != 0 || status.st_size <= 0) {
+        close(descriptor);
+        return nullptr;
+    }
+    void* const mapping = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor); // The mapping stays valid once the descriptor is closed.
+    if (mapping == MAP_FAILED) {
+        return nullptr;
+    }
+    file->bytes = static_cast<const std::byte*>(mapping);
+    file->length = static_cast<size_t>(status.st_size);
+#else
+    std::ifstream stream(path, std::ios::binary | std::ios::ate);
+    if (!stream) {
+        return nullptr;
+    }
+    file->length = static_cast<size_t>(stream.tellg());
+    file->buffer = std::make_unique<std::byte[]>(file->length);
+    stream.seekg(0);
+    if (!stream.read(reinterpret_cast<char*>(file->buffer.get()), static_cast<std::streamsize>(file->length))) {
+        return nullptr;
+    }
+    file->bytes = file->buffer.get();
+#endif
+    return file;
+}
+
+/**
+ * @brief Getter for the first byte of the file contents.
+ *
+ * @return pointer to file contents.
+ */
+inline const std::byte* MappedFile::data() const {
+    return bytes;
+}
+
+/**
+ * @brief Getter for the number of bytes in the file.
+ *
+ * @return size of file.
+ */
+inline size_t MappedFile::size() const {
+    return length;
+}
+
+#endif // TABLESNAPSHOT_H